@@ -64,7 +64,11 @@ ogs_app_context_t *ogs_app(void)
 
 static void recalculate_pool_size(void)
 {
-    self.pool.packet = self.max.ue * OGS_MAX_NUM_OF_PACKET_BUFFER;
+    /*
+     * The packet pool only has to hold what the downlink buffering budget
+     * allows plus the packets in flight, not a full queue for every UE.
+     */
+    self.pool.packet = self.buffer.max / OGS_MAX_PKT_LEN + self.max.ue;
 
 #define MAX_NUM_OF_TUNNEL       3   /* Num of Tunnel per Bearer */
     self.pool.sess = self.max.ue * OGS_MAX_NUM_OF_SESS;
@@ -178,6 +182,12 @@ static void app_context_prepare(void)
     self.max.ue = MAX_NUM_OF_UE;
     self.max.peer = MAX_NUM_OF_PEER;
 
+#define MAX_BUFFER_SIZE             (32*1024*1024)  /* 32 MBytes */
+    self.buffer.max = MAX_BUFFER_SIZE;
+    self.buffer.ue = OGS_MAX_NUM_OF_PACKET_BUFFER * OGS_MAX_PKT_LEN;
+    self.buffer.dnn = 0;
+    self.buffer.drop = OGS_BUFFER_DROP_TAIL;
+
     ogs_pkbuf_default_init(&self.pool.defconfig);
 
     recalculate_pool_size();
@@ -210,6 +220,16 @@ static void app_context_prepare(void)
      */
     self.time.handover.duration = ogs_time_from_msec(300);
 
+    /*
+     * GTP-U Echo Interval : Disabled (Default)
+     *
+     * When enabled, the UPF/SGW-U sends an Echo Request to each GTP-U peer
+     * every interval and declares the path failed after 'max_missed'
+     * consecutive requests are left unanswered.
+     */
+    self.time.gtpu_echo.interval = 0;
+    self.time.gtpu_echo.max_missed = 3;
+
     /* Size of internal metrics pool (amount of ogs_metrics_spec_t) */
     self.metrics.max_specs = 512;
 
@@ -234,6 +254,59 @@ static int app_context_validation(void)
         return OGS_ERROR;
     }
 
+    if (self.buffer.ue > self.buffer.max ||
+        self.buffer.dnn > self.buffer.max) {
+        ogs_error("Per-UE[%lld]/DNN[%lld] buffer should not exceed "
+                "the total[%lld]",
+                (long long)self.buffer.ue, (long long)self.buffer.dnn,
+                (long long)self.buffer.max);
+        return OGS_ERROR;
+    }
+
+    if (self.sbi.server.num_of_io_thread < 0) {
+        ogs_error("SBI server I/O thread should not be negative [%d]",
+                self.sbi.server.num_of_io_thread);
+        return OGS_ERROR;
+    }
+
+    if (self.num_of_db_thread < 0) {
+        ogs_error("DB thread should not be negative [%d]",
+                self.num_of_db_thread);
+        return OGS_ERROR;
+    }
+
+    if (self.db_cache_size < 0) {
+        ogs_error("DB cache should not be negative [%d]",
+                self.db_cache_size);
+        return OGS_ERROR;
+    }
+
+    if (self.sqn_journal.interval < 0) {
+        ogs_error("SQN journal interval should not be negative [%lld]",
+                (long long)ogs_time_to_msec(self.sqn_journal.interval));
+        return OGS_ERROR;
+    }
+
+    if (self.num_of_diameter_thread < 0) {
+        ogs_error("Diameter thread should not be negative [%d]",
+                self.num_of_diameter_thread);
+        return OGS_ERROR;
+    }
+
+    if (self.time.gtpu_echo.interval < 0 ||
+        self.time.gtpu_echo.max_missed <= 0) {
+        ogs_error("Invalid GTP-U echo interval[%lld]/max_missed[%d]",
+                (long long)ogs_time_to_msec(self.time.gtpu_echo.interval),
+                self.time.gtpu_echo.max_missed);
+        return OGS_ERROR;
+    }
+
+    if (self.poll.busy_poll < 0) {
+        ogs_error("Busy-poll duration should not be negative [%lld]",
+                (long long)self.poll.busy_poll);
+        return OGS_ERROR;
+    }
+
     return OGS_OK;
 }
 
@@ -252,6 +325,31 @@ int ogs_app_context_parse_config(void)
         ogs_assert(root_key);
         if (!strcmp(root_key, "db_uri")) {
             self.db_uri = ogs_yaml_iter_value(&root_iter);
+        } else if (!strcmp(root_key, "db_thread")) {
+            const char *v = ogs_yaml_iter_value(&root_iter);
+            if (v) self.num_of_db_thread = atoi(v);
+        } else if (!strcmp(root_key, "db_cache")) {
+            const char *v = ogs_yaml_iter_value(&root_iter);
+            if (v) self.db_cache_size = atoi(v);
+        } else if (!strcmp(root_key, "sqn_journal")) {
+            ogs_yaml_iter_t sqn_journal_iter;
+            ogs_yaml_iter_recurse(&root_iter, &sqn_journal_iter);
+            while (ogs_yaml_iter_next(&sqn_journal_iter)) {
+                const char *sqn_journal_key =
+                    ogs_yaml_iter_key(&sqn_journal_iter);
+                ogs_assert(sqn_journal_key);
+                if (!strcmp(sqn_journal_key, "interval")) {
+                    const char *v = ogs_yaml_iter_value(&sqn_journal_iter);
+                    if (v) self.sqn_journal.interval =
+                        ogs_time_from_msec(atoll(v));
+                } else if (!strcmp(sqn_journal_key, "file")) {
+                    self.sqn_journal.file =
+                        ogs_yaml_iter_value(&sqn_journal_iter);
+                }
+            }
+        } else if (!strcmp(root_key, "diameter_thread")) {
+            const char *v = ogs_yaml_iter_value(&root_iter);
+            if (v) self.num_of_diameter_thread = atoi(v);
         } else if (!strcmp(root_key, "logger")) {
             ogs_yaml_iter_t logger_iter;
             ogs_yaml_iter_recurse(&root_iter, &logger_iter);
@@ -266,6 +364,8 @@ int ogs_app_context_parse_config(void)
                 } else if (!strcmp(logger_key, "domain")) {
                     self.logger.domain =
                         ogs_yaml_iter_value(&logger_iter);
+                } else if (!strcmp(logger_key, "async")) {
+                    self.logger.async = ogs_yaml_iter_bool(&logger_iter);
                 }
             }
         } else if (!strcmp(root_key, "parameter")) {
@@ -373,6 +473,18 @@ int ogs_app_context_parse_config(void)
                 } else
                     ogs_warn("unknown key `%s`", sockopt_key);
             }
+        } else if (!strcmp(root_key, "poll")) {
+            ogs_yaml_iter_t poll_iter;
+            ogs_yaml_iter_recurse(&root_iter, &poll_iter);
+            while (ogs_yaml_iter_next(&poll_iter)) {
+                const char *poll_key = ogs_yaml_iter_key(&poll_iter);
+                ogs_assert(poll_key);
+                if (!strcmp(poll_key, "busy_poll")) {
+                    const char *v = ogs_yaml_iter_value(&poll_iter);
+                    if (v) self.poll.busy_poll = atoll(v);
+                } else
+                    ogs_warn("unknown key `%s`", poll_key);
+            }
         } else if (!strcmp(root_key, "max")) {
             ogs_yaml_iter_t max_iter;
             ogs_yaml_iter_recurse(&root_iter, &max_iter);
@@ -394,6 +506,39 @@ int ogs_app_context_parse_config(void)
                     ogs_warn("unknown key `%s`", max_key);
             }
 
+            recalculate_pool_size();
+        } else if (!strcmp(root_key, "buffer")) {
+            ogs_yaml_iter_t buffer_iter;
+            ogs_yaml_iter_recurse(&root_iter, &buffer_iter);
+            while (ogs_yaml_iter_next(&buffer_iter)) {
+                const char *buffer_key = ogs_yaml_iter_key(&buffer_iter);
+                ogs_assert(buffer_key);
+                if (!strcmp(buffer_key, "max")) {
+                    const char *v = ogs_yaml_iter_value(&buffer_iter);
+                    if (v) self.buffer.max = atoll(v);
+                } else if (!strcmp(buffer_key, "ue")) {
+                    const char *v = ogs_yaml_iter_value(&buffer_iter);
+                    if (v) self.buffer.ue = atoll(v);
+                } else if (!strcmp(buffer_key, "dnn") ||
+                            !strcmp(buffer_key, "apn")) {
+                    const char *v = ogs_yaml_iter_value(&buffer_iter);
+                    if (v) self.buffer.dnn = atoll(v);
+                } else if (!strcmp(buffer_key, "drop")) {
+                    const char *v = ogs_yaml_iter_value(&buffer_iter);
+                    if (v) {
+                        if (!strcmp(v, "head"))
+                            self.buffer.drop = OGS_BUFFER_DROP_HEAD;
+                        else if (!strcmp(v, "tail"))
+                            self.buffer.drop = OGS_BUFFER_DROP_TAIL;
+                        else {
+                            ogs_error("Unknown drop policy `%s`", v);
+                            return OGS_ERROR;
+                        }
+                    }
+                } else
+                    ogs_warn("unknown key `%s`", buffer_key);
+            }
+
             recalculate_pool_size();
         } else if (!strcmp(root_key, "pool")) {
             ogs_yaml_iter_t pool_iter;
@@ -433,6 +578,9 @@ int ogs_app_context_parse_config(void)
                     const char *v = ogs_yaml_iter_value(&pool_iter);
                     if (v)
                         self.pool.defconfig.cluster_big_pool = atoi(v);
+                } else if (!strcmp(pool_key, "hugepage")) {
+                    ogs_core()->pool.hugepage =
+                        ogs_yaml_iter_bool(&pool_iter);
                 } else
                     ogs_warn("unknown key `%s`", pool_key);
             }
@@ -515,6 +663,27 @@ int ogs_app_context_parse_config(void)
                         } else
                             ogs_warn("unknown key `%s`", msg_key);
                     }
+                } else if (!strcmp(time_key, "gtpu_echo")) {
+                    ogs_yaml_iter_t echo_iter;
+                    ogs_yaml_iter_recurse(&time_iter, &echo_iter);
+
+                    while (ogs_yaml_iter_next(&echo_iter)) {
+                        const char *echo_key =
+                            ogs_yaml_iter_key(&echo_iter);
+                        ogs_assert(echo_key);
+
+                        if (!strcmp(echo_key, "interval")) {
+                            const char *v = ogs_yaml_iter_value(&echo_iter);
+                            if (v) {
+                                self.time.gtpu_echo.interval =
+                                    ogs_time_from_msec(atoll(v));
+                            }
+                        } else if (!strcmp(echo_key, "max_missed")) {
+                            const char *v = ogs_yaml_iter_value(&echo_iter);
+                            if (v) self.time.gtpu_echo.max_missed = atoi(v);
+                        } else
+                            ogs_warn("unknown key `%s`", echo_key);
+                    }
                 } else if (!strcmp(time_key, "t3502")) {
                     /* handle config in amf */
                 } else if (!strcmp(time_key, "t3512")) {
@@ -557,6 +726,9 @@ int ogs_app_context_parse_config(void)
                         } else if (!strcmp(server_key, "key")) {
                             self.sbi.server.key =
                                 ogs_yaml_iter_value(&server_iter);
+                        } else if (!strcmp(server_key, "io_thread")) {
+                            const char *v = ogs_yaml_iter_value(&server_iter);
+                            if (v) self.sbi.server.num_of_io_thread = atoi(v);
                         } else
                             ogs_warn("unknown key `%s`", server_key);
                     }
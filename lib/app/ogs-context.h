@@ -34,6 +34,11 @@ typedef enum {
     OGS_SBI_TLS_ENABLED_NO,
 } ogs_sbi_tls_enabled_mode_e;
 
+typedef enum {
+    OGS_BUFFER_DROP_TAIL = 0,   /* Drop the arriving packet */
+    OGS_BUFFER_DROP_HEAD,       /* Drop the oldest packet of the queue */
+} ogs_buffer_drop_policy_e;
+
 typedef struct ogs_app_context_s {
     const char *version;
 
@@ -42,11 +47,21 @@ typedef struct ogs_app_context_s {
 
     const char *db_uri;
     int use_mongodb_change_stream;
+    int num_of_db_thread;
+    int db_cache_size;
+
+    struct {
+        ogs_time_t interval;
+        const char *file;
+    } sqn_journal;
+
+    int num_of_diameter_thread;
 
     struct {
         const char *file;
         const char *level;
         const char *domain;
+        bool async;
     } logger;
 
     ogs_queue_t *queue;
@@ -93,6 +108,17 @@ typedef struct ogs_app_context_s {
         int l_linger;
     } sockopt;
 
+    struct {
+        ogs_time_t busy_poll;   /* usec */
+    } poll;
+
+    struct {
+        uint64_t max;           /* Bytes buffered for all the UEs */
+        uint64_t ue;            /* Bytes buffered for each UE */
+        uint64_t dnn;           /* Bytes buffered for each DNN, 0 = no limit */
+        ogs_buffer_drop_policy_e drop;
+    } buffer;
+
     struct {
         int udp_port;
     } usrsctp;
@@ -172,6 +198,11 @@ typedef struct ogs_app_context_s {
             ogs_time_t complete_delay;
         } handover;
 
+        struct {
+            ogs_time_t interval;    /* 0 : GTP-U path supervision disabled */
+            int max_missed;
+        } gtpu_echo;
+
     } time;
 
     struct metrics {
@@ -185,6 +216,8 @@ typedef struct ogs_app_context_s {
             const char *cacert;
             const char *cert;
             const char *key;
+
+            int num_of_io_thread;
         } server, client;
     } sbi;
 
@@ -110,6 +110,11 @@ int ogs_app_initialize(
             ogs_app()->logger.domain, ogs_app()->logger.level);
     if (rv != OGS_OK) return rv;
 
+    if (ogs_app()->logger.async) {
+        rv = ogs_log_async_start();
+        if (rv != OGS_OK) return rv;
+    }
+
     /**************************************************************************
      * Stage 5 : Setup Database Module
      */
@@ -145,6 +150,7 @@ int ogs_app_initialize(
     ogs_assert(ogs_app()->timer_mgr);
     ogs_app()->pollset = ogs_pollset_create(ogs_app()->pool.socket);
     ogs_assert(ogs_app()->pollset);
+    ogs_pollset_set_busy_poll(ogs_app()->pollset, ogs_app()->poll.busy_poll);
 
     return rv;
 }
@@ -92,6 +92,10 @@ typedef struct {
         int pool;
     } tlv;
 
+    struct {
+        bool hugepage;
+    } pool;
+
 } ogs_core_context_t;
 
 void ogs_core_initialize(void);
@@ -33,6 +33,7 @@ static void epoll_cleanup(ogs_pollset_t *pollset);
 static int epoll_add(ogs_poll_t *poll);
 static int epoll_remove(ogs_poll_t *poll);
 static int epoll_process(ogs_pollset_t *pollset, ogs_time_t timeout);
+static int epoll_rearm(ogs_pollset_t *pollset, ogs_socket_t fd);
 
 const ogs_pollset_actions_t ogs_epoll_actions = {
     epoll_init,
@@ -43,6 +44,8 @@ const ogs_pollset_actions_t ogs_epoll_actions = {
     epoll_process,
 
     ogs_notify_pollset,
+
+    epoll_rearm,
 };
 
 struct epoll_map_s {
@@ -55,8 +58,30 @@ struct epoll_context_s {
 
     ogs_hash_t *map_hash;
     struct epoll_event *event_list;
+
+    bool busy;  /* The last poll had some events */
 };
 
+static uint32_t epoll_events(struct epoll_map_s *map)
+{
+    uint32_t events = 0;
+
+    ogs_assert(map);
+
+    if (map->read) {
+        events |= (EPOLLIN|EPOLLRDHUP);
+        if (map->read->when & OGS_POLLET)
+            events |= EPOLLET;
+    }
+    if (map->write) {
+        events |= EPOLLOUT;
+        if (map->write->when & OGS_POLLET)
+            events |= EPOLLET;
+    }
+
+    return events;
+}
+
 static void epoll_init(ogs_pollset_t *pollset)
 {
     struct epoll_context_s *context = NULL;
@@ -130,11 +155,7 @@ static int epoll_add(ogs_poll_t *poll)
 
     memset(&ee, 0, sizeof ee);
 
-    ee.events = 0;
-    if (map->read)
-        ee.events |= (EPOLLIN|EPOLLRDHUP);
-    if (map->write)
-        ee.events |= EPOLLOUT;
+    ee.events = epoll_events(map);
     ee.data.fd = poll->fd;
 
     rv = epoll_ctl(context->epfd, op, poll->fd, &ee);
@@ -171,13 +192,8 @@ static int epoll_remove(ogs_poll_t *poll)
 
     memset(&ee, 0, sizeof ee);
 
-    ee.events = 0;
-    if (map->read)
-        ee.events |= (EPOLLIN|EPOLLRDHUP);
-    if (map->write)
-        ee.events |= EPOLLOUT;
-
     if (map->read || map->write) {
+        ee.events = epoll_events(map);
         op = EPOLL_CTL_MOD;
         ee.data.fd = poll->fd;
     } else {
@@ -201,17 +217,46 @@ static int epoll_remove(ogs_poll_t *poll)
 static int epoll_process(ogs_pollset_t *pollset, ogs_time_t timeout)
 {
     struct epoll_context_s *context = NULL;
-    int num_of_poll;
+    int num_of_poll = 0;
     int i;
 
     ogs_assert(pollset);
     context = pollset->context;
     ogs_assert(context);
 
-    num_of_poll = epoll_wait(context->epfd, context->event_list,
-            pollset->capacity,
-            timeout == OGS_INFINITE_TIME ? OGS_INFINITE_TIME :
-                ogs_time_to_msec(timeout));
+    /*
+     * Busy-Poll
+     *
+     * While the traffic keeps coming, spin on the non-blocking epoll_wait()
+     * before going to sleep. Once the spin ends without any event,
+     * the next poll blocks immediately until the traffic resumes.
+     */
+    if (pollset->busy_poll && context->busy && timeout != 0) {
+        ogs_time_t spin = pollset->busy_poll;
+        ogs_time_t deadline;
+
+        if (timeout != OGS_INFINITE_TIME && timeout < spin)
+            spin = timeout;
+        deadline = ogs_get_monotonic_time() + spin;
+
+        do {
+            num_of_poll = epoll_wait(context->epfd, context->event_list,
+                    pollset->capacity, 0);
+        } while (num_of_poll == 0 && ogs_get_monotonic_time() < deadline);
+
+        if (num_of_poll == 0 && timeout != OGS_INFINITE_TIME)
+            timeout -= spin;
+    }
+
+    if (num_of_poll == 0)
+        num_of_poll = epoll_wait(context->epfd, context->event_list,
+                pollset->capacity,
+                timeout == OGS_INFINITE_TIME ? OGS_INFINITE_TIME :
+                    ogs_time_to_msec(timeout));
+
+    context->busy = (num_of_poll > 0);
+    ogs_time_cache_update();
+
     if (num_of_poll < 0) {
         ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno, "epoll failed");
         return OGS_ERROR;
@@ -286,3 +331,33 @@ static int epoll_process(ogs_pollset_t *pollset, ogs_time_t timeout)
     
     return OGS_OK;
 }
+
+static int epoll_rearm(ogs_pollset_t *pollset, ogs_socket_t fd)
+{
+    int rv;
+    struct epoll_context_s *context = NULL;
+    struct epoll_map_s *map = NULL;
+    struct epoll_event ee;
+
+    ogs_assert(pollset);
+    context = pollset->context;
+    ogs_assert(context);
+
+    map = ogs_hash_get(context->map_hash, &fd, sizeof(fd));
+    if (!map) return OGS_OK;
+
+    /* EPOLL_CTL_MOD reports the fd again if it is still readable */
+    memset(&ee, 0, sizeof ee);
+
+    ee.events = epoll_events(map);
+    ee.data.fd = fd;
+
+    rv = epoll_ctl(context->epfd, EPOLL_CTL_MOD, fd, &ee);
+    if (rv < 0) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
+                "epoll_rearm failed");
+        return OGS_ERROR;
+    }
+
+    return OGS_OK;
+}
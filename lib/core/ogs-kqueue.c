@@ -34,6 +34,7 @@ static void kqueue_cleanup(ogs_pollset_t *pollset);
 static int kqueue_add(ogs_poll_t *poll);
 static int kqueue_remove(ogs_poll_t *poll);
 static int kqueue_process(ogs_pollset_t *pollset, ogs_time_t timeout);
+static int kqueue_rearm(ogs_pollset_t *pollset, ogs_socket_t fd);
 
 static void kqueue_notify_init(ogs_pollset_t *pollset);
 static int kqueue_notify_pollset(ogs_pollset_t *pollset);
@@ -47,6 +48,8 @@ const ogs_pollset_actions_t ogs_kqueue_actions = {
     kqueue_process,
 
     kqueue_notify_pollset,
+
+    kqueue_rearm,
 };
 
 struct kqueue_context_s {
@@ -205,6 +208,7 @@ static int kqueue_process(ogs_pollset_t *pollset, ogs_time_t timeout)
     n = kevent(context->kqueue,
             context->change_list, context->nchanges,
             context->event_list, context->nevents, tp);
+    ogs_time_cache_update();
 
     context->nchanges = 0;
 
@@ -357,3 +361,9 @@ static int kqueue_notify_pollset(ogs_pollset_t *pollset)
 
     return OGS_OK;
 }
+
+static int kqueue_rearm(ogs_pollset_t *pollset, ogs_socket_t fd)
+{
+    /* Level-triggered only. Nothing to do */
+    return OGS_OK;
+}
@@ -74,8 +74,15 @@ typedef struct ogs_log_s {
 
     void (*writer)(ogs_log_t *log, ogs_log_level_e level, const char *string);
 
+    struct {
+        char *buf;
+        size_t len;
+    } batch;                    /* Used only by the asynchronous logging */
+
 } ogs_log_t;
 
+#define LOG_BATCH_SIZE (64*1024)
+
 typedef struct ogs_log_domain_s {
     ogs_lnode_t node;
 
@@ -98,12 +105,15 @@ static OGS_LIST(domain_list);
 static ogs_log_t *add_log(ogs_log_type_e type);
 static int file_cycle(ogs_log_t *log);
 
+static void log_output(ogs_log_level_e level, ogs_log_domain_t *domain,
+        ogs_err_t err, const char *file, int line, const char *func,
+        int content_only, struct timeval *tv, const char *content);
+static void log_flush(void);
+
 static char *log_timestamp(char *buf, char *last,
-        int use_color);
+        struct timeval *tv, int use_color);
 static char *log_domain(char *buf, char *last,
         const char *name, int use_color);
-static char *log_content(char *buf, char *last,
-        const char *format, va_list ap);
 static char *log_level(char *buf, char *last,
         ogs_log_level_e level, int use_color);
 static char *log_linefeed(char *buf, char *last);
@@ -111,6 +121,89 @@ static char *log_linefeed(char *buf, char *last);
 static void file_writer(
         ogs_log_t *log, ogs_log_level_e level, const char *string);
 
+#if !defined(_WIN32)
+
+/*
+ * Asynchronous Logging
+ *
+ * Each thread formats only the content of the message, and pushes it with
+ * the binary header(time, level, domain, file/line) into its own ring.
+ * The ring has a single producer and a single consumer, so no lock is
+ * needed. The logging thread drains all rings, formats the header, and
+ * writes the messages to each log target in a batch.
+ *
+ * If the ring is full, the message is dropped and counted,
+ * and the number of dropped messages is reported once per second.
+ */
+typedef struct log_record_s {
+    uint32_t size;              /* Size of the record including header */
+    uint8_t padding;            /* Skip to the start of the ring */
+    uint8_t level;
+    uint8_t content_only;
+    int id;
+    ogs_err_t err;
+    int line;
+    const char *file;
+    const char *func;
+    struct timeval tv;
+} log_record_t;
+
+typedef struct log_ring_s {
+    ogs_lnode_t lnode;
+
+    char *buf;
+    uint64_t head;              /* Written by the producer */
+    uint64_t tail;              /* Written by the consumer */
+
+    uint64_t dropped;           /* Written by the producer */
+    uint64_t reported;          /* Written by the consumer */
+
+    bool orphan;                /* The producer thread has exited */
+} log_ring_t;
+
+#define LOG_RING_SIZE (256*1024)
+#define LOG_RECORD_ALIGN(n) (((n) + 7) & ~7)
+#define LOG_DROP_REPORT_INTERVAL ogs_time_from_sec(1)
+#define LOG_WAIT_INTERVAL ogs_time_from_msec(100)
+
+static struct {
+    bool running;               /* Read by all threads, see async_enter() */
+    unsigned int producers;     /* Threads inside async_push() */
+    bool terminated;
+    unsigned int generation;
+
+    ogs_thread_t *thread;
+    ogs_thread_mutex_t mutex;   /* Log targets and consumer */
+    ogs_thread_mutex_t wait_mutex;
+    ogs_thread_cond_t cond;
+
+    ogs_thread_mutex_t ring_mutex;
+    ogs_list_t ring_list;
+    pthread_key_t ring_key;
+
+    uint64_t dropped;
+    ogs_time_t last_report;
+} async;
+
+static __thread log_ring_t *thread_ring;
+static __thread unsigned int thread_generation;
+static __thread bool log_batching;  /* Set only in the logging thread */
+
+static void async_push(ogs_log_level_e level, int id,
+        ogs_err_t err, const char *file, int line, const char *func,
+        int content_only, struct timeval *tv, const char *content);
+static void async_drain(void);
+static void async_main(void *data);
+
+static bool async_running(void)
+{
+    return __atomic_load_n(&async.running, __ATOMIC_SEQ_CST);
+}
+static bool async_enter(void);
+static void async_leave(void);
+
+#endif
+
 void ogs_log_init(void)
 {
     ogs_pool_init(&log_pool, ogs_core()->log.pool);
@@ -125,6 +218,8 @@ void ogs_log_final(void)
     ogs_log_t *log, *saved_log;
     ogs_log_domain_t *domain, *saved_domain;
 
+    ogs_log_async_stop();
+
     ogs_list_for_each_safe(&log_list, saved_log, log)
         ogs_log_remove(log);
     ogs_pool_final(&log_pool);
@@ -137,6 +232,11 @@ void ogs_log_final(void)
 void ogs_log_cycle(void)
 {
     ogs_log_t *log = NULL;
+#if !defined(_WIN32)
+    bool locked = async_running();
+
+    if (locked) ogs_thread_mutex_lock(&async.mutex);
+#endif
 
     ogs_list_for_each(&log_list, log) {
         switch(log->type) {
@@ -146,6 +246,10 @@ void ogs_log_cycle(void)
             break;
         }
     }
+
+#if !defined(_WIN32)
+    if (locked) ogs_thread_mutex_unlock(&async.mutex);
+#endif
 }
 
 ogs_log_t *ogs_log_add_stderr(void)
@@ -187,10 +291,24 @@ ogs_log_t *ogs_log_add_file(const char *name)
 
 void ogs_log_remove(ogs_log_t *log)
 {
+#if !defined(_WIN32)
+    bool locked = async_running();
+#endif
+
     ogs_assert(log);
 
+#if !defined(_WIN32)
+    if (locked) ogs_thread_mutex_lock(&async.mutex);
+#endif
+
     ogs_list_remove(&log_list, log);
 
+    if (log->batch.buf) {
+        if (log->batch.len)
+            fwrite(log->batch.buf, 1, log->batch.len, log->file.out);
+        free(log->batch.buf);
+    }
+
     if (log->type == OGS_LOG_FILE_TYPE) {
         ogs_assert(log->file.out);
         fclose(log->file.out);
@@ -198,6 +316,10 @@ void ogs_log_remove(ogs_log_t *log)
     }
 
     ogs_pool_free(&log_pool, log);
+
+#if !defined(_WIN32)
+    if (locked) ogs_thread_mutex_unlock(&async.mutex);
+#endif
 }
 
 ogs_log_domain_t *ogs_log_add_domain(const char *name, ogs_log_level_e level)
@@ -380,15 +502,12 @@ void ogs_log_vprintf(ogs_log_level_e level, int id,
     ogs_err_t err, const char *file, int line, const char *func,
     int content_only, const char *format, va_list ap)
 {
-    ogs_log_t *log = NULL;
     ogs_log_domain_t *domain = NULL;
 
-    char logstr[OGS_HUGE_LEN];
-    char *p, *last;
-
-    int wrote_stderr = 0;
+    struct timeval tv;
+    char content[OGS_HUGE_LEN];
 
-    ogs_list_for_each(&log_list, log) {
+    if (ogs_list_first(&log_list)) {
         domain = ogs_pool_find(&domain_pool, id);
         if (!domain) {
             fprintf(stderr, "No LogDomain[id:%d] in %s:%d", id, file, line);
@@ -396,66 +515,41 @@ void ogs_log_vprintf(ogs_log_level_e level, int id,
         }
         if (domain->level < level)
             return;
+    }
 
-        p = logstr;
-        last = logstr + OGS_HUGE_LEN;
-
-        if (!content_only) {
-            if (log->print.timestamp)
-                p = log_timestamp(p, last, log->print.color);
-            if (log->print.domain)
-                p = log_domain(p, last, domain->name, log->print.color);
-            if (log->print.level)
-                p = log_level(p, last, level, log->print.color);
-        }
-
-        p = log_content(p, last, format, ap);
+    ogs_gettimeofday(&tv);
 
-        if (err) {
-            char errbuf[OGS_HUGE_LEN];
-            p = ogs_slprintf(p, last, " (%d:%s)",
-                    (int)err, ogs_strerror(err, errbuf, OGS_HUGE_LEN));
-        }
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+    ogs_vslprintf(content, content + OGS_HUGE_LEN, format, ap);
+#pragma GCC diagnostic pop
 
-        if (!content_only) {
-            if (log->print.fileline)
-                p = ogs_slprintf(p, last, " (%s:%d)", file, line);
-            if (log->print.function)
-                p = ogs_slprintf(p, last, " %s()", func);
-            if (log->print.linefeed) 
-                p = log_linefeed(p, last);
+#if !defined(_WIN32)
+    if (async_enter()) {
+        if (level != OGS_LOG_FATAL) {
+            async_push(level, id, err, file, line, func,
+                    content_only, &tv, content);
+            async_leave();
+            return;
         }
 
-        log->writer(log, level, logstr);
-        
-        if (log->type == OGS_LOG_STDERR_TYPE)
-            wrote_stderr = 1;
+        /*
+         * The process is about to abort.
+         * Write everything queued so far, and this message, right now.
+         */
+        ogs_thread_mutex_lock(&async.mutex);
+        async_drain();
+        log_output(level, domain, err, file, line, func,
+                content_only, &tv, content);
+        log_flush();
+        ogs_thread_mutex_unlock(&async.mutex);
+        async_leave();
+        return;
     }
-
-    if (!wrote_stderr)
-    {
-        int use_color = 0;
-#if !defined(_WIN32)
-        use_color = 1;
 #endif
 
-        p = logstr;
-        last = logstr + OGS_HUGE_LEN;
-
-        if (!content_only) {
-            p = log_timestamp(p, last, use_color);
-            p = log_level(p, last, level, use_color);
-        }
-        p = log_content(p, last, format, ap);
-        if (!content_only) {
-            p = ogs_slprintf(p, last, " (%s:%d)", file, line);
-            p = ogs_slprintf(p, last, " %s()", func);
-            p = log_linefeed(p, last);
-        }
-
-        fprintf(stderr, "%s", logstr);
-        fflush(stderr);
-    }
+    log_output(level, domain, err, file, line, func,
+            content_only, &tv, content);
 }
 
 void ogs_log_printf(ogs_log_level_e level, int id,
@@ -506,6 +600,9 @@ void ogs_log_hexdump_func(ogs_log_level_e level, int id,
 static ogs_log_t *add_log(ogs_log_type_e type)
 {
     ogs_log_t *log = NULL;
+#if !defined(_WIN32)
+    bool locked;
+#endif
 
     ogs_pool_alloc(&log_pool, &log);
     ogs_assert(log);
@@ -519,8 +616,21 @@ static ogs_log_t *add_log(ogs_log_type_e type)
     log->print.fileline = 1;
     log->print.linefeed = 1;
 
+#if !defined(_WIN32)
+    locked = async_running();
+    if (locked) {
+        log->batch.buf = malloc(LOG_BATCH_SIZE);
+        ogs_assert(log->batch.buf);
+        ogs_thread_mutex_lock(&async.mutex);
+    }
+#endif
+
     ogs_list_add(&log_list, log);
 
+#if !defined(_WIN32)
+    if (locked) ogs_thread_mutex_unlock(&async.mutex);
+#endif
+
     return log;
 }
 
@@ -538,19 +648,17 @@ static int file_cycle(ogs_log_t *log)
 }
 
 static char *log_timestamp(char *buf, char *last,
-        int use_color)
+        struct timeval *tv, int use_color)
 {
-    struct timeval tv;
     struct tm tm;
     char nowstr[32];
 
-    ogs_gettimeofday(&tv);
-    ogs_localtime(tv.tv_sec, &tm);
+    ogs_localtime(tv->tv_sec, &tm);
     strftime(nowstr, sizeof nowstr, "%m/%d %H:%M:%S", &tm);
 
     buf = ogs_slprintf(buf, last, "%s%s.%03d%s: ",
             use_color ? TA_FGC_GREEN : "",
-            nowstr, (int)(tv.tv_usec/1000),
+            nowstr, (int)(tv->tv_usec/1000),
             use_color ? TA_NOR : "");
 
     return buf;
@@ -584,21 +692,6 @@ static char *log_level(char *buf, char *last,
     return buf;
 }
 
-static char *log_content(char *buf, char *last,
-        const char *format, va_list ap)
-{
-    va_list bp;
-
-    va_copy(bp, ap);
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wformat-nonliteral"
-    buf = ogs_vslprintf(buf, last, format, bp);
-#pragma GCC diagnostic pop
-    va_end(bp);
-
-    return buf;
-}
-
 static char *log_linefeed(char *buf, char *last)
 {
 #if defined(_WIN32)
@@ -619,7 +712,437 @@ static char *log_linefeed(char *buf, char *last)
 static void file_writer(
         ogs_log_t *log, ogs_log_level_e level, const char *string)
 {
+#if !defined(_WIN32)
+    /*
+     * Other threads may write synchronously while the asynchronous
+     * logging is stopping, so they never touch the batch.
+     */
+    if (log_batching && log->batch.buf) {
+        size_t len = strlen(string);
+
+        if (log->batch.len + len > LOG_BATCH_SIZE) {
+            fwrite(log->batch.buf, 1, log->batch.len, log->file.out);
+            log->batch.len = 0;
+        }
+        if (len <= LOG_BATCH_SIZE) {
+            memcpy(log->batch.buf + log->batch.len, string, len);
+            log->batch.len += len;
+            return;
+        }
+    }
+#endif
+
     fprintf(log->file.out, "%s", string);
     fflush(log->file.out);
 }
 
+static void log_output(ogs_log_level_e level, ogs_log_domain_t *domain,
+        ogs_err_t err, const char *file, int line, const char *func,
+        int content_only, struct timeval *tv, const char *content)
+{
+    ogs_log_t *log = NULL;
+
+    char logstr[OGS_HUGE_LEN];
+    char *p, *last;
+
+    int wrote_stderr = 0;
+
+    ogs_list_for_each(&log_list, log) {
+        p = logstr;
+        last = logstr + OGS_HUGE_LEN;
+
+        if (!content_only) {
+            if (log->print.timestamp)
+                p = log_timestamp(p, last, tv, log->print.color);
+            if (log->print.domain && domain)
+                p = log_domain(p, last, domain->name, log->print.color);
+            if (log->print.level)
+                p = log_level(p, last, level, log->print.color);
+        }
+
+        p = ogs_slprintf(p, last, "%s", content);
+
+        if (err) {
+            char errbuf[OGS_HUGE_LEN];
+            p = ogs_slprintf(p, last, " (%d:%s)",
+                    (int)err, ogs_strerror(err, errbuf, OGS_HUGE_LEN));
+        }
+
+        if (!content_only) {
+            if (log->print.fileline)
+                p = ogs_slprintf(p, last, " (%s:%d)", file, line);
+            if (log->print.function)
+                p = ogs_slprintf(p, last, " %s()", func);
+            if (log->print.linefeed) 
+                p = log_linefeed(p, last);
+        }
+
+        log->writer(log, level, logstr);
+        
+        if (log->type == OGS_LOG_STDERR_TYPE)
+            wrote_stderr = 1;
+    }
+
+    if (!wrote_stderr)
+    {
+        int use_color = 0;
+#if !defined(_WIN32)
+        use_color = 1;
+#endif
+
+        p = logstr;
+        last = logstr + OGS_HUGE_LEN;
+
+        if (!content_only) {
+            p = log_timestamp(p, last, tv, use_color);
+            p = log_level(p, last, level, use_color);
+        }
+        p = ogs_slprintf(p, last, "%s", content);
+        if (!content_only) {
+            p = ogs_slprintf(p, last, " (%s:%d)", file, line);
+            p = ogs_slprintf(p, last, " %s()", func);
+            p = log_linefeed(p, last);
+        }
+
+        fprintf(stderr, "%s", logstr);
+        fflush(stderr);
+    }
+}
+
+static void log_flush(void)
+{
+    ogs_log_t *log = NULL;
+
+    ogs_list_for_each(&log_list, log) {
+        if (log->batch.buf && log->batch.len) {
+            fwrite(log->batch.buf, 1, log->batch.len, log->file.out);
+            log->batch.len = 0;
+        }
+        fflush(log->file.out);
+    }
+}
+
+
+#if !defined(_WIN32)
+
+/*
+ * A producer registers itself before it checks async.running, and
+ * ogs_log_async_stop() clears async.running before it waits for the
+ * producers to leave. Either the producer sees the stop and logs
+ * synchronously, or the stop waits for it. So no thread is still
+ * writing into a ring when the rings are freed.
+ */
+static bool async_enter(void)
+{
+    __atomic_add_fetch(&async.producers, 1, __ATOMIC_SEQ_CST);
+    if (async_running())
+        return true;
+
+    __atomic_sub_fetch(&async.producers, 1, __ATOMIC_SEQ_CST);
+    return false;
+}
+
+static void async_leave(void)
+{
+    __atomic_sub_fetch(&async.producers, 1, __ATOMIC_SEQ_CST);
+}
+
+static void ring_destructor(void *data)
+{
+    log_ring_t *ring = data;
+    ogs_assert(ring);
+
+    __atomic_store_n(&ring->orphan, true, __ATOMIC_RELEASE);
+}
+
+static log_ring_t *ring_get(void)
+{
+    log_ring_t *ring = NULL;
+
+    if (thread_ring && thread_generation == async.generation)
+        return thread_ring;
+
+    ring = calloc(1, sizeof *ring);
+    ogs_assert(ring);
+    ring->buf = malloc(LOG_RING_SIZE);
+    ogs_assert(ring->buf);
+
+    ogs_thread_mutex_lock(&async.ring_mutex);
+    ogs_list_add(&async.ring_list, ring);
+    ogs_thread_mutex_unlock(&async.ring_mutex);
+
+    pthread_setspecific(async.ring_key, ring);
+
+    thread_ring = ring;
+    thread_generation = async.generation;
+
+    return ring;
+}
+
+static void ring_free(log_ring_t *ring)
+{
+    ogs_assert(ring);
+
+    ogs_list_remove(&async.ring_list, ring);
+
+    free(ring->buf);
+    free(ring);
+}
+
+static void async_push(ogs_log_level_e level, int id,
+        ogs_err_t err, const char *file, int line, const char *func,
+        int content_only, struct timeval *tv, const char *content)
+{
+    log_ring_t *ring = NULL;
+    log_record_t *record = NULL;
+
+    uint64_t head, tail;
+    size_t offset, contiguous, len, size, need;
+    bool empty;
+
+    ring = ring_get();
+    ogs_assert(ring);
+
+    len = strlen(content) + 1;
+    size = LOG_RECORD_ALIGN(sizeof(*record) + len);
+
+    head = ring->head;
+    tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    empty = (head == tail);
+
+    offset = head % LOG_RING_SIZE;
+    contiguous = LOG_RING_SIZE - offset;
+
+    /* A record never wraps. Skip the rest of the ring with a padding */
+    need = size > contiguous ? contiguous + size : size;
+    if (head + need - tail > LOG_RING_SIZE) {
+        __atomic_add_fetch(&ring->dropped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    if (size > contiguous) {
+        record = (log_record_t *)(ring->buf + offset);
+        record->size = contiguous;
+        record->padding = 1;
+
+        head += contiguous;
+        offset = 0;
+    }
+
+    record = (log_record_t *)(ring->buf + offset);
+    record->size = size;
+    record->padding = 0;
+    record->level = level;
+    record->content_only = content_only;
+    record->id = id;
+    record->err = err;
+    record->line = line;
+    record->file = file;
+    record->func = func;
+    record->tv = *tv;
+    memcpy(record + 1, content, len);
+
+    __atomic_store_n(&ring->head, head + size, __ATOMIC_RELEASE);
+
+    /* Wake up the logging thread only if the ring was empty */
+    if (empty) {
+        ogs_thread_mutex_lock(&async.wait_mutex);
+        ogs_thread_cond_signal(&async.cond);
+        ogs_thread_mutex_unlock(&async.wait_mutex);
+    }
+}
+
+static void ring_drain(log_ring_t *ring)
+{
+    log_record_t *record = NULL;
+    uint64_t head, tail;
+
+    ogs_assert(ring);
+
+    tail = ring->tail;
+    head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    while (tail != head) {
+        record = (log_record_t *)(ring->buf + (tail % LOG_RING_SIZE));
+
+        if (!record->padding)
+            log_output(record->level,
+                    ogs_pool_find(&domain_pool, record->id),
+                    record->err, record->file, record->line, record->func,
+                    record->content_only, &record->tv,
+                    (const char *)(record + 1));
+
+        tail += record->size;
+    }
+
+    __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+}
+
+static void async_drain(void)
+{
+    log_ring_t *ring = NULL, *next_ring = NULL;
+    uint64_t dropped;
+    bool orphan;
+
+    ogs_thread_mutex_lock(&async.ring_mutex);
+
+    ogs_list_for_each_safe(&async.ring_list, next_ring, ring) {
+        orphan = __atomic_load_n(&ring->orphan, __ATOMIC_ACQUIRE);
+
+        ring_drain(ring);
+
+        dropped = __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+        async.dropped += dropped - ring->reported;
+        ring->reported = dropped;
+
+        if (orphan)
+            ring_free(ring);
+    }
+
+    ogs_thread_mutex_unlock(&async.ring_mutex);
+
+    if (async.dropped) {
+        ogs_time_t now = ogs_get_monotonic_time();
+
+        if (now - async.last_report >= LOG_DROP_REPORT_INTERVAL) {
+            struct timeval tv;
+            char content[OGS_HUGE_LEN];
+
+            ogs_gettimeofday(&tv);
+            ogs_snprintf(content, sizeof(content),
+                    "%llu log messages dropped",
+                    (unsigned long long)async.dropped);
+            log_output(OGS_LOG_WARN,
+                    ogs_pool_find(&domain_pool, OGS_LOG_DOMAIN),
+                    0, __FILE__, __LINE__, OGS_FUNC, 0, &tv, content);
+
+            async.dropped = 0;
+            async.last_report = now;
+        }
+    }
+}
+
+static void async_main(void *data)
+{
+    log_batching = true;
+
+    for ( ;; ) {
+        ogs_thread_mutex_lock(&async.mutex);
+        async_drain();
+        log_flush();
+        ogs_thread_mutex_unlock(&async.mutex);
+
+        ogs_thread_mutex_lock(&async.wait_mutex);
+        if (async.terminated) {
+            ogs_thread_mutex_unlock(&async.wait_mutex);
+            break;
+        }
+        ogs_thread_cond_timedwait(
+                &async.cond, &async.wait_mutex, LOG_WAIT_INTERVAL);
+        ogs_thread_mutex_unlock(&async.wait_mutex);
+    }
+}
+
+int ogs_log_async_start(void)
+{
+    pthread_mutexattr_t attr;
+    ogs_log_t *log = NULL;
+
+    if (async_running())
+        return OGS_OK;
+
+    /* ogs_fatal() can be called while the log targets are locked */
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&async.mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    ogs_thread_mutex_init(&async.wait_mutex);
+    ogs_thread_cond_init(&async.cond);
+    ogs_thread_mutex_init(&async.ring_mutex);
+    ogs_list_init(&async.ring_list);
+
+    if (pthread_key_create(&async.ring_key, ring_destructor) != 0) {
+        ogs_error("pthread_key_create() failed");
+        return OGS_ERROR;
+    }
+
+    ogs_list_for_each(&log_list, log) {
+        log->batch.buf = malloc(LOG_BATCH_SIZE);
+        ogs_assert(log->batch.buf);
+        log->batch.len = 0;
+    }
+
+    async.generation++;
+    async.terminated = false;
+    async.dropped = 0;
+    async.last_report = 0;
+    __atomic_store_n(&async.running, true, __ATOMIC_SEQ_CST);
+
+    async.thread = ogs_thread_create(async_main, NULL);
+    ogs_assert(async.thread);
+
+    return OGS_OK;
+}
+
+void ogs_log_async_stop(void)
+{
+    ogs_log_t *log = NULL;
+    log_ring_t *ring = NULL, *next_ring = NULL;
+
+    if (!async_running())
+        return;
+
+    /* From now on, messages are written synchronously */
+    __atomic_store_n(&async.running, false, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&async.producers, __ATOMIC_SEQ_CST))
+        ogs_usleep(100);
+
+    ogs_thread_mutex_lock(&async.wait_mutex);
+    async.terminated = true;
+    ogs_thread_cond_signal(&async.cond);
+    ogs_thread_mutex_unlock(&async.wait_mutex);
+
+    ogs_thread_destroy(async.thread);
+    async.thread = NULL;
+
+    ogs_thread_mutex_lock(&async.mutex);
+    async_drain();
+    if (async.dropped) {
+        async.last_report = 0;
+        async_drain();
+    }
+    log_flush();
+
+    ogs_list_for_each(&log_list, log) {
+        free(log->batch.buf);
+        log->batch.buf = NULL;
+        log->batch.len = 0;
+    }
+    ogs_thread_mutex_unlock(&async.mutex);
+
+    pthread_key_delete(async.ring_key);
+    thread_ring = NULL;
+
+    ogs_list_for_each_safe(&async.ring_list, next_ring, ring)
+        ring_free(ring);
+
+    ogs_thread_mutex_destroy(&async.ring_mutex);
+    ogs_thread_cond_destroy(&async.cond);
+    ogs_thread_mutex_destroy(&async.wait_mutex);
+    ogs_thread_mutex_destroy(&async.mutex);
+}
+
+#else
+
+int ogs_log_async_start(void)
+{
+    ogs_warn("Asynchronous logging is not supported");
+    return OGS_ERROR;
+}
+
+void ogs_log_async_stop(void)
+{
+}
+
+#endif
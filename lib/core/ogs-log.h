@@ -71,6 +71,9 @@ void ogs_log_init(void);
 void ogs_log_final(void);
 void ogs_log_cycle(void);
 
+int ogs_log_async_start(void);
+void ogs_log_async_stop(void);
+
 ogs_log_t *ogs_log_add_stderr(void);
 ogs_log_t *ogs_log_add_file(const char *name);
 void ogs_log_remove(ogs_log_t *log);
@@ -17,8 +17,14 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "core-config-private.h"
+
 #include "ogs-core.h"
 
+#if HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
 #undef OGS_LOG_DOMAIN
 #define OGS_LOG_DOMAIN __ogs_mem_domain
 
@@ -218,3 +224,35 @@ void *ogs_realloc_debug(void *ptr, size_t size, const char *file_line)
         return ptr;
     }
 }
+
+/*****************************************
+ * Memory Pool - Use system malloc() for ogs_pool_init()
+ *****************************************/
+
+#define OGS_HUGEPAGE_SIZE (2*1024*1024)
+
+void *ogs_pool_malloc(size_t size)
+{
+#if defined(MADV_HUGEPAGE)
+    /*
+     * The array is not touched in ogs_pool_init(), so the hugepage is
+     * committed one by one as the pool fills.
+     */
+    if (ogs_core()->pool.hugepage == true && size >= OGS_HUGEPAGE_SIZE) {
+        void *ptr = NULL;
+
+        if (posix_memalign(&ptr, OGS_HUGEPAGE_SIZE, size) != 0) {
+            ogs_error("posix_memalign[size:%d] failed", (int)size);
+            return NULL;
+        }
+
+        if (madvise(ptr, size, MADV_HUGEPAGE) != 0)
+            ogs_log_message(OGS_LOG_WARN, ogs_errno,
+                    "madvise(MADV_HUGEPAGE) failed");
+
+        return ptr;
+    }
+#endif
+
+    return malloc(size);
+}
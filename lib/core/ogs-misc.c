@@ -32,8 +32,14 @@
  * limitations under the License.
  */
 
+#include "core-config-private.h"
+
 #include "ogs-core.h"
 
+#if HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
 #define PATH_SEPARATOR '/'
 
 /* Remove trailing separators that don't affect the meaning of PATH. */
@@ -88,3 +94,22 @@ bool ogs_path_is_absolute(const char *filename)
 
     return false;
 }
+
+/* Peak resident set size in bytes, or 0 if not available */
+uint64_t ogs_get_max_rss(void)
+{
+#if HAVE_SYS_RESOURCE_H
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+#if defined(__APPLE__)
+    return (uint64_t)usage.ru_maxrss;
+#else
+    return (uint64_t)usage.ru_maxrss * 1024;
+#endif
+#else
+    return 0;
+#endif
+}
@@ -46,6 +46,8 @@ extern "C" {
 void ogs_path_remove_last_component(char *dir, const char *path);
 bool ogs_path_is_absolute(const char *filename);
 
+uint64_t ogs_get_max_rss(void);
+
 #ifdef __cplusplus
 }
 #endif
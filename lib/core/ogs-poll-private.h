@@ -50,6 +50,9 @@ typedef struct ogs_pollset_s {
     } notify;
 
     unsigned int capacity;
+
+    /* Spin without blocking after the events, up to this duration */
+    ogs_time_t busy_poll;
 } ogs_pollset_t;
 
 #ifdef __cplusplus
@@ -65,6 +65,7 @@ void ogs_pollset_destroy(ogs_pollset_t *pollset)
     ogs_assert(pollset);
 
     ogs_pollset_actions.cleanup(pollset);
+    ogs_time_cache_disable();
 
     ogs_pool_final(&pollset->pool);
     ogs_free(pollset);
@@ -131,3 +132,9 @@ void *ogs_pollset_self_handler_data(void)
 {
     return &self_handler_data;
 }
+
+void ogs_pollset_set_busy_poll(ogs_pollset_t *pollset, ogs_time_t duration)
+{
+    ogs_assert(pollset);
+    pollset->busy_poll = duration;
+}
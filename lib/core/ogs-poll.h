@@ -36,12 +36,25 @@ void ogs_pollset_destroy(ogs_pollset_t *pollset);
 #define OGS_POLLIN      0x01
 #define OGS_POLLOUT     0x02
 
+/*
+ * Edge-triggered registration (epoll only, ignored by the others)
+ *
+ * The handler must read until EAGAIN. If it stops earlier because
+ * it has run out of OGS_POLL_BUDGET, it has to call ogs_pollset_rearm()
+ * so that the remaining data is reported again in the next poll.
+ */
+#define OGS_POLLET      0x04
+
+#define OGS_POLL_BUDGET 64
+
 ogs_poll_t *ogs_pollset_add(ogs_pollset_t *pollset, short when,
         ogs_socket_t fd, ogs_poll_handler_f handler, void *data);
 void ogs_pollset_remove(ogs_poll_t *poll);
 
 void *ogs_pollset_self_handler_data(void);
 
+void ogs_pollset_set_busy_poll(ogs_pollset_t *pollset, ogs_time_t duration);
+
 typedef struct ogs_pollset_actions_s {
     void (*init)(ogs_pollset_t *pollset);
     void (*cleanup)(ogs_pollset_t *pollset);
@@ -51,12 +64,15 @@ typedef struct ogs_pollset_actions_s {
 
     int (*poll)(ogs_pollset_t *pollset, ogs_time_t timeout);
     int (*notify)(ogs_pollset_t *pollset);
+
+    int (*rearm)(ogs_pollset_t *pollset, ogs_socket_t fd);
 } ogs_pollset_actions_t;
 
 extern ogs_pollset_actions_t ogs_pollset_actions;
 
 #define ogs_pollset_poll ogs_pollset_actions.poll
 #define ogs_pollset_notify ogs_pollset_actions.notify
+#define ogs_pollset_rearm ogs_pollset_actions.rearm
 
 #ifdef __cplusplus
 }
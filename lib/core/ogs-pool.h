@@ -30,11 +30,25 @@ extern "C" {
 
 typedef uint32_t ogs_pool_id_t;
 
+void *ogs_pool_malloc(size_t size);
+
+/*
+ * The nodes are committed on demand.
+ *
+ * ogs_pool_init() only reserves the memory, and does not touch it.
+ * The node which has never been allocated is taken from the array
+ * in order('used' is the high-water mark), so the pages of the array are
+ * committed by the kernel as the pool fills. The node released with
+ * ogs_pool_free() is queued into the 'free' ring, which is used only
+ * after all nodes in the array have been allocated once. This gives
+ * the same allocation order as a pre-filled free list, so the index
+ * is stable and ogs_pool_cycle() keeps working.
+ */
 #define OGS_POOL(pool, type) \
     struct { \
         const char *name; \
         int head, tail; \
-        int size, avail; \
+        int size, avail, used; \
         type **free, *array, **index; \
     } pool
 
@@ -43,20 +57,15 @@ typedef uint32_t ogs_pool_id_t;
  * Otherwise, memory will be fragment since this function uses system malloc()
  */
 #define ogs_pool_init(pool, _size) do { \
-    int i; \
     (pool)->name = #pool; \
-    (pool)->free = malloc(sizeof(*(pool)->free) * _size); \
+    (pool)->free = ogs_pool_malloc(sizeof(*(pool)->free) * _size); \
     ogs_assert((pool)->free); \
-    (pool)->array = malloc(sizeof(*(pool)->array) * _size); \
+    (pool)->array = ogs_pool_malloc(sizeof(*(pool)->array) * _size); \
     ogs_assert((pool)->array); \
-    (pool)->index = malloc(sizeof(*(pool)->index) * _size); \
+    (pool)->index = calloc(_size, sizeof(*(pool)->index)); \
     ogs_assert((pool)->index); \
     (pool)->size = (pool)->avail = _size; \
-    (pool)->head = (pool)->tail = 0; \
-    for (i = 0; i < _size; i++) { \
-        (pool)->free[i] = &((pool)->array[i]); \
-        (pool)->index[i] = NULL; \
-    } \
+    (pool)->head = (pool)->tail = (pool)->used = 0; \
 } while (0)
 
 /*
@@ -79,20 +88,15 @@ typedef uint32_t ogs_pool_id_t;
  * so this function should use ogs_malloc() instead of system malloc()
  */
 #define ogs_pool_create(pool, _size) do { \
-    int i; \
     (pool)->name = #pool; \
     (pool)->free = ogs_malloc(sizeof(*(pool)->free) * _size); \
     ogs_assert((pool)->free); \
     (pool)->array = ogs_malloc(sizeof(*(pool)->array) * _size); \
     ogs_assert((pool)->array); \
-    (pool)->index = ogs_malloc(sizeof(*(pool)->index) * _size); \
+    (pool)->index = ogs_calloc(_size, sizeof(*(pool)->index)); \
     ogs_assert((pool)->index); \
     (pool)->size = (pool)->avail = _size; \
-    (pool)->head = (pool)->tail = 0; \
-    for (i = 0; i < _size; i++) { \
-        (pool)->free[i] = &((pool)->array[i]); \
-        (pool)->index[i] = NULL; \
-    } \
+    (pool)->head = (pool)->tail = (pool)->used = 0; \
 } while (0)
 
 /*
@@ -120,9 +124,13 @@ typedef uint32_t ogs_pool_id_t;
     *(node) = NULL; \
     if ((pool)->avail > 0) { \
         (pool)->avail--; \
-        *(node) = (void*)(pool)->free[(pool)->head]; \
-        (pool)->free[(pool)->head] = NULL; \
-        (pool)->head = ((pool)->head + 1) % ((pool)->size); \
+        if ((pool)->used < (pool)->size) { \
+            *(node) = (void*)&(pool)->array[(pool)->used++]; \
+        } else { \
+            *(node) = (void*)(pool)->free[(pool)->head]; \
+            (pool)->free[(pool)->head] = NULL; \
+            (pool)->head = ((pool)->head + 1) % ((pool)->size); \
+        } \
         (pool)->index[ogs_pool_index(pool, *(node))-1] = *(node); \
     } \
 } while (0)
@@ -138,6 +146,7 @@ typedef uint32_t ogs_pool_id_t;
 
 #define ogs_pool_size(pool) ((pool)->size)
 #define ogs_pool_avail(pool) ((pool)->avail)
+#define ogs_pool_used(pool) ((pool)->used)
 
 #define ogs_pool_sequence_id_generate(pool) do { \
     int i; \
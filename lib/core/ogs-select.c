@@ -31,6 +31,7 @@ static void select_cleanup(ogs_pollset_t *pollset);
 static int select_add(ogs_poll_t *poll);
 static int select_remove(ogs_poll_t *poll);
 static int select_process(ogs_pollset_t *pollset, ogs_time_t timeout);
+static int select_rearm(ogs_pollset_t *pollset, ogs_socket_t fd);
 
 const ogs_pollset_actions_t ogs_select_actions = {
     select_init,
@@ -41,6 +42,8 @@ const ogs_pollset_actions_t ogs_select_actions = {
     select_process,
 
     ogs_notify_pollset,
+
+    select_rearm,
 };
 
 struct select_context_s {
@@ -174,6 +177,7 @@ static int select_process(ogs_pollset_t *pollset, ogs_time_t timeout)
 
     rc = select(context->max_fd + 1,
             &context->work_read_fd_set, &context->work_write_fd_set, NULL, tp);
+    ogs_time_cache_update();
     if (rc < 0) {
         ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno, "select() failed");
         return OGS_ERROR;
@@ -200,3 +204,9 @@ static int select_process(ogs_pollset_t *pollset, ogs_time_t timeout)
     
     return OGS_OK;
 }
+
+static int select_rearm(ogs_pollset_t *pollset, ogs_socket_t fd)
+{
+    /* Level-triggered only. Nothing to do */
+    return OGS_OK;
+}
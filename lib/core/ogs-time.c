@@ -201,6 +201,59 @@ uint32_t ogs_time_to_ntp32(ogs_time_t time)
     return (time / OGS_USEC_PER_SEC) + OGS_1970_1900_SEC_DIFF;
 }
 
+#if !defined(_WIN32)
+static __thread struct {
+    bool enabled;
+    ogs_time_t now;
+    ogs_time_t monotonic;
+} cache;
+#endif
+
+void ogs_time_cache_update(void)
+{
+#if !defined(_WIN32)
+    cache.enabled = true;
+    cache.now = 0;
+    cache.monotonic = 0;
+#endif
+}
+
+void ogs_time_cache_disable(void)
+{
+#if !defined(_WIN32)
+    cache.enabled = false;
+#endif
+}
+
+ogs_time_t ogs_time_coarse_now(void)
+{
+#if !defined(_WIN32)
+    if (cache.enabled) {
+        if (!cache.now)
+            cache.now = ogs_time_now();
+        return cache.now;
+    }
+#endif
+    return ogs_time_now();
+}
+
+uint32_t ogs_time_ntp32_coarse_now(void)
+{
+    return ogs_time_to_ntp32(ogs_time_coarse_now());
+}
+
+ogs_time_t ogs_get_coarse_monotonic_time(void)
+{
+#if !defined(_WIN32)
+    if (cache.enabled) {
+        if (!cache.monotonic)
+            cache.monotonic = ogs_get_monotonic_time();
+        return cache.monotonic;
+    }
+#endif
+    return ogs_get_monotonic_time();
+}
+
 int ogs_timezone(void)
 {
 #if defined(_WIN32)
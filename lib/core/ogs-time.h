@@ -106,6 +106,27 @@ uint32_t ogs_time_to_ntp32(ogs_time_t time);
 
 /** @return number of microseconds since an arbitrary point */
 ogs_time_t ogs_get_monotonic_time(void);
+
+/*
+ * Coarse Clock
+ *
+ * The event loop calls ogs_time_cache_update() on every pollset wakeup.
+ * The clock is read once at the first call after the wakeup, and
+ * the same value is returned until the next wakeup.
+ *
+ * Precision : one event loop iteration.
+ * Use it on the hot path where the time when the current event started
+ * is good enough (e.g. usage report, timer arming).
+ *
+ * In a thread without the event loop, they are the same as
+ * ogs_time_now(), ogs_time_ntp32_now() and ogs_get_monotonic_time().
+ */
+void ogs_time_cache_update(void);
+void ogs_time_cache_disable(void);
+
+ogs_time_t ogs_time_coarse_now(void); /* This returns GMT */
+uint32_t ogs_time_ntp32_coarse_now(void);
+ogs_time_t ogs_get_coarse_monotonic_time(void);
 /** @return the GMT offset in seconds */
 int ogs_timezone(void);
 
@@ -95,33 +95,120 @@ static uint8_t tlv_ctype2mode(ogs_tlv_type_e ctype, uint8_t msg_mode)
     }
 }
 
-static ogs_tlv_t *tlv_add_leaf(
-        ogs_tlv_t *parent_tlv, ogs_tlv_t *tlv, ogs_tlv_desc_t *desc, void *msg, uint8_t msg_mode)
+static uint32_t tlv_header_length(uint8_t mode)
 {
-    uint8_t tlv_mode = tlv_ctype2mode(desc->ctype, msg_mode);
+    switch(mode) {
+    case OGS_TLV_MODE_T1_L1:
+        return 2;
+    case OGS_TLV_MODE_T1_L2:
+        return 3;
+    case OGS_TLV_MODE_T1_L2_I1:
+    case OGS_TLV_MODE_T2_L2:
+        return 4;
+    case OGS_TLV_MODE_T1:
+        return 1;
+    default:
+        ogs_assert_if_reached();
+        break;
+    }
+
+    return 0;
+}
+
+static uint8_t *tlv_put_header(uint8_t *pos, uint8_t mode,
+        uint16_t type, uint32_t length, uint8_t instance)
+{
+    switch(mode) {
+    case OGS_TLV_MODE_T1_L1:
+        *(pos++) = type & 0xFF;
+        *(pos++) = length & 0xFF;
+        break;
+    case OGS_TLV_MODE_T1_L2:
+        *(pos++) = type & 0xFF;
+        *(pos++) = (length >> 8) & 0xFF;
+        *(pos++) = length & 0xFF;
+        break;
+    case OGS_TLV_MODE_T1_L2_I1:
+        *(pos++) = type & 0xFF;
+        *(pos++) = (length >> 8) & 0xFF;
+        *(pos++) = length & 0xFF;
+        *(pos++) = instance & 0xFF;
+        break;
+    case OGS_TLV_MODE_T2_L2:
+        *(pos++) = (type >> 8) & 0xFF;
+        *(pos++) = type & 0xFF;
+        *(pos++) = (length >> 8) & 0xFF;
+        *(pos++) = length & 0xFF;
+        break;
+    case OGS_TLV_MODE_T1:
+        *(pos++) = type & 0xFF;
+        break;
+    default:
+        ogs_assert_if_reached();
+        break;
+    }
 
+    return pos;
+}
+
+/* Return the value length of a leaf IE, or -1 if it cannot be encoded */
+static int tlv_leaf_length(ogs_tlv_desc_t *desc, void *msg)
+{
     switch (desc->ctype) {
     case OGS_TLV_UINT8:
     case OGS_TLV_INT8:
     case OGS_TV_UINT8:
     case OGS_TV_INT8:
+        return 1;
+    case OGS_TLV_UINT16:
+    case OGS_TLV_INT16:
+    case OGS_TV_UINT16:
+    case OGS_TV_INT16:
+        return 2;
+    case OGS_TLV_UINT24:
+    case OGS_TLV_INT24:
+    case OGS_TV_UINT24:
+    case OGS_TV_INT24:
+        return 3;
+    case OGS_TLV_UINT32:
+    case OGS_TLV_INT32:
+    case OGS_TV_UINT32:
+    case OGS_TV_INT32:
+        return 4;
+    case OGS_TLV_FIXED_STR:
+    case OGS_TV_FIXED_STR:
+        return desc->length;
+    case OGS_TLV_VAR_STR:
     {
-        ogs_tlv_uint8_t *v = (ogs_tlv_uint8_t *)msg;
-        if (parent_tlv) {
-            tlv = ogs_tlv_embed(parent_tlv, tlv_mode,
-                    desc->type, 1, desc->instance, &v->u8);
-            if (!tlv) {
-                ogs_error("ogs_tlv_embed()");
-                return NULL;
-            }
-        } else {
-            tlv = ogs_tlv_add(tlv, tlv_mode,
-                    desc->type, 1, desc->instance, &v->u8);
-            if (!tlv) {
-                ogs_error("ogs_tlv_add()");
-                return NULL;
-            }
+        ogs_tlv_octet_t *v = (ogs_tlv_octet_t *)msg;
+
+        if (v->len == 0) {
+            ogs_error("No TLV length - [%s] T:%d I:%d (vsz=%d)",
+                    desc->name, desc->type, desc->instance, desc->vsize);
+            return -1;
         }
+        return v->len;
+    }
+    case OGS_TLV_NULL:
+    case OGS_TV_NULL:
+        return 0;
+    default:
+        ogs_error("Unknown type [%d]", desc->ctype);
+        return -1;
+    }
+}
+
+/* Values are written in network byte order without touching the message */
+static void tlv_put_leaf(uint8_t *pos, ogs_tlv_desc_t *desc, void *msg)
+{
+    switch (desc->ctype) {
+    case OGS_TLV_UINT8:
+    case OGS_TLV_INT8:
+    case OGS_TV_UINT8:
+    case OGS_TV_INT8:
+    {
+        ogs_tlv_uint8_t *v = (ogs_tlv_uint8_t *)msg;
+        pos[0] = v->u8;
         break;
     }
     case OGS_TLV_UINT16:
@@ -130,24 +217,8 @@ static ogs_tlv_t *tlv_add_leaf(
     case OGS_TV_INT16:
     {
         ogs_tlv_uint16_t *v = (ogs_tlv_uint16_t *)msg;
-
-        v->u16 = htobe16(v->u16);
-
-        if (parent_tlv) {
-            tlv = ogs_tlv_embed(parent_tlv, tlv_mode,
-                    desc->type, 2, desc->instance, &v->u16);
-            if (!tlv) {
-                ogs_error("ogs_tlv_embed()");
-                return NULL;
-            }
-        } else {
-            tlv = ogs_tlv_add(tlv, tlv_mode,
-                    desc->type, 2, desc->instance, &v->u16);
-            if (!tlv) {
-                ogs_error("ogs_tlv_add()");
-                return NULL;
-            }
-        }
+        pos[0] = (v->u16 >> 8) & 0xFF;
+        pos[1] = v->u16 & 0xFF;
         break;
     }
     case OGS_TLV_UINT24:
@@ -156,25 +227,9 @@ static ogs_tlv_t *tlv_add_leaf(
     case OGS_TV_INT24:
     {
         ogs_tlv_uint24_t *v = (ogs_tlv_uint24_t *)msg;
-
-        v->u24 = v->u24 << 8;
-        v->u24 = htobe32(v->u24);
-
-        if (parent_tlv) {
-            tlv = ogs_tlv_embed(parent_tlv, tlv_mode,
-                    desc->type, 3, desc->instance, &v->u24);
-            if (!tlv) {
-                ogs_error("ogs_tlv_embed()");
-                return NULL;
-            }
-        } else {
-            tlv = ogs_tlv_add(tlv, tlv_mode,
-                    desc->type, 3, desc->instance, &v->u24);
-            if (!tlv) {
-                ogs_error("ogs_tlv_add()");
-                return NULL;
-            }
-        }
+        pos[0] = (v->u24 >> 16) & 0xFF;
+        pos[1] = (v->u24 >> 8) & 0xFF;
+        pos[2] = v->u24 & 0xFF;
         break;
     }
     case OGS_TLV_UINT32:
@@ -183,234 +238,141 @@ static ogs_tlv_t *tlv_add_leaf(
     case OGS_TV_INT32:
     {
         ogs_tlv_uint32_t *v = (ogs_tlv_uint32_t *)msg;
-
-        v->u32 = htobe32(v->u32);
-
-        if (parent_tlv) {
-            tlv = ogs_tlv_embed(parent_tlv, tlv_mode,
-                    desc->type, 4, desc->instance, &v->u32);
-            if (!tlv) {
-                ogs_error("ogs_tlv_embed()");
-                return NULL;
-            }
-        } else {
-            tlv = ogs_tlv_add(tlv, tlv_mode,
-                    desc->type, 4, desc->instance, &v->u32);
-            if (!tlv) {
-                ogs_error("ogs_tlv_add()");
-                return NULL;
-            }
-        }
+        pos[0] = (v->u32 >> 24) & 0xFF;
+        pos[1] = (v->u32 >> 16) & 0xFF;
+        pos[2] = (v->u32 >> 8) & 0xFF;
+        pos[3] = v->u32 & 0xFF;
         break;
     }
     case OGS_TLV_FIXED_STR:
     case OGS_TV_FIXED_STR:
     {
         ogs_tlv_octet_t *v = (ogs_tlv_octet_t *)msg;
-
-        if (parent_tlv) {
-            tlv = ogs_tlv_embed(parent_tlv, tlv_mode,
-                    desc->type, desc->length, desc->instance, v->data);
-            if (!tlv) {
-                ogs_error("ogs_tlv_embed()");
-                return NULL;
-            }
-        } else {
-            tlv = ogs_tlv_add(tlv, tlv_mode,
-                    desc->type, desc->length, desc->instance, v->data);
-            if (!tlv) {
-                ogs_error("ogs_tlv_add()");
-                return NULL;
-            }
+        if (desc->length) {
+            ogs_assert(v->data);
+            memcpy(pos, v->data, desc->length);
         }
         break;
     }
     case OGS_TLV_VAR_STR:
     {
         ogs_tlv_octet_t *v = (ogs_tlv_octet_t *)msg;
-
-        if (v->len == 0) {
-            ogs_error("No TLV length - [%s] T:%d I:%d (vsz=%d)",
-                    desc->name, desc->type, desc->instance, desc->vsize);
-            return NULL;
-        }
-
-        if (parent_tlv) {
-            tlv = ogs_tlv_embed(parent_tlv, tlv_mode,
-                    desc->type, v->len, desc->instance, v->data);
-            if (!tlv) {
-                ogs_error("ogs_tlv_embed()");
-                return NULL;
-            }
-        } else {
-            tlv = ogs_tlv_add(tlv, tlv_mode,
-                    desc->type, v->len, desc->instance, v->data);
-            if (!tlv) {
-                ogs_error("ogs_tlv_add()");
-                return NULL;
-            }
-        }
+        ogs_assert(v->data);
+        memcpy(pos, v->data, v->len);
         break;
     }
     case OGS_TLV_NULL:
     case OGS_TV_NULL:
-    {
-        if (parent_tlv) {
-            tlv = ogs_tlv_embed(parent_tlv, tlv_mode,
-                    desc->type, 0, desc->instance, NULL);
-            if (!tlv) {
-                ogs_error("ogs_tlv_embed()");
-                return NULL;
-            }
-        } else {
-            tlv = ogs_tlv_add(tlv, tlv_mode,
-                    desc->type, 0, desc->instance, NULL);
-            if (!tlv) {
-                ogs_error("ogs_tlv_add()");
-                return NULL;
-            }
-        }
         break;
-    }
     default:
-        ogs_error("Unknown type [%d]", desc->ctype);
-        return NULL;
+        ogs_assert_if_reached();
+        break;
     }
-
-    return tlv;
 }
 
-static uint32_t tlv_add_compound(ogs_tlv_t **root, ogs_tlv_t *parent_tlv,
+/*
+ * Encode the IEs of a compound straight from the message structure.
+ *
+ * With 'buf' set to NULL, only the encoded length is computed, so a message
+ * is built by one sizing walk and one writing walk over the descriptors
+ * without any intermediate ogs_tlv_t nodes.
+ */
+static int tlv_encode_compound(uint8_t *buf, uint32_t *length,
         ogs_tlv_desc_t *parent_desc, void *msg, int depth, uint8_t mode)
 {
     ogs_tlv_presence_t *presence_p;
     ogs_tlv_desc_t *desc = NULL, *next_desc = NULL;
-    ogs_tlv_t *tlv = NULL, *emb_tlv = NULL;
     uint8_t *p = msg;
-    uint32_t offset = 0, count = 0;
-    int i, j, r;
+    uint32_t offset = 0, len = 0, count = 0;
+    int i, j, n, r;
     char indent[17] = "                "; /* 16 spaces */
 
-    ogs_assert(root);
+    ogs_assert(length);
     ogs_assert(parent_desc);
     ogs_assert(msg);
 
     ogs_assert(depth <= 8);
     indent[depth*2] = 0;
 
-    *root = NULL;
-
     for (i = 0, desc = parent_desc->child_descs[i]; desc != NULL;
             i++, desc = parent_desc->child_descs[i]) {
         next_desc = parent_desc->child_descs[i+1];
-        if (next_desc != NULL && next_desc->ctype == OGS_TLV_MORE) {
-            int offset2 = offset;
-            for (j = 0; j < next_desc->length; j++) {
-                presence_p = (ogs_tlv_presence_t *)(p + offset2);
+        if (next_desc != NULL && next_desc->ctype == OGS_TLV_MORE)
+            n = next_desc->length;
+        else
+            n = 1;
 
-                if (*presence_p == 0)
+        for (j = 0; j < n; j++) {
+            uint8_t *v = p + offset + desc->vsize * j;
+            uint8_t tlv_mode = tlv_ctype2mode(desc->ctype, mode);
+            uint32_t hlen = tlv_header_length(tlv_mode);
+            uint32_t vlen = 0;
+
+            presence_p = (ogs_tlv_presence_t *)v;
+            if (*presence_p == 0) {
+                if (n > 1)
                     break;
+                continue;
+            }
 
-                if (desc->ctype == OGS_TLV_COMPOUND) {
-                    ogs_trace("BUILD %sC#%d [%s] T:%d I:%d (vsz=%d) off:%p ",
-                            indent, i, desc->name, desc->type, desc->instance,
-                            desc->vsize, p + offset2);
-
-                    if (parent_tlv)
-                        tlv = ogs_tlv_embed(parent_tlv,
-                                tlv_ctype2mode(desc->ctype, mode),
-                                desc->type, 0, desc->instance, NULL);
-                    else
-                        tlv = ogs_tlv_add(tlv,
-                                tlv_ctype2mode(desc->ctype, mode),
-                                desc->type, 0, desc->instance, NULL);
-
-                    r = tlv_add_compound(&emb_tlv, tlv, desc,
-                            p + offset2 + sizeof(ogs_tlv_presence_t),
-                            depth + 1, mode);
-                    if (r <= 0 || !emb_tlv) {
-                        ogs_error("tlv_add_compound() failed");
-                        return 0;
-                    }
-                    count += 1 + r;
-                } else {
-                    ogs_trace("BUILD %sL#%d [%s] T:%d L:%d I:%d "
-                            "(cls:%d vsz:%d) off:%p ",
-                            indent, i, desc->name, desc->type, desc->length,
-                            desc->instance, desc->ctype, desc->vsize,
-                            p + offset2);
-
-                    tlv = tlv_add_leaf(parent_tlv, tlv, desc,
-                            p + offset2, mode);
-                    if (!tlv) {
-                        ogs_error("tlv_add_leaf() failed");
-                        return 0;
-                    }
-                    count++;
-                }
+            if (desc->ctype == OGS_TLV_COMPOUND) {
+                ogs_trace("BUILD %sC#%d [%s] T:%d I:%d (vsz=%d) off:%p ",
+                        indent, i, desc->name, desc->type, desc->instance,
+                        desc->vsize, v);
 
-                if (*root == NULL)
-                    *root = tlv;
+                r = tlv_encode_compound(buf ? buf + len + hlen : NULL, &vlen,
+                        desc, v + sizeof(ogs_tlv_presence_t), depth + 1, mode);
+                if (r != OGS_OK) {
+                    ogs_error("tlv_encode_compound() failed");
+                    return OGS_ERROR;
+                }
+            } else {
+                ogs_trace("BUILD %sL#%d [%s] T:%d L:%d I:%d "
+                        "(cls:%d vsz:%d) off:%p ",
+                        indent, i, desc->name, desc->type, desc->length,
+                        desc->instance, desc->ctype, desc->vsize, v);
+
+                r = tlv_leaf_length(desc, v);
+                if (r < 0) {
+                    ogs_error("tlv_leaf_length() failed");
+                    return OGS_ERROR;
+                }
+                vlen = r;
 
-                offset2 += desc->vsize;
+                if (buf)
+                    tlv_put_leaf(buf + len + hlen, desc, v);
             }
-            offset += desc->vsize * next_desc->length;
+
+            if (buf)
+                tlv_put_header(buf + len, tlv_mode,
+                        desc->type, vlen, desc->instance);
+
+            len += hlen + vlen;
+            count++;
+        }
+
+        if (n > 1) {
+            offset += desc->vsize * n;
             i++;
         } else {
-            presence_p = (ogs_tlv_presence_t *)(p + offset);
-
-            if (*presence_p) {
-                if (desc->ctype == OGS_TLV_COMPOUND) {
-                    ogs_trace("BUILD %sC#%d [%s] T:%d I:%d (vsz=%d) off:%p ",
-                            indent, i, desc->name, desc->type, desc->instance,
-                            desc->vsize, p + offset);
-
-                    if (parent_tlv)
-                        tlv = ogs_tlv_embed(parent_tlv,
-                                tlv_ctype2mode(desc->ctype, mode),
-                                desc->type, 0, desc->instance, NULL);
-                    else
-                        tlv = ogs_tlv_add(tlv,
-                                tlv_ctype2mode(desc->ctype, mode),
-                                desc->type, 0, desc->instance, NULL);
-
-                    r = tlv_add_compound(&emb_tlv, tlv, desc,
-                            p + offset + sizeof(ogs_tlv_presence_t),
-                            depth + 1, mode);
-                    if (r <= 0 || !emb_tlv) {
-                        ogs_error("tlv_add_compound() failed");
-                        return 0;
-                    }
-                    count += 1 + r;
-                } else {
-                    ogs_trace("BUILD %sL#%d [%s] T:%d L:%d I:%d "
-                            "(cls:%d vsz:%d) off:%p ",
-                            indent, i, desc->name, desc->type, desc->length,
-                            desc->instance, desc->ctype, desc->vsize,
-                            p + offset);
-
-                    tlv = tlv_add_leaf(parent_tlv, tlv, desc, p + offset, mode);
-                    if (!tlv) {
-                        ogs_error("tlv_add_leaf() failed");
-                        return 0;
-                    }
-                    count++;
-                }
-
-                if (*root == NULL)
-                    *root = tlv;
-            }
             offset += desc->vsize;
         }
     }
 
-    return count;
+    if (count == 0) {
+        ogs_error("No IE in [%s]", parent_desc->name);
+        return OGS_ERROR;
+    }
+
+    *length = len;
+
+    return OGS_OK;
 }
 
 ogs_pkbuf_t *ogs_tlv_build_msg(ogs_tlv_desc_t *desc, void *msg, int mode)
 {
-    ogs_tlv_t *root = NULL;
-    uint32_t r, length, rendlen;
+    int rv;
+    uint32_t length = 0, rendlen = 0;
     ogs_pkbuf_t *pkbuf = NULL;
 
     ogs_assert(desc);
@@ -419,16 +381,13 @@ ogs_pkbuf_t *ogs_tlv_build_msg(ogs_tlv_desc_t *desc, void *msg, int mode)
     ogs_assert(desc->ctype == OGS_TLV_MESSAGE);
 
     if (desc->child_descs[0]) {
-        r = tlv_add_compound(&root, NULL, desc, msg, 0, mode);
-        if (r <= 0 || !root) {
-            ogs_error("tlv_add_compound() failed");
+        rv = tlv_encode_compound(NULL, &length, desc, msg, 0, mode);
+        if (rv != OGS_OK) {
+            ogs_error("tlv_encode_compound() failed");
             return NULL;
         }
-
-        length = ogs_tlv_calc_length(root);
-    } else {
-        length = 0;
     }
+
     pkbuf = ogs_pkbuf_alloc(NULL, OGS_TLV_MAX_HEADROOM+length);
     if (!pkbuf) {
         ogs_error("ogs_pkbuf_alloc() failed");
@@ -438,37 +397,39 @@ ogs_pkbuf_t *ogs_tlv_build_msg(ogs_tlv_desc_t *desc, void *msg, int mode)
     ogs_pkbuf_put(pkbuf, length);
 
     if (desc->child_descs[0]) {
-        rendlen = ogs_tlv_render(root, pkbuf->data, length);
-        if (rendlen != length) {
-            ogs_error("ogs_tlv_render[rendlen:%d != length:%d] failed",
+        rv = tlv_encode_compound(pkbuf->data, &rendlen, desc, msg, 0, mode);
+        if (rv != OGS_OK || rendlen != length) {
+            ogs_error("tlv_encode_compound[rendlen:%d != length:%d] failed",
                     rendlen, length);
+            ogs_pkbuf_free(pkbuf);
             return NULL;
         }
-
-        ogs_tlv_free_all(root);
     }
 
     return pkbuf;
 }
 
-static ogs_tlv_desc_t* tlv_find_desc_by_type_inst(uint8_t *desc_index,
-        uint32_t *tlv_offset, ogs_tlv_desc_t *parent_desc, uint16_t match_type, uint8_t match_instance, uint8_t match_type_pos)
+/*
+ * Find the descriptor of an IE by <type,instance>. A message may list the
+ * same <type,instance> in several descriptors, which are filled in order;
+ * 'used' marks the single-occurrence descriptors that already got their IE.
+ */
+static ogs_tlv_desc_t *tlv_find_desc_by_type_inst(uint8_t *desc_index,
+        uint32_t *tlv_offset, ogs_tlv_desc_t *parent_desc, uint8_t *used,
+        uint16_t match_type, uint8_t match_instance)
 {
     ogs_tlv_desc_t *prev_desc = NULL, *desc = NULL;
     int i, offset = 0;
-    unsigned match_i = 0;
 
     ogs_assert(parent_desc);
 
     for (i = 0, desc = parent_desc->child_descs[i]; desc != NULL;
             i++, desc = parent_desc->child_descs[i]) {
-        if (desc->type == match_type && desc->instance == match_instance) {
-            if (match_i == match_type_pos) {
-                *desc_index = i;
-                *tlv_offset = offset;
-                break;
-            }
-            match_i++;
+        if (desc->type == match_type && desc->instance == match_instance &&
+            desc->ctype != OGS_TLV_MORE && (!used || !used[i])) {
+            *desc_index = i;
+            *tlv_offset = offset;
+            break;
         }
 
         if (desc->ctype == OGS_TLV_MORE) {
@@ -594,83 +555,109 @@ static int tlv_parse_leaf(void *msg, ogs_tlv_desc_t *desc, ogs_tlv_t *tlv)
     return OGS_OK;
 }
 
-/* rbtree structure used to keep track count of TLVs with given <type,instance>
- * while parsing. This is used to link it to the matching nth field in a
- * ogs_tlv_desc_t struct */
-typedef struct tlv_count_node_s {
-    ogs_rbnode_t node;
-    uint32_t key; /* type<<8 + instance */
-    unsigned count;
-} tlv_count_node_t;
-
-static tlv_count_node_t *tlv_count_node_find(ogs_rbtree_t *tree, tlv_count_node_t *count_node_arr, unsigned count_node_arr_len,
-        unsigned *count_alloc_next, uint16_t type, uint8_t instance)
+/*
+ * Read one IE header at 'pos' into a stack ogs_tlv_t. With 'desc' given,
+ * the header format (TV or TLV) is taken from the IE descriptor as GTPv1-C
+ * mixes both in one message. Returns the next position, or NULL if the IE
+ * does not fit into the block.
+ */
+static uint8_t *tlv_get_element_in_block(ogs_tlv_t *tlv,
+        uint8_t *pos, uint8_t *end, uint8_t msg_mode, ogs_tlv_desc_t *desc)
 {
-    ogs_rbnode_t **new = NULL;
-    ogs_rbnode_t *parent = NULL;
-    tlv_count_node_t *this;
-
-    uint64_t key = (((uint32_t)type)<<8) | instance;
-
-    new = &tree->root;
-    while (*new) {
-        this = ogs_rb_entry(*new, tlv_count_node_t, node);
-        parent = *new;
-        if (key < this->key) {
-            new = &(*new)->left;
-        } else if (key > this->key) {
-            new = &(*new)->right;
-        } else { /* found entry: */
-            return this;
+    uint8_t tlv_mode = msg_mode;
+    uint32_t fixed_length = 0;
+    uint8_t *next = NULL;
+
+    if (desc) {
+        uint16_t type;
+        uint8_t desc_index = 0;
+        uint32_t tlv_offset = 0;
+        ogs_tlv_desc_t *tlv_desc = NULL;
+
+        if (end - pos < (msg_mode == OGS_TLV_MODE_T2_L2 ? 2 : 1))
+            return NULL;
+
+        if (msg_mode == OGS_TLV_MODE_T2_L2)
+            type = (pos[0] << 8) | pos[1];
+        else
+            type = pos[0];
+
+        /* All tags with same instance should use the same tlv_desc,
+         * so take the first one */
+        tlv_desc = tlv_find_desc_by_type_inst(&desc_index, &tlv_offset,
+                desc, NULL, type, 0);
+        if (!tlv_desc) {
+            ogs_error("Can't parse find TLV description for type %u", type);
+            return NULL;
         }
+        tlv_mode = tlv_ctype2mode(tlv_desc->ctype, msg_mode);
+        fixed_length = tlv_desc->length;
     }
 
-    /* No entry, need to add one: */
-    if (*count_alloc_next == count_node_arr_len) {
-        ogs_error("This TLV has to many entries, can't parse");
+    if ((uint32_t)(end - pos) < tlv_header_length(tlv_mode))
         return NULL;
-    }
-    this = &count_node_arr[(*count_alloc_next)++];
-    this->key = key;
-    this->count = 0;
-    ogs_rbtree_link_node(&this->node, parent, new);
-    ogs_rbtree_insert_color(tree, &this->node);
-    return this;
+
+    memset(tlv, 0, sizeof(*tlv));
+    if (tlv_mode == OGS_TLV_MODE_T1)
+        next = tlv_get_element_fixed(tlv, pos, tlv_mode, fixed_length);
+    else
+        next = tlv_get_element(tlv, pos, tlv_mode);
+
+    if (next > end)
+        return NULL;
+
+    return next;
 }
 
+/*
+ * Decode the IEs of a block straight into the message structure. Headers
+ * are read in place, so no ogs_tlv_t node is allocated for any IE.
+ */
 static int tlv_parse_compound(void *msg, ogs_tlv_desc_t *parent_desc,
-        ogs_tlv_t *parent_tlv, int depth, int mode)
+        uint8_t *blk, uint32_t length, int depth, int mode,
+        ogs_tlv_desc_t *header_desc)
 {
     int rv;
     ogs_tlv_presence_t *presence_p = (ogs_tlv_presence_t *)msg;
     ogs_tlv_desc_t *desc = NULL, *next_desc = NULL;
-    ogs_tlv_t *tlv = NULL, *emb_tlv = NULL;
+    ogs_tlv_t tlv;
     uint8_t *p = msg;
+    uint8_t *pos = blk, *end = blk + length;
     uint32_t offset = 0;
     uint8_t index = 0;
+    uint8_t used[OGS_TLV_MAX_CHILD_DESC];
     int i = 0, j;
-    OGS_RBTREE(tree);
-    tlv_count_node_t count_node[OGS_TLV_MAX_CHILD_DESC];
-    unsigned count_node_alloc_next = 0;
     char indent[17] = "                "; /* 16 spaces */
 
     ogs_assert(msg);
     ogs_assert(parent_desc);
-    ogs_assert(parent_tlv);
+    ogs_assert(blk);
 
     ogs_assert(depth <= 8);
     indent[depth*2] = 0;
 
-    tlv = parent_tlv;
-    while (tlv) {
-        tlv_count_node_t *curr_count = tlv_count_node_find(&tree, &count_node[0],
-                OGS_ARRAY_SIZE(count_node), &count_node_alloc_next, tlv->type, tlv->instance);
-        if (!curr_count)
+    if (length == 0) {
+        ogs_error("No IE in [%s]", parent_desc->name);
+        return OGS_ERROR;
+    }
+
+    memset(used, 0, sizeof(used));
+
+    while (pos < end) {
+        uint8_t *next = tlv_get_element_in_block(
+                &tlv, pos, end, mode, header_desc);
+        if (!next) {
+            ogs_error("Can't parse TLV block[LEN:%d,MODE:%d] at %d",
+                    length, mode, (int)(pos - blk));
+            ogs_log_hexdump(OGS_LOG_ERROR, blk, length);
             return OGS_ERROR;
-        desc = tlv_find_desc_by_type_inst(&index, &offset, parent_desc, tlv->type, tlv->instance, curr_count->count);
+        }
+        pos = next;
+
+        desc = tlv_find_desc_by_type_inst(&index, &offset,
+                parent_desc, used, tlv.type, tlv.instance);
         if (desc == NULL) {
-            ogs_warn("Unknown TLV type [%d]", tlv->type);
-            tlv = tlv->next;
+            ogs_warn("Unknown TLV type [%d]", tlv.type);
             continue;
         }
 
@@ -689,28 +676,21 @@ static int tlv_parse_compound(void *msg, ogs_tlv_desc_t *parent_desc,
             }
             if (j == next_desc->length) {
                 ogs_fatal("Multiple of the same type TLV need more room");
-                tlv = tlv->next;
                 continue;
             }
         } else {
-            curr_count->count++;
+            used[index] = 1;
         }
 
         if (desc->ctype == OGS_TLV_COMPOUND) {
-            emb_tlv = ogs_tlv_parse_embedded_block(tlv, mode);
-            if (emb_tlv == NULL) {
-                ogs_error("Error while parse TLV");
-                return OGS_ERROR;
-            }
-
             ogs_trace("PARSE %sC#%d [%s] T:%d I:%d (vsz=%d) off:%p ",
                     indent, i++, desc->name, desc->type, desc->instance,
                     desc->vsize, p + offset);
 
             offset += sizeof(ogs_tlv_presence_t);
 
-            rv = tlv_parse_compound(
-                    p + offset, desc, emb_tlv, depth + 1, mode);
+            rv = tlv_parse_compound(p + offset, desc,
+                    tlv.value, tlv.length, depth + 1, mode, NULL);
             if (rv != OGS_OK) {
                 ogs_error("Can't parse compound TLV");
                 return OGS_ERROR;
@@ -723,7 +703,7 @@ static int tlv_parse_compound(void *msg, ogs_tlv_desc_t *parent_desc,
                     indent, i++, desc->name, desc->type, desc->length,
                     desc->instance, desc->ctype, desc->vsize, p + offset);
 
-            rv = tlv_parse_leaf(p + offset, desc, tlv);
+            rv = tlv_parse_leaf(p + offset, desc, &tlv);
             if (rv != OGS_OK) {
                 ogs_error("Can't parse leaf TLV");
                 return OGS_ERROR;
@@ -731,8 +711,6 @@ static int tlv_parse_compound(void *msg, ogs_tlv_desc_t *parent_desc,
 
             *presence_p = 1;
         }
-
-        tlv = tlv->next;
     }
 
     return OGS_OK;
@@ -741,9 +719,6 @@ static int tlv_parse_compound(void *msg, ogs_tlv_desc_t *parent_desc,
 int ogs_tlv_parse_msg(void *msg, ogs_tlv_desc_t *desc, ogs_pkbuf_t *pkbuf,
         int mode)
 {
-    int rv;
-    ogs_tlv_t *root;
-
     ogs_assert(msg);
     ogs_assert(desc);
     ogs_assert(pkbuf);
@@ -754,110 +729,8 @@ int ogs_tlv_parse_msg(void *msg, ogs_tlv_desc_t *desc, ogs_pkbuf_t *pkbuf,
         ogs_assert_if_reached();
     }
 
-    root = ogs_tlv_parse_block(pkbuf->len, pkbuf->data, mode);
-    if (root == NULL) {
-        ogs_error("Can't parse TLV message");
-        return OGS_ERROR;
-    }
-
-    rv = tlv_parse_compound(msg, desc, root, 0, mode);
-
-    ogs_tlv_free_all(root);
-
-    return rv;
-}
-
-static uint16_t parse_get_element_type(uint8_t *pos, uint8_t mode)
-{
-    uint16_t type;
-
-    switch(mode) {
-    case OGS_TLV_MODE_T1_L1:
-    case OGS_TLV_MODE_T1_L2:
-    case OGS_TLV_MODE_T1_L2_I1:
-    case OGS_TLV_MODE_T1:
-        type = *pos;
-        break;
-    case OGS_TLV_MODE_T2_L2:
-        type = *(pos++) << 8;
-        type += *(pos++);
-        break;
-    default:
-        ogs_assert_if_reached();
-        break;
-    }
-
-    return type;
-}
-
-/* Get TLV element taking into account msg_mode (to know TLV tag length) +
- * specific TLV information from "desc" (to know whether the specific IE is TLV
- * or TV, and its expected length in the later case). */
-static uint8_t *tlv_get_element_desc(ogs_tlv_t *tlv, uint8_t *blk, uint8_t msg_mode, ogs_tlv_desc_t *desc)
-{
-    uint8_t instance;
-    unsigned tlv_tag_pos;
-    uint8_t desc_index = 0;
-    uint32_t tlv_offset = 0;
-    uint16_t tlv_tag;
-    uint8_t tlv_mode;
-    static ogs_tlv_desc_t* tlv_desc;
-
-    tlv_tag = parse_get_element_type(blk, msg_mode);
-    instance = 0;  /* TODO: support instance != 0 if ever really needed by looking it up in pos */
-    tlv_tag_pos = 0; /* All tags with same instance should use the same tlv_desc, so take the first one */
-    tlv_desc = tlv_find_desc_by_type_inst(&desc_index, &tlv_offset, desc, tlv_tag, instance, tlv_tag_pos);
-    if (!tlv_desc) {
-        ogs_error("Can't parse find TLV description for type %u", tlv_tag);
-        return NULL;
-    }
-    tlv_mode = tlv_ctype2mode(tlv_desc->ctype, msg_mode);
-
-    if (tlv_mode == OGS_TLV_MODE_T1)
-        return tlv_get_element_fixed(tlv, blk, tlv_mode, tlv_desc->length);
-    return tlv_get_element(tlv, blk, tlv_mode);
-}
-
-/* Similar to ogs_tlv_parse_block(), but taking into account each TLV format from "desc". */
-static ogs_tlv_t *ogs_tlv_parse_block_desc(uint32_t length, void *data, uint8_t msg_mode, ogs_tlv_desc_t *desc)
-{
-    uint8_t *pos = data;
-    uint8_t *blk = data;
-
-    ogs_tlv_t *root = NULL;
-    ogs_tlv_t *prev = NULL;
-    ogs_tlv_t *curr = NULL;
-
-    root = curr = ogs_tlv_get();
-
-    ogs_assert(curr);
-
-    pos = tlv_get_element_desc(curr, pos, msg_mode, desc);
-
-    ogs_assert(pos);
-
-    while(pos - blk < length) {
-        prev = curr;
-
-        curr = ogs_tlv_get();
-        ogs_assert(curr);
-        prev->next = curr;
-
-        pos = tlv_get_element_desc(curr, pos, msg_mode, desc);
-        ogs_assert(pos);
-    }
-
-    if (length != (pos - blk)) {
-        ogs_error("ogs_tlv_parse_block() failed[LEN:%d,MODE:%d]",
-                length, msg_mode);
-        ogs_error("POS[%p] BLK[%p] POS-BLK[%d]", pos, blk, (int)(pos - blk));
-        ogs_log_hexdump(OGS_LOG_FATAL, data, length);
-
-        ogs_tlv_free_all(root);
-        return NULL;
-    }
-
-    return root;
+    return tlv_parse_compound(msg, desc, pkbuf->data, pkbuf->len, 0, mode,
+            NULL);
 }
 
 /* Similar to ogs_tlv_parse_msg(), but takes each TLV type from the desc
@@ -866,9 +739,6 @@ static ogs_tlv_t *ogs_tlv_parse_block_desc(uint32_t length, void *data, uint8_t
 int ogs_tlv_parse_msg_desc(
         void *msg, ogs_tlv_desc_t *desc, ogs_pkbuf_t *pkbuf, int msg_mode)
 {
-    int rv;
-    ogs_tlv_t *root;
-
     ogs_assert(msg);
     ogs_assert(desc);
     ogs_assert(pkbuf);
@@ -876,15 +746,6 @@ int ogs_tlv_parse_msg_desc(
     ogs_assert(desc->ctype == OGS_TLV_MESSAGE);
     ogs_assert(desc->child_descs[0]);
 
-    root = ogs_tlv_parse_block_desc(pkbuf->len, pkbuf->data, msg_mode, desc);
-    if (root == NULL) {
-        ogs_error("Can't parse TLV message");
-        return OGS_ERROR;
-    }
-
-    rv = tlv_parse_compound(msg, desc, root, 0, msg_mode);
-
-    ogs_tlv_free_all(root);
-
-    return rv;
+    return tlv_parse_compound(msg, desc, pkbuf->data, pkbuf->len, 0, msg_mode,
+            desc);
 }
@@ -24,6 +24,8 @@
 #define OGS_LOG_DOMAIN __ogs_tlv_domain
 
 static OGS_POOL(pool, ogs_tlv_t);
+/* Messages can be parsed outside the main loop (e.g. SMF PFCP workers) */
+static ogs_thread_mutex_t pool_mutex;
 
 /* ogs_tlv_t common functions */
 ogs_tlv_t *ogs_tlv_get(void)
@@ -31,7 +33,9 @@ ogs_tlv_t *ogs_tlv_get(void)
     ogs_tlv_t *tlv = NULL;
 
     /* get tlv node from node pool */
+    ogs_thread_mutex_lock(&pool_mutex);
     ogs_pool_alloc(&pool, &tlv);
+    ogs_thread_mutex_unlock(&pool_mutex);
 
     /* check for error */
     ogs_assert(tlv);
@@ -44,17 +48,21 @@ ogs_tlv_t *ogs_tlv_get(void)
 void ogs_tlv_free(ogs_tlv_t *tlv)
 {
     /* free tlv node to the node pool */
+    ogs_thread_mutex_lock(&pool_mutex);
     ogs_pool_free(&pool, tlv);
+    ogs_thread_mutex_unlock(&pool_mutex);
 }
 
 void ogs_tlv_init(void)
 {
+    ogs_thread_mutex_init(&pool_mutex);
     ogs_pool_init(&pool, ogs_core()->tlv.pool);
 }
 
 void ogs_tlv_final(void)
 {
     ogs_pool_final(&pool);
+    ogs_thread_mutex_destroy(&pool_mutex);
 }
 
 uint32_t ogs_tlv_pool_avail(void)
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-dbi.h"
+
+typedef struct ogs_dbi_async_s {
+    ogs_dbi_async_func_f func;
+    ogs_dbi_async_cb_f cb;
+    void *data;
+
+    int status;
+} ogs_dbi_async_t;
+
+static struct {
+    int num_of_thread;
+    ogs_thread_t **thread;
+
+    ogs_queue_t *queue;
+} worker;
+
+static void worker_main(void *data);
+
+int ogs_dbi_async_init(int num_of_thread)
+{
+    int i;
+
+    ogs_assert(num_of_thread > 0);
+    ogs_assert(worker.num_of_thread == 0);
+
+    worker.queue = ogs_queue_create(ogs_app()->pool.event);
+    ogs_assert(worker.queue);
+
+    worker.thread = ogs_calloc(num_of_thread, sizeof(ogs_thread_t *));
+    ogs_assert(worker.thread);
+
+    /*
+     * All workers pop the requests from the same queue.
+     * Concurrent lookups overlap up to the number of threads.
+     */
+    for (i = 0; i < num_of_thread; i++) {
+        worker.thread[i] = ogs_thread_create(worker_main, NULL);
+        if (!worker.thread[i]) {
+            ogs_error("ogs_thread_create() failed");
+            worker.num_of_thread = i;
+            ogs_dbi_async_final();
+            return OGS_ERROR;
+        }
+    }
+
+    worker.num_of_thread = num_of_thread;
+
+    ogs_info("DBI worker thread [%d]", worker.num_of_thread);
+
+    return OGS_OK;
+}
+
+void ogs_dbi_async_final(void)
+{
+    int i, rv;
+
+    if (!worker.queue)
+        return;
+
+    /*
+     * The NF main loop has already exited, so nothing is queued anymore.
+     * The pending requests are dropped before the queue is terminated,
+     * since ogs_queue_trypop() returns OGS_DONE after ogs_queue_term().
+     * 'cb' is called with OGS_DONE to release 'data' only.
+     */
+    for ( ;; ) {
+        ogs_dbi_async_t *async = NULL;
+
+        rv = ogs_queue_trypop(worker.queue, (void**)&async);
+        if (rv != OGS_OK)
+            break;
+
+        ogs_assert(async);
+        ogs_assert(async->cb);
+        async->cb(OGS_DONE, async->data);
+
+        ogs_free(async);
+    }
+
+    ogs_queue_term(worker.queue);
+
+    for (i = 0; i < worker.num_of_thread; i++)
+        ogs_thread_destroy(worker.thread[i]);
+
+    ogs_queue_destroy(worker.queue);
+    ogs_free(worker.thread);
+
+    memset(&worker, 0, sizeof(worker));
+}
+
+int ogs_dbi_async_call(
+        ogs_dbi_async_func_f func, ogs_dbi_async_cb_f cb, void *data)
+{
+    int rv;
+    ogs_dbi_async_t *async = NULL;
+
+    ogs_assert(func);
+    ogs_assert(cb);
+
+    if (!worker.num_of_thread) {
+        cb(func(data), data);
+        return OGS_OK;
+    }
+
+    async = ogs_calloc(1, sizeof(*async));
+    if (!async) {
+        ogs_error("ogs_calloc() failed");
+        return OGS_ERROR;
+    }
+
+    async->func = func;
+    async->cb = cb;
+    async->data = data;
+
+    rv = ogs_queue_trypush(worker.queue, async);
+    if (rv != OGS_OK) {
+        ogs_error("ogs_queue_trypush() failed:%d", (int)rv);
+        ogs_free(async);
+        return OGS_ERROR;
+    }
+
+    return OGS_OK;
+}
+
+void ogs_dbi_async_complete(void *data)
+{
+    ogs_dbi_async_t *async = data;
+
+    ogs_assert(async);
+    ogs_assert(async->cb);
+
+    async->cb(async->status, async->data);
+
+    ogs_free(async);
+}
+
+static void worker_main(void *data)
+{
+    int rv;
+
+    for ( ;; ) {
+        ogs_dbi_async_t *async = NULL;
+        ogs_event_t *e = NULL;
+
+        rv = ogs_queue_pop(worker.queue, (void**)&async);
+        if (rv == OGS_DONE)
+            break;
+
+        if (rv != OGS_OK)
+            continue;
+
+        ogs_assert(async);
+        ogs_assert(async->func);
+
+        async->status = async->func(async->data);
+
+        e = ogs_event_new(OGS_EVENT_DBI_ASYNC);
+        ogs_assert(e);
+        e->dbi.async = async;
+        rv = ogs_queue_push(ogs_app()->queue, e);
+        if (rv != OGS_OK) {
+            ogs_error("ogs_queue_push() failed:%d", (int)rv);
+            ogs_free(async);
+            ogs_event_free(e);
+        } else {
+            ogs_pollset_notify(ogs_app()->pollset);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined(OGS_DBI_INSIDE) && !defined(OGS_DBI_COMPILATION)
+#error "This header cannot be included directly."
+#endif
+
+#ifndef OGS_DBI_ASYNC_H
+#define OGS_DBI_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Asynchronous DBI
+ *
+ * 'func' is called in one of the DBI worker threads. It must touch only
+ * 'data' and the DBI API, which takes a client from the pool
+ * and is safe to call from several threads at the same time.
+ *
+ * When 'func' returns, OGS_EVENT_DBI_ASYNC is posted to the NF queue.
+ * The NF state machine passes 'e->dbi.async' to ogs_dbi_async_complete(),
+ * which calls 'cb' with the return value of 'func' in the NF main loop.
+ *
+ * If no worker thread is configured, 'func' and 'cb' are called
+ * directly from ogs_dbi_async_call().
+ *
+ * The requests still pending at ogs_dbi_async_final() are not run.
+ * Their 'cb' is called with OGS_DONE, and must only release 'data'.
+ */
+typedef int (*ogs_dbi_async_func_f)(void *data);
+typedef void (*ogs_dbi_async_cb_f)(int status, void *data);
+
+int ogs_dbi_async_init(int num_of_thread);
+void ogs_dbi_async_final(void);
+
+int ogs_dbi_async_call(
+        ogs_dbi_async_func_f func, ogs_dbi_async_cb_f cb, void *data);
+void ogs_dbi_async_complete(void *async);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OGS_DBI_ASYNC_H */
@@ -0,0 +1,645 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-dbi.h"
+
+typedef struct cache_entry_s {
+    ogs_lnode_t lnode;          /* LRU list: the head is the oldest */
+
+    char *supi;
+
+    bool auth_info_valid;
+    ogs_dbi_auth_info_t auth_info;
+
+    /* Last SQNs written by this process, to spot their change events */
+#define CACHE_SQN_HISTORY 8
+    uint64_t sqn_written[CACHE_SQN_HISTORY];
+    unsigned int num_of_sqn_written;
+
+    bool subscription_data_valid;
+    ogs_subscription_data_t subscription_data;
+} cache_entry_t;
+
+static struct {
+    bool enabled;
+
+    ogs_thread_mutex_t mutex;
+
+    ogs_list_t lru_list;
+    ogs_hash_t *hash;           /* SUPI -> cache_entry_t */
+
+    /*
+     * Increased whenever the entry is changed or removed.
+     *
+     * The value read before the DB query is passed to the setter,
+     * so that the result of the query which has raced with the update
+     * is not cached. The version is kept per bucket of SUPI,
+     * so the update of one subscriber does not reject the others.
+     */
+#define CACHE_VERSION_BUCKETS 1024
+    uint64_t version[CACHE_VERSION_BUCKETS];
+
+    struct {
+        uint64_t hit;
+        uint64_t miss;
+    } stats;
+} self;
+
+static OGS_POOL(cache_pool, cache_entry_t);
+
+static uint64_t *version_bucket(char *supi);
+static void sqn_written_add(cache_entry_t *entry, uint64_t sqn);
+static bool sqn_written_find(cache_entry_t *entry, uint64_t sqn);
+
+static cache_entry_t *entry_find(char *supi);
+static cache_entry_t *entry_add(char *supi);
+static void entry_remove(cache_entry_t *entry);
+static void entry_clear_subscription_data(cache_entry_t *entry);
+static void subscription_data_copy(
+        ogs_subscription_data_t *dst, ogs_subscription_data_t *src);
+
+int ogs_dbi_cache_init(int capacity)
+{
+    ogs_assert(capacity > 0);
+    ogs_assert(self.enabled == false);
+
+    memset(&self, 0, sizeof(self));
+
+    ogs_pool_init(&cache_pool, capacity);
+    ogs_list_init(&self.lru_list);
+    self.hash = ogs_hash_make();
+    ogs_assert(self.hash);
+
+    ogs_thread_mutex_init(&self.mutex);
+
+    self.enabled = true;
+
+    ogs_info("Subscriber cache [%d]", capacity);
+
+    return OGS_OK;
+}
+
+void ogs_dbi_cache_final(void)
+{
+    if (self.enabled == false)
+        return;
+
+    ogs_info("Subscriber cache [hit:%llu, miss:%llu]",
+            (unsigned long long)self.stats.hit,
+            (unsigned long long)self.stats.miss);
+
+    ogs_dbi_cache_remove_all();
+
+    ogs_hash_destroy(self.hash);
+    ogs_pool_final(&cache_pool);
+
+    ogs_thread_mutex_destroy(&self.mutex);
+
+    self.enabled = false;
+}
+
+bool ogs_dbi_cache_is_enabled(void)
+{
+    return self.enabled;
+}
+
+uint64_t ogs_dbi_cache_version(char *supi)
+{
+    uint64_t version;
+
+    ogs_assert(supi);
+
+    if (self.enabled == false)
+        return 0;
+
+    ogs_thread_mutex_lock(&self.mutex);
+    version = *version_bucket(supi);
+    ogs_thread_mutex_unlock(&self.mutex);
+
+    return version;
+}
+
+bool ogs_dbi_cache_get_auth_info(char *supi, ogs_dbi_auth_info_t *auth_info)
+{
+    cache_entry_t *entry = NULL;
+    bool found = false;
+
+    ogs_assert(supi);
+    ogs_assert(auth_info);
+
+    if (self.enabled == false)
+        return false;
+
+    ogs_thread_mutex_lock(&self.mutex);
+
+    entry = entry_find(supi);
+    if (entry && entry->auth_info_valid) {
+        memcpy(auth_info, &entry->auth_info, sizeof(*auth_info));
+        found = true;
+        self.stats.hit++;
+    } else {
+        self.stats.miss++;
+    }
+
+    ogs_thread_mutex_unlock(&self.mutex);
+
+    return found;
+}
+
+void ogs_dbi_cache_set_auth_info(
+        char *supi, ogs_dbi_auth_info_t *auth_info, uint64_t version)
+{
+    cache_entry_t *entry = NULL;
+
+    ogs_assert(supi);
+    ogs_assert(auth_info);
+
+    if (self.enabled == false)
+        return;
+
+    ogs_thread_mutex_lock(&self.mutex);
+
+    if (version == *version_bucket(supi)) {
+        entry = entry_find(supi);
+        if (!entry)
+            entry = entry_add(supi);
+
+        memcpy(&entry->auth_info, auth_info, sizeof(*auth_info));
+        entry->auth_info_valid = true;
+    }
+
+    ogs_thread_mutex_unlock(&self.mutex);
+}
+
+bool ogs_dbi_cache_get_subscription_data(
+        char *supi, ogs_subscription_data_t *subscription_data)
+{
+    cache_entry_t *entry = NULL;
+    bool found = false;
+
+    ogs_assert(supi);
+    ogs_assert(subscription_data);
+
+    if (self.enabled == false)
+        return false;
+
+    ogs_thread_mutex_lock(&self.mutex);
+
+    entry = entry_find(supi);
+    if (entry && entry->subscription_data_valid) {
+        subscription_data_copy(subscription_data, &entry->subscription_data);
+        found = true;
+        self.stats.hit++;
+    } else {
+        self.stats.miss++;
+    }
+
+    ogs_thread_mutex_unlock(&self.mutex);
+
+    return found;
+}
+
+void ogs_dbi_cache_set_subscription_data(
+        char *supi, ogs_subscription_data_t *subscription_data,
+        uint64_t version)
+{
+    cache_entry_t *entry = NULL;
+
+    ogs_assert(supi);
+    ogs_assert(subscription_data);
+
+    if (self.enabled == false)
+        return;
+
+    ogs_thread_mutex_lock(&self.mutex);
+
+    if (version == *version_bucket(supi)) {
+        entry = entry_find(supi);
+        if (!entry)
+            entry = entry_add(supi);
+
+        entry_clear_subscription_data(entry);
+        subscription_data_copy(&entry->subscription_data, subscription_data);
+        entry->subscription_data_valid = true;
+    }
+
+    ogs_thread_mutex_unlock(&self.mutex);
+}
+
+void ogs_dbi_cache_update_sqn(char *supi, uint64_t sqn)
+{
+    cache_entry_t *entry = NULL;
+
+    ogs_assert(supi);
+
+    if (self.enabled == false)
+        return;
+
+    ogs_thread_mutex_lock(&self.mutex);
+
+    (*version_bucket(supi))++;
+
+    entry = entry_find(supi);
+    if (entry) {
+        entry->auth_info.sqn = sqn & OGS_MAX_SQN;
+        sqn_written_add(entry, entry->auth_info.sqn);
+    }
+
+    ogs_thread_mutex_unlock(&self.mutex);
+}
+
+/*
+ * The SQN is not ordered: it wraps around at OGS_MAX_SQN,
+ * and the resynchronization may set it to a lower value.
+ * Only the SQN written by this process is known to be older,
+ * otherwise the cached SQN is dropped and read again from the DB.
+ */
+static void cache_change_sqn(char *supi, uint64_t sqn)
+{
+    cache_entry_t *entry = NULL;
+
+    ogs_assert(supi);
+
+    if (self.enabled == false)
+        return;
+
+    sqn &= OGS_MAX_SQN;
+
+    ogs_thread_mutex_lock(&self.mutex);
+
+    entry = entry_find(supi);
+    if (entry && entry->auth_info_valid &&
+        sqn != entry->auth_info.sqn &&
+        sqn_written_find(entry, sqn) == false) {
+        (*version_bucket(supi))++;
+        entry->auth_info_valid = false;
+    }
+
+    ogs_thread_mutex_unlock(&self.mutex);
+}
+
+void ogs_dbi_cache_increment_sqn(char *supi)
+{
+    cache_entry_t *entry = NULL;
+
+    ogs_assert(supi);
+
+    if (self.enabled == false)
+        return;
+
+    ogs_thread_mutex_lock(&self.mutex);
+
+    (*version_bucket(supi))++;
+
+    /* Same as ogs_dbi_increment_sqn(): ($inc 32) and ($bit and OGS_MAX_SQN) */
+    entry = entry_find(supi);
+    if (entry) {
+        entry->auth_info.sqn = (entry->auth_info.sqn + 32) & OGS_MAX_SQN;
+        sqn_written_add(entry, entry->auth_info.sqn);
+    }
+
+    ogs_thread_mutex_unlock(&self.mutex);
+}
+
+/* The DB has changed under the cached entry, e.g. by the SQN journal */
+void ogs_dbi_cache_touch(char *supi)
+{
+    ogs_assert(supi);
+
+    if (self.enabled == false)
+        return;
+
+    ogs_thread_mutex_lock(&self.mutex);
+    (*version_bucket(supi))++;
+    ogs_thread_mutex_unlock(&self.mutex);
+}
+
+void ogs_dbi_cache_remove(char *supi)
+{
+    cache_entry_t *entry = NULL;
+
+    ogs_assert(supi);
+
+    if (self.enabled == false)
+        return;
+
+    ogs_thread_mutex_lock(&self.mutex);
+
+    (*version_bucket(supi))++;
+
+    entry = entry_find(supi);
+    if (entry)
+        entry_remove(entry);
+
+    ogs_thread_mutex_unlock(&self.mutex);
+}
+
+void ogs_dbi_cache_remove_all(void)
+{
+    cache_entry_t *entry = NULL, *next_entry = NULL;
+    int i;
+
+    if (self.enabled == false)
+        return;
+
+    ogs_thread_mutex_lock(&self.mutex);
+
+    for (i = 0; i < CACHE_VERSION_BUCKETS; i++)
+        self.version[i]++;
+
+    ogs_list_for_each_safe(&self.lru_list, next_entry, entry)
+        entry_remove(entry);
+
+    ogs_thread_mutex_unlock(&self.mutex);
+}
+
+void ogs_dbi_cache_process_change_stream(const bson_t *document)
+{
+    bson_iter_t iter, child1_iter, child2_iter;
+
+    char *utf8 = NULL;
+    uint32_t length = 0;
+
+    char *imsi_bcd = NULL;
+    char *supi = NULL;
+
+    bool sqn_only = false;
+    bool sqn_present = false;
+    uint64_t sqn = 0;
+
+    ogs_assert(document);
+
+    if (self.enabled == false)
+        return;
+
+    if (bson_iter_init_find(&iter, document, "fullDocument") &&
+        BSON_ITER_HOLDS_DOCUMENT(&iter)) {
+        bson_iter_recurse(&iter, &child1_iter);
+        while (bson_iter_next(&child1_iter)) {
+            const char *key = bson_iter_key(&child1_iter);
+            if (!strcmp(key, "imsi") &&
+                    BSON_ITER_HOLDS_UTF8(&child1_iter)) {
+                utf8 = (char *)bson_iter_utf8(&child1_iter, &length);
+                imsi_bcd = ogs_strndup(utf8,
+                    ogs_min(length, OGS_MAX_IMSI_BCD_LEN) + 1);
+                ogs_assert(imsi_bcd);
+            }
+        }
+    }
+
+    /* Deleted or unknown subscriber: the SUPI cannot be known */
+    if (!imsi_bcd) {
+        ogs_dbi_cache_remove_all();
+        return;
+    }
+
+    supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
+    ogs_assert(supi);
+
+    if (bson_iter_init_find(&iter, document, "updateDescription") &&
+        BSON_ITER_HOLDS_DOCUMENT(&iter)) {
+        bson_iter_recurse(&iter, &child1_iter);
+        while (bson_iter_next(&child1_iter)) {
+            const char *key = bson_iter_key(&child1_iter);
+            if (!strcmp(key, "updatedFields") &&
+                    BSON_ITER_HOLDS_DOCUMENT(&child1_iter)) {
+                sqn_only = true;
+                bson_iter_recurse(&child1_iter, &child2_iter);
+                while (bson_iter_next(&child2_iter)) {
+                    const char *child2_key = bson_iter_key(&child2_iter);
+                    if (!strcmp(child2_key, "security.sqn") &&
+                            BSON_ITER_HOLDS_INT64(&child2_iter)) {
+                        sqn = bson_iter_int64(&child2_iter);
+                        sqn_present = true;
+                    } else if (!strcmp(child2_key, "imeisv")) {
+                        /* Not cached */
+                    } else {
+                        sqn_only = false;
+                    }
+                }
+            } else if (!strcmp(key, "removedFields") &&
+                    BSON_ITER_HOLDS_ARRAY(&child1_iter)) {
+                bson_iter_recurse(&child1_iter, &child2_iter);
+                if (bson_iter_next(&child2_iter))
+                    sqn_only = false;
+            }
+        }
+    }
+
+    /*
+     * The cache is written through on every SQN update of this process,
+     * so an SQN-only event is usually our own older write coming back.
+     * Any other SQN, e.g. from another HSS/UDR, drops the cached one.
+     * With the SQN journal, the cache is always ahead of the DB.
+     */
+    if (sqn_only == false)
+        ogs_dbi_cache_remove(supi);
+    else if (sqn_present == true &&
+            ogs_dbi_sqn_journal_is_enabled() == false)
+        cache_change_sqn(supi, sqn);
+
+    ogs_free(supi);
+    ogs_free(imsi_bcd);
+}
+
+static uint64_t *version_bucket(char *supi)
+{
+    int klen = strlen(supi);
+
+    return &self.version[
+        ogs_hashfunc_default(supi, &klen) % CACHE_VERSION_BUCKETS];
+}
+
+static void sqn_written_add(cache_entry_t *entry, uint64_t sqn)
+{
+    ogs_assert(entry);
+
+    entry->sqn_written[
+        entry->num_of_sqn_written++ % CACHE_SQN_HISTORY] = sqn;
+}
+
+static bool sqn_written_find(cache_entry_t *entry, uint64_t sqn)
+{
+    unsigned int i, n;
+
+    ogs_assert(entry);
+
+    n = ogs_min(entry->num_of_sqn_written, CACHE_SQN_HISTORY);
+    for (i = 0; i < n; i++)
+        if (entry->sqn_written[i] == sqn)
+            return true;
+
+    return false;
+}
+
+static cache_entry_t *entry_find(char *supi)
+{
+    cache_entry_t *entry = NULL;
+
+    ogs_assert(supi);
+
+    entry = ogs_hash_get(self.hash, supi, strlen(supi));
+    if (entry) {
+        /* Most recently used */
+        ogs_list_remove(&self.lru_list, entry);
+        ogs_list_add(&self.lru_list, entry);
+    }
+
+    return entry;
+}
+
+static cache_entry_t *entry_add(char *supi)
+{
+    cache_entry_t *entry = NULL;
+
+    ogs_assert(supi);
+
+    ogs_pool_alloc(&cache_pool, &entry);
+    if (!entry) {
+        /* Evict the least recently used */
+        entry = ogs_list_first(&self.lru_list);
+        ogs_assert(entry);
+        entry_remove(entry);
+
+        ogs_pool_alloc(&cache_pool, &entry);
+        ogs_assert(entry);
+    }
+    memset(entry, 0, sizeof(*entry));
+
+    entry->supi = ogs_strdup(supi);
+    ogs_assert(entry->supi);
+
+    ogs_hash_set(self.hash, entry->supi, strlen(entry->supi), entry);
+    ogs_list_add(&self.lru_list, entry);
+
+    return entry;
+}
+
+static void entry_remove(cache_entry_t *entry)
+{
+    ogs_assert(entry);
+
+    ogs_list_remove(&self.lru_list, entry);
+    ogs_hash_set(self.hash, entry->supi, strlen(entry->supi), NULL);
+
+    entry_clear_subscription_data(entry);
+
+    ogs_free(entry->supi);
+    ogs_pool_free(&cache_pool, entry);
+}
+
+static void framed_routes_free(char **routes)
+{
+    int i;
+
+    if (!routes)
+        return;
+
+    for (i = 0; i < OGS_MAX_NUM_OF_FRAMED_ROUTES_IN_PDI; i++) {
+        if (!routes[i])
+            break;
+        ogs_free(routes[i]);
+    }
+    ogs_free(routes);
+}
+
+static char **framed_routes_copy(char **routes)
+{
+    char **copy = NULL;
+    int i;
+
+    if (!routes)
+        return NULL;
+
+    copy = ogs_calloc(OGS_MAX_NUM_OF_FRAMED_ROUTES_IN_PDI, sizeof(copy[0]));
+    ogs_assert(copy);
+
+    for (i = 0; i < OGS_MAX_NUM_OF_FRAMED_ROUTES_IN_PDI; i++) {
+        if (!routes[i])
+            break;
+        copy[i] = ogs_strdup(routes[i]);
+        ogs_assert(copy[i]);
+    }
+
+    return copy;
+}
+
+static void entry_clear_subscription_data(cache_entry_t *entry)
+{
+    ogs_subscription_data_t *subscription_data = NULL;
+    int i, j;
+
+    ogs_assert(entry);
+
+    if (entry->subscription_data_valid == false)
+        return;
+
+    subscription_data = &entry->subscription_data;
+
+    for (i = 0; i < subscription_data->num_of_slice; i++) {
+        ogs_slice_data_t *slice_data = &subscription_data->slice[i];
+
+        for (j = 0; j < slice_data->num_of_session; j++) {
+            framed_routes_free(slice_data->session[j].ipv4_framed_routes);
+            framed_routes_free(slice_data->session[j].ipv6_framed_routes);
+        }
+    }
+
+    ogs_subscription_data_free(subscription_data);
+
+    entry->subscription_data_valid = false;
+}
+
+static void subscription_data_copy(
+        ogs_subscription_data_t *dst, ogs_subscription_data_t *src)
+{
+    int i, j;
+
+    ogs_assert(dst);
+    ogs_assert(src);
+
+    memcpy(dst, src, sizeof(*dst));
+
+    if (src->imsi) {
+        dst->imsi = ogs_strdup(src->imsi);
+        ogs_assert(dst->imsi);
+    }
+    if (src->mme_host) {
+        dst->mme_host = ogs_strdup(src->mme_host);
+        ogs_assert(dst->mme_host);
+    }
+    if (src->mme_realm) {
+        dst->mme_realm = ogs_strdup(src->mme_realm);
+        ogs_assert(dst->mme_realm);
+    }
+
+    for (i = 0; i < src->num_of_slice; i++) {
+        for (j = 0; j < src->slice[i].num_of_session; j++) {
+            ogs_session_t *s = &src->slice[i].session[j];
+            ogs_session_t *d = &dst->slice[i].session[j];
+
+            if (s->name) {
+                d->name = ogs_strdup(s->name);
+                ogs_assert(d->name);
+            }
+            d->ipv4_framed_routes = framed_routes_copy(s->ipv4_framed_routes);
+            d->ipv6_framed_routes = framed_routes_copy(s->ipv6_framed_routes);
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined(OGS_DBI_INSIDE) && !defined(OGS_DBI_COMPILATION)
+#error "This header cannot be included directly."
+#endif
+
+#ifndef OGS_DBI_CACHE_H
+#define OGS_DBI_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Subscriber Cache
+ *
+ * Decoded 'ogs_dbi_auth_info_t' and 'ogs_subscription_data_t' are kept
+ * in the LRU cache, so the repeated lookup is served without
+ * the round trip to the DB.
+ *
+ * The cache is enabled only while the change stream is watched.
+ * Every change to the subscriber invalidates the entry
+ * except for the SQN, which is updated in place(write-through).
+ */
+int ogs_dbi_cache_init(int capacity);
+void ogs_dbi_cache_final(void);
+bool ogs_dbi_cache_is_enabled(void);
+
+uint64_t ogs_dbi_cache_version(char *supi);
+
+bool ogs_dbi_cache_get_auth_info(char *supi, ogs_dbi_auth_info_t *auth_info);
+void ogs_dbi_cache_set_auth_info(
+        char *supi, ogs_dbi_auth_info_t *auth_info, uint64_t version);
+
+bool ogs_dbi_cache_get_subscription_data(
+        char *supi, ogs_subscription_data_t *subscription_data);
+void ogs_dbi_cache_set_subscription_data(
+        char *supi, ogs_subscription_data_t *subscription_data,
+        uint64_t version);
+
+void ogs_dbi_cache_update_sqn(char *supi, uint64_t sqn);
+void ogs_dbi_cache_increment_sqn(char *supi);
+
+void ogs_dbi_cache_touch(char *supi);
+void ogs_dbi_cache_remove(char *supi);
+void ogs_dbi_cache_remove_all(void);
+
+void ogs_dbi_cache_process_change_stream(const bson_t *document);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OGS_DBI_CACHE_H */
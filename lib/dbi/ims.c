@@ -23,6 +23,8 @@ int ogs_dbi_msisdn_data(
         char *imsi_or_msisdn_bcd, ogs_msisdn_data_t *msisdn_data)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *collection = NULL;
     mongoc_cursor_t *cursor = NULL;
     bson_t *query = NULL;
     bson_error_t error;
@@ -47,11 +49,18 @@ int ogs_dbi_msisdn_data(
                 "{", "imsi", BCON_UTF8(imsi_or_msisdn_bcd), "}",
                 "{", "msisdn", BCON_UTF8(imsi_or_msisdn_bcd), "}",
             "]");
+
+    client = ogs_mongoc_client_pop();
+    ogs_assert(client);
+    collection = mongoc_client_get_collection(
+            client, ogs_mongoc()->name, "subscribers");
+    ogs_assert(collection);
+
 #if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 5
     cursor = mongoc_collection_find_with_opts(
-            ogs_mongoc()->collection.subscriber, query, NULL, NULL);
+            collection, query, NULL, NULL);
 #else
-    cursor = mongoc_collection_find(ogs_mongoc()->collection.subscriber,
+    cursor = mongoc_collection_find(collection,
             MONGOC_QUERY_NONE, 0, 0, 0, query, NULL, NULL);
 #endif
 
@@ -114,12 +123,17 @@ out:
     if (query) bson_destroy(query);
     if (cursor) mongoc_cursor_destroy(cursor);
 
+    mongoc_collection_destroy(collection);
+    ogs_mongoc_client_push(client);
+
     return rv;
 }
 
 int ogs_dbi_ims_data(char *supi, ogs_ims_data_t *ims_data)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *collection = NULL;
     mongoc_cursor_t *cursor = NULL;
     bson_t *query = NULL;
     bson_error_t error;
@@ -148,11 +162,18 @@ int ogs_dbi_ims_data(char *supi, ogs_ims_data_t *ims_data)
     ogs_assert(supi_id);
 
     query = BCON_NEW(supi_type, BCON_UTF8(supi_id));
+
+    client = ogs_mongoc_client_pop();
+    ogs_assert(client);
+    collection = mongoc_client_get_collection(
+            client, ogs_mongoc()->name, "subscribers");
+    ogs_assert(collection);
+
 #if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 5
     cursor = mongoc_collection_find_with_opts(
-            ogs_mongoc()->collection.subscriber, query, NULL, NULL);
+            collection, query, NULL, NULL);
 #else
-    cursor = mongoc_collection_find(ogs_mongoc()->collection.subscriber,
+    cursor = mongoc_collection_find(collection,
             MONGOC_QUERY_NONE, 0, 0, 0, query, NULL, NULL);
 #endif
 
@@ -210,5 +231,8 @@ out:
     ogs_free(supi_type);
     ogs_free(supi_id);
 
+    mongoc_collection_destroy(collection);
+    ogs_mongoc_client_push(client);
+
     return rv;
 }
@@ -0,0 +1,502 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+
+#include "ogs-dbi.h"
+
+typedef struct journal_entry_s {
+    char *supi;
+    uint64_t sqn;
+} journal_entry_t;
+
+static struct {
+    bool enabled;
+
+    ogs_time_t interval;
+    const char *file;
+    FILE *fp;
+
+    ogs_thread_t *thread;
+    ogs_thread_mutex_t mutex;
+    ogs_thread_cond_t cond;
+    bool terminated;
+
+    ogs_hash_t *pending;        /* SUPI -> journal_entry_t, not yet flushed */
+    ogs_hash_t *flushing;       /* SUPI -> journal_entry_t, being flushed */
+
+    uint64_t generation;        /* Increased when the flush has completed */
+} self;
+
+static void journal_main(void *data);
+
+static journal_entry_t *entry_set(ogs_hash_t *hash, char *supi, uint64_t sqn);
+static void entry_remove_all(ogs_hash_t *hash);
+
+static void log_append(journal_entry_t *entry);
+static void log_rewrite(void);
+static void log_replay(void);
+
+static int bulk_write(ogs_hash_t *hash);
+
+int ogs_dbi_sqn_journal_init(ogs_time_t interval, const char *file)
+{
+    ogs_assert(interval > 0);
+    ogs_assert(self.enabled == false);
+
+    memset(&self, 0, sizeof(self));
+
+    self.interval = interval;
+    self.file = file;
+
+    self.pending = ogs_hash_make();
+    ogs_assert(self.pending);
+
+    ogs_thread_mutex_init(&self.mutex);
+    ogs_thread_cond_init(&self.cond);
+
+    if (self.file) {
+        /* SQN which had not been flushed before the last shutdown */
+        log_replay();
+
+        self.fp = fopen(self.file, "a");
+        if (!self.fp) {
+            ogs_error("Cannot open SQN journal file [%s]", self.file);
+            goto error;
+        }
+    }
+
+    self.enabled = true;
+
+    if (ogs_hash_count(self.pending)) {
+        ogs_info("Replay SQN journal [%d]", ogs_hash_count(self.pending));
+        ogs_dbi_sqn_journal_flush();
+    }
+
+    self.thread = ogs_thread_create(journal_main, NULL);
+    if (!self.thread) {
+        ogs_error("ogs_thread_create() failed");
+        goto error;
+    }
+
+    ogs_info("SQN journal [interval:%lldms%s%s]",
+            (long long)ogs_time_to_msec(self.interval),
+            self.file ? ", file:" : "", self.file ? self.file : "");
+
+    return OGS_OK;
+
+error:
+    if (self.fp)
+        fclose(self.fp);
+    entry_remove_all(self.pending);
+    ogs_hash_destroy(self.pending);
+
+    ogs_thread_cond_destroy(&self.cond);
+    ogs_thread_mutex_destroy(&self.mutex);
+
+    memset(&self, 0, sizeof(self));
+
+    return OGS_ERROR;
+}
+
+void ogs_dbi_sqn_journal_final(void)
+{
+    if (self.enabled == false)
+        return;
+
+    ogs_thread_mutex_lock(&self.mutex);
+    self.terminated = true;
+    ogs_thread_cond_signal(&self.cond);
+    ogs_thread_mutex_unlock(&self.mutex);
+
+    ogs_thread_destroy(self.thread);
+
+    /* If it fails, the SQN remains in the file for the next start-up */
+    ogs_dbi_sqn_journal_flush();
+
+    entry_remove_all(self.pending);
+    ogs_hash_destroy(self.pending);
+
+    if (self.fp)
+        fclose(self.fp);
+
+    ogs_thread_cond_destroy(&self.cond);
+    ogs_thread_mutex_destroy(&self.mutex);
+
+    memset(&self, 0, sizeof(self));
+}
+
+bool ogs_dbi_sqn_journal_is_enabled(void)
+{
+    return self.enabled;
+}
+
+bool ogs_dbi_sqn_journal_get(char *supi, uint64_t *sqn)
+{
+    journal_entry_t *entry = NULL;
+
+    ogs_assert(supi);
+    ogs_assert(sqn);
+
+    if (self.enabled == false)
+        return false;
+
+    ogs_thread_mutex_lock(&self.mutex);
+
+    entry = ogs_hash_get(self.pending, supi, strlen(supi));
+    if (!entry && self.flushing)
+        entry = ogs_hash_get(self.flushing, supi, strlen(supi));
+    if (entry)
+        *sqn = entry->sqn;
+
+    ogs_thread_mutex_unlock(&self.mutex);
+
+    return entry ? true : false;
+}
+
+/*
+ * Once the flush has completed, the flushed SQN is only in the DB.
+ * The DB read before that may be stale, even if the journal has nothing.
+ */
+uint64_t ogs_dbi_sqn_journal_generation(void)
+{
+    uint64_t generation;
+
+    if (self.enabled == false)
+        return 0;
+
+    ogs_thread_mutex_lock(&self.mutex);
+    generation = self.generation;
+    ogs_thread_mutex_unlock(&self.mutex);
+
+    return generation;
+}
+
+void ogs_dbi_sqn_journal_set(char *supi, uint64_t sqn)
+{
+    journal_entry_t *entry = NULL;
+
+    ogs_assert(supi);
+    ogs_assert(self.enabled == true);
+
+    ogs_thread_mutex_lock(&self.mutex);
+
+    entry = entry_set(self.pending, supi, sqn & OGS_MAX_SQN);
+    ogs_assert(entry);
+    log_append(entry);
+
+    ogs_thread_mutex_unlock(&self.mutex);
+}
+
+/*
+ * '*sqn' is the base, which is used only if the SQN is not in the journal.
+ * It is read from the DB at 'generation'. If the flush has completed since
+ * then, OGS_RETRY is returned since the base may be stale.
+ *
+ * Same as ogs_dbi_increment_sqn(): ($inc 32) and ($bit and OGS_MAX_SQN)
+ */
+int ogs_dbi_sqn_journal_increment(
+        char *supi, uint64_t *sqn, uint64_t generation)
+{
+    journal_entry_t *entry = NULL;
+    uint64_t base;
+
+    ogs_assert(supi);
+    ogs_assert(sqn);
+    ogs_assert(self.enabled == true);
+
+    ogs_thread_mutex_lock(&self.mutex);
+
+    entry = ogs_hash_get(self.pending, supi, strlen(supi));
+    if (!entry && self.flushing)
+        entry = ogs_hash_get(self.flushing, supi, strlen(supi));
+    if (entry) {
+        base = entry->sqn;
+    } else if (generation != self.generation) {
+        ogs_thread_mutex_unlock(&self.mutex);
+        return OGS_RETRY;
+    } else {
+        base = *sqn;
+    }
+
+    *sqn = (base + 32) & OGS_MAX_SQN;
+
+    entry = entry_set(self.pending, supi, *sqn);
+    ogs_assert(entry);
+    log_append(entry);
+
+    ogs_thread_mutex_unlock(&self.mutex);
+
+    return OGS_OK;
+}
+
+int ogs_dbi_sqn_journal_flush(void)
+{
+    ogs_hash_index_t *hi = NULL;
+    int rv;
+
+    ogs_assert(self.enabled == true);
+
+    ogs_thread_mutex_lock(&self.mutex);
+
+    if (ogs_hash_count(self.pending) == 0) {
+        ogs_thread_mutex_unlock(&self.mutex);
+        return OGS_OK;
+    }
+
+    ogs_assert(self.flushing == NULL);
+    self.flushing = self.pending;
+    self.pending = ogs_hash_make();
+    ogs_assert(self.pending);
+
+    ogs_thread_mutex_unlock(&self.mutex);
+
+    /* The SQN can be updated while the bulk operation is in progress */
+    rv = bulk_write(self.flushing);
+
+    ogs_thread_mutex_lock(&self.mutex);
+
+    if (rv == OGS_OK) {
+        /* The DB read in progress must not be cached */
+        for (hi = ogs_hash_first(self.flushing); hi; hi = ogs_hash_next(hi)) {
+            journal_entry_t *entry = ogs_hash_this_val(hi);
+            ogs_assert(entry);
+
+            ogs_dbi_cache_touch(entry->supi);
+        }
+
+        entry_remove_all(self.flushing);
+        self.generation++;
+
+        /* Only the SQN updated during the bulk operation remains */
+        log_rewrite();
+    } else {
+        /* Try again next time unless a newer SQN has been recorded */
+        for (hi = ogs_hash_first(self.flushing); hi; hi = ogs_hash_next(hi)) {
+            journal_entry_t *entry = ogs_hash_this_val(hi);
+            ogs_assert(entry);
+
+            if (ogs_hash_get(self.pending,
+                        entry->supi, strlen(entry->supi))) {
+                ogs_free(entry->supi);
+                ogs_free(entry);
+            } else {
+                ogs_hash_set(self.pending,
+                        entry->supi, strlen(entry->supi), entry);
+            }
+        }
+    }
+
+    ogs_hash_destroy(self.flushing);
+    self.flushing = NULL;
+
+    ogs_thread_mutex_unlock(&self.mutex);
+
+    return rv;
+}
+
+static void journal_main(void *data)
+{
+    ogs_thread_mutex_lock(&self.mutex);
+
+    while (self.terminated == false) {
+        ogs_thread_cond_timedwait(&self.cond, &self.mutex, self.interval);
+        if (self.terminated == true)
+            break;
+
+        ogs_thread_mutex_unlock(&self.mutex);
+        ogs_dbi_sqn_journal_flush();
+        ogs_thread_mutex_lock(&self.mutex);
+    }
+
+    ogs_thread_mutex_unlock(&self.mutex);
+}
+
+static journal_entry_t *entry_set(ogs_hash_t *hash, char *supi, uint64_t sqn)
+{
+    journal_entry_t *entry = NULL;
+
+    ogs_assert(hash);
+    ogs_assert(supi);
+
+    entry = ogs_hash_get(hash, supi, strlen(supi));
+    if (!entry) {
+        entry = ogs_calloc(1, sizeof(*entry));
+        ogs_assert(entry);
+        entry->supi = ogs_strdup(supi);
+        ogs_assert(entry->supi);
+
+        ogs_hash_set(hash, entry->supi, strlen(entry->supi), entry);
+    }
+
+    entry->sqn = sqn;
+
+    return entry;
+}
+
+static void entry_remove_all(ogs_hash_t *hash)
+{
+    ogs_hash_index_t *hi = NULL;
+
+    ogs_assert(hash);
+
+    for (hi = ogs_hash_first(hash); hi; hi = ogs_hash_next(hi)) {
+        journal_entry_t *entry = ogs_hash_this_val(hi);
+        ogs_assert(entry);
+
+        ogs_hash_set(hash, entry->supi, strlen(entry->supi), NULL);
+
+        ogs_free(entry->supi);
+        ogs_free(entry);
+    }
+}
+
+static void log_append(journal_entry_t *entry)
+{
+    ogs_assert(entry);
+
+    if (!self.fp)
+        return;
+
+    fprintf(self.fp, "%s %llu\n",
+            entry->supi, (unsigned long long)entry->sqn);
+    fflush(self.fp);
+}
+
+static void log_rewrite(void)
+{
+    ogs_hash_index_t *hi = NULL;
+
+    if (!self.fp)
+        return;
+
+    if (ftruncate(fileno(self.fp), 0) != 0) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_errno,
+                "ftruncate() failed [%s]", self.file);
+        return;
+    }
+
+    for (hi = ogs_hash_first(self.pending); hi; hi = ogs_hash_next(hi))
+        log_append(ogs_hash_this_val(hi));
+}
+
+static void log_replay(void)
+{
+    FILE *fp = NULL;
+    char line[OGS_MAX_IMSI_BCD_LEN+64];
+
+    ogs_assert(self.file);
+
+    fp = fopen(self.file, "r");
+    if (!fp)
+        return;
+
+    while (fgets(line, sizeof(line), fp)) {
+        char supi[OGS_MAX_IMSI_BCD_LEN+64];
+        unsigned long long sqn;
+
+        /* Later line has the newer SQN */
+        if (sscanf(line, "%63s %llu", supi, &sqn) == 2)
+            entry_set(self.pending, supi, sqn & OGS_MAX_SQN);
+    }
+
+    fclose(fp);
+}
+
+static int bulk_write(ogs_hash_t *hash)
+{
+    int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *collection = NULL;
+    mongoc_bulk_operation_t *bulk = NULL;
+    ogs_hash_index_t *hi = NULL;
+    int count = 0;
+    bson_t reply;
+    bson_error_t error;
+
+    ogs_assert(hash);
+
+    client = ogs_mongoc_client_pop();
+    ogs_assert(client);
+    collection = mongoc_client_get_collection(
+            client, ogs_mongoc()->name, "subscribers");
+    ogs_assert(collection);
+
+#if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 9
+    {
+        bson_t *opts = BCON_NEW("ordered", BCON_BOOL(false));
+        bulk = mongoc_collection_create_bulk_operation_with_opts(
+                collection, opts);
+        bson_destroy(opts);
+    }
+#else
+    bulk = mongoc_collection_create_bulk_operation(collection, false, NULL);
+#endif
+    ogs_assert(bulk);
+
+    for (hi = ogs_hash_first(hash); hi; hi = ogs_hash_next(hi)) {
+        journal_entry_t *entry = ogs_hash_this_val(hi);
+        bson_t *query = NULL;
+        bson_t *update = NULL;
+        char *supi_type = NULL;
+        char *supi_id = NULL;
+
+        ogs_assert(entry);
+
+        supi_type = ogs_id_get_type(entry->supi);
+        supi_id = ogs_id_get_value(entry->supi);
+        if (!supi_type || !supi_id) {
+            ogs_error("Invalid SUPI [%s]", entry->supi);
+            if (supi_type) ogs_free(supi_type);
+            if (supi_id) ogs_free(supi_id);
+            continue;
+        }
+
+        query = BCON_NEW(supi_type, BCON_UTF8(supi_id));
+        update = BCON_NEW("$set",
+                "{",
+                    "security.sqn", BCON_INT64(entry->sqn),
+                "}");
+
+        mongoc_bulk_operation_update_one(bulk, query, update, false);
+        count++;
+
+        bson_destroy(query);
+        bson_destroy(update);
+
+        ogs_free(supi_type);
+        ogs_free(supi_id);
+    }
+
+    if (count) {
+        if (!mongoc_bulk_operation_execute(bulk, &reply, &error)) {
+            ogs_error("mongoc_bulk_operation_execute() failure: %s",
+                    error.message);
+            rv = OGS_ERROR;
+        }
+        bson_destroy(&reply);
+    }
+
+    mongoc_bulk_operation_destroy(bulk);
+
+    mongoc_collection_destroy(collection);
+    ogs_mongoc_client_push(client);
+
+    return rv;
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined(OGS_DBI_INSIDE) && !defined(OGS_DBI_COMPILATION)
+#error "This header cannot be included directly."
+#endif
+
+#ifndef OGS_DBI_JOURNAL_H
+#define OGS_DBI_JOURNAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * SQN Journal(write-behind)
+ *
+ * The SQN of each subscriber is kept in the journal, and only the last
+ * value is written to the DB in a bulk operation every 'interval'.
+ * ogs_dbi_auth_info() reads the SQN from the journal if it is pending,
+ * and reads the DB again if the flush has completed in the meantime.
+ *
+ * If 'file' is given, every SQN is also appended to the file,
+ * which is replayed to the DB on the next start-up.
+ */
+int ogs_dbi_sqn_journal_init(ogs_time_t interval, const char *file);
+void ogs_dbi_sqn_journal_final(void);
+bool ogs_dbi_sqn_journal_is_enabled(void);
+
+bool ogs_dbi_sqn_journal_get(char *supi, uint64_t *sqn);
+uint64_t ogs_dbi_sqn_journal_generation(void);
+void ogs_dbi_sqn_journal_set(char *supi, uint64_t sqn);
+int ogs_dbi_sqn_journal_increment(
+        char *supi, uint64_t *sqn, uint64_t generation);
+
+int ogs_dbi_sqn_journal_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OGS_DBI_JOURNAL_H */
@@ -31,6 +31,9 @@
 #include "dbi/ims.h"
 #include "dbi/path.h"
 #include "dbi/timer.h"
+#include "dbi/async.h"
+#include "dbi/cache.h"
+#include "dbi/journal.h"
 
 #undef OGS_DBI_INSIDE
 
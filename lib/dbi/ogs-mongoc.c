@@ -117,6 +117,20 @@ int ogs_mongoc_init(const char *db_uri)
     self.database = mongoc_client_get_database(self.client, self.name);
     ogs_assert(self.database);
 
+    /*
+     * 'self.client' is used only by the NF main loop(change stream).
+     * Queries pop the client from the pool, so that they can be issued
+     * from several threads at the same time.
+     */
+    self.uri = mongoc_uri_copy(uri);
+    ogs_assert(self.uri);
+    self.pool = mongoc_client_pool_new(self.uri);
+    ogs_assert(self.pool);
+
+#if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 4
+    mongoc_client_pool_set_error_api(self.pool, 2);
+#endif
+
     if (!ogs_mongoc_mongoc_client_get_server_status(
                 self.client, NULL, &reply, &error)) {
         ogs_warn("Failed to connect to server [%s]", self.masked_db_uri);
@@ -134,6 +148,14 @@ int ogs_mongoc_init(const char *db_uri)
 
 void ogs_mongoc_final(void)
 {
+    if (self.pool) {
+        mongoc_client_pool_destroy(self.pool);
+        self.pool = NULL;
+    }
+    if (self.uri) {
+        mongoc_uri_destroy(self.uri);
+        self.uri = NULL;
+    }
     if (self.database) {
         mongoc_database_destroy(self.database);
         self.database = NULL;
@@ -158,6 +180,19 @@ ogs_mongoc_t *ogs_mongoc(void)
     return &self;
 }
 
+mongoc_client_t *ogs_mongoc_client_pop(void)
+{
+    ogs_assert(self.pool);
+    return mongoc_client_pool_pop(self.pool);
+}
+
+void ogs_mongoc_client_push(mongoc_client_t *client)
+{
+    ogs_assert(self.pool);
+    ogs_assert(client);
+    mongoc_client_pool_push(self.pool, client);
+}
+
 int ogs_dbi_init(const char *db_uri)
 {
     int rv;
@@ -173,11 +208,26 @@ int ogs_dbi_init(const char *db_uri)
         ogs_assert(self.collection.subscriber);
     }
 
+    if (ogs_app()->num_of_db_thread) {
+        rv = ogs_dbi_async_init(ogs_app()->num_of_db_thread);
+        if (rv != OGS_OK) return rv;
+    }
+
+    if (ogs_app()->sqn_journal.interval) {
+        rv = ogs_dbi_sqn_journal_init(ogs_app()->sqn_journal.interval,
+                ogs_app()->sqn_journal.file);
+        if (rv != OGS_OK) return rv;
+    }
+
     return OGS_OK;
 }
 
 void ogs_dbi_final(void)
 {
+    ogs_dbi_sqn_journal_final();
+    ogs_dbi_async_final();
+    ogs_dbi_cache_final();
+
     if (self.collection.subscriber) {
         mongoc_collection_destroy(self.collection.subscriber);
     }
@@ -215,6 +265,10 @@ int ogs_dbi_collection_watch_init(void)
         ogs_info("Change Streams are Enabled.");
     }
 
+    /* The subscriber cache is coherent only with the change stream */
+    if (ogs_app()->db_cache_size && ogs_dbi_cache_is_enabled() == false)
+        ogs_dbi_cache_init(ogs_app()->db_cache_size);
+
     return OGS_OK;
 # else
     return OGS_ERROR;
@@ -231,6 +285,8 @@ int ogs_dbi_poll_change_stream(void)
     bson_error_t error;
 
     while (mongoc_change_stream_next(ogs_mongoc()->stream, &document)) {
+        ogs_dbi_cache_process_change_stream(document);
+
         rv = ogs_dbi_process_change_stream(document);
         if (rv != OGS_OK) return rv;
     }
@@ -243,6 +299,10 @@ int ogs_dbi_poll_change_stream(void)
         } else {
             ogs_debug("Client Error: %s\n", error.message);
         }
+
+        /* Some changes may have been missed */
+        ogs_dbi_cache_remove_all();
+
         return OGS_ERROR;
     }
 
@@ -37,6 +37,8 @@ typedef struct ogs_mongoc_s {
     void *client;
     void *database;
 
+    void *pool;         /* mongoc_client_pool_t, thread-safe */
+
 #if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 9
     mongoc_change_stream_t *stream;
 #endif
@@ -52,6 +54,9 @@ int ogs_mongoc_init(const char *db_uri);
 void ogs_mongoc_final(void);
 ogs_mongoc_t *ogs_mongoc(void);
 
+mongoc_client_t *ogs_mongoc_client_pop(void);
+void ogs_mongoc_client_push(mongoc_client_t *client);
+
 int ogs_dbi_init(const char *db_uri);
 void ogs_dbi_final(void);
 
@@ -22,7 +22,10 @@
 int ogs_dbi_auth_info(char *supi, ogs_dbi_auth_info_t *auth_info)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *collection = NULL;
     mongoc_cursor_t *cursor = NULL;
+    uint64_t version = 0, generation = 0;
     bson_t *query = NULL;
     bson_error_t error;
     const bson_t *document;
@@ -38,17 +41,34 @@ int ogs_dbi_auth_info(char *supi, ogs_dbi_auth_info_t *auth_info)
     ogs_assert(supi);
     ogs_assert(auth_info);
 
+    if (ogs_dbi_cache_get_auth_info(supi, auth_info) == true) {
+        /* The SQN in the journal may not be flushed to the DB yet */
+        ogs_dbi_sqn_journal_get(supi, &auth_info->sqn);
+        return OGS_OK;
+    }
+
     supi_type = ogs_id_get_type(supi);
     ogs_assert(supi_type);
     supi_id = ogs_id_get_value(supi);
     ogs_assert(supi_id);
 
     query = BCON_NEW(supi_type, BCON_UTF8(supi_id));
+
+    client = ogs_mongoc_client_pop();
+    ogs_assert(client);
+    collection = mongoc_client_get_collection(
+            client, ogs_mongoc()->name, "subscribers");
+    ogs_assert(collection);
+
+retry:
+    version = ogs_dbi_cache_version(supi);
+    generation = ogs_dbi_sqn_journal_generation();
+
 #if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 5
     cursor = mongoc_collection_find_with_opts(
-            ogs_mongoc()->collection.subscriber, query, NULL, NULL);
+            collection, query, NULL, NULL);
 #else
-    cursor = mongoc_collection_find(ogs_mongoc()->collection.subscriber,
+    cursor = mongoc_collection_find(collection,
             MONGOC_QUERY_NONE, 0, 0, 0, query, NULL, NULL);
 #endif
 
@@ -104,6 +124,16 @@ int ogs_dbi_auth_info(char *supi, ogs_dbi_auth_info_t *auth_info)
         }
     }
 
+    if (ogs_dbi_sqn_journal_get(supi, &auth_info->sqn) == false &&
+        ogs_dbi_sqn_journal_generation() != generation) {
+        /* Flushed after the DB read. The SQN in the DB may be newer */
+        mongoc_cursor_destroy(cursor);
+        cursor = NULL;
+        goto retry;
+    }
+
+    ogs_dbi_cache_set_auth_info(supi, auth_info, version);
+
 out:
     if (query) bson_destroy(query);
     if (cursor) mongoc_cursor_destroy(cursor);
@@ -111,12 +141,17 @@ out:
     ogs_free(supi_type);
     ogs_free(supi_id);
 
+    mongoc_collection_destroy(collection);
+    ogs_mongoc_client_push(client);
+
     return rv;
 }
 
 int ogs_dbi_update_sqn(char *supi, uint64_t sqn)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *collection = NULL;
     bson_t *query = NULL;
     bson_t *update = NULL;
     bson_error_t error;
@@ -126,6 +161,12 @@ int ogs_dbi_update_sqn(char *supi, uint64_t sqn)
 
     ogs_assert(supi);
 
+    if (ogs_dbi_sqn_journal_is_enabled() == true) {
+        ogs_dbi_sqn_journal_set(supi, sqn);
+        ogs_dbi_cache_update_sqn(supi, sqn & OGS_MAX_SQN);
+        return OGS_OK;
+    }
+
     supi_type = ogs_id_get_type(supi);
     ogs_assert(supi_type);
     supi_id = ogs_id_get_value(supi);
@@ -137,25 +178,41 @@ int ogs_dbi_update_sqn(char *supi, uint64_t sqn)
                 "security.sqn", BCON_INT64(sqn),
             "}");
 
-    if (!mongoc_collection_update(ogs_mongoc()->collection.subscriber,
+    client = ogs_mongoc_client_pop();
+    ogs_assert(client);
+    collection = mongoc_client_get_collection(
+            client, ogs_mongoc()->name, "subscribers");
+    ogs_assert(collection);
+
+    if (!mongoc_collection_update(collection,
             MONGOC_UPDATE_NONE, query, update, NULL, &error)) {
         ogs_error("mongoc_collection_update() failure: %s", error.message);
 
         rv = OGS_ERROR;
     }
 
+    if (rv == OGS_OK)
+        ogs_dbi_cache_update_sqn(supi, sqn);
+    else
+        ogs_dbi_cache_remove(supi);
+
     if (query) bson_destroy(query);
     if (update) bson_destroy(update);
 
     ogs_free(supi_type);
     ogs_free(supi_id);
 
+    mongoc_collection_destroy(collection);
+    ogs_mongoc_client_push(client);
+
     return rv;
 }
 
 int ogs_dbi_update_imeisv(char *supi, char *imeisv)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *collection = NULL;
     bson_t *query = NULL;
     bson_t *update = NULL;
     bson_error_t error;
@@ -178,7 +235,14 @@ int ogs_dbi_update_imeisv(char *supi, char *imeisv)
             "{",
                 "imeisv", BCON_UTF8(imeisv),
             "}");
-    if (!mongoc_collection_update(ogs_mongoc()->collection.subscriber,
+
+    client = ogs_mongoc_client_pop();
+    ogs_assert(client);
+    collection = mongoc_client_get_collection(
+            client, ogs_mongoc()->name, "subscribers");
+    ogs_assert(collection);
+
+    if (!mongoc_collection_update(collection,
             MONGOC_UPDATE_UPSERT, query, update, NULL, &error)) {
         ogs_error("mongoc_collection_update() failure: %s", error.message);
 
@@ -191,6 +255,9 @@ int ogs_dbi_update_imeisv(char *supi, char *imeisv)
     ogs_free(supi_type);
     ogs_free(supi_id);
 
+    mongoc_collection_destroy(collection);
+    ogs_mongoc_client_push(client);
+
     return rv;
 }
 
@@ -198,6 +265,8 @@ int ogs_dbi_update_mme(char *supi, char *mme_host, char *mme_realm,
     bool purge_flag)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *collection = NULL;
     bson_t *query = NULL;
     bson_t *update = NULL;
     bson_error_t error;
@@ -223,25 +292,40 @@ int ogs_dbi_update_mme(char *supi, char *mme_host, char *mme_realm,
                 "mme_timestamp", BCON_INT64(ogs_time_now()),
                 "purge_flag", BCON_BOOL(purge_flag),
             "}");
-    if (!mongoc_collection_update(ogs_mongoc()->collection.subscriber,
+
+    client = ogs_mongoc_client_pop();
+    ogs_assert(client);
+    collection = mongoc_client_get_collection(
+            client, ogs_mongoc()->name, "subscribers");
+    ogs_assert(collection);
+
+    if (!mongoc_collection_update(collection,
             MONGOC_UPDATE_UPSERT, query, update, NULL, &error)) {
         ogs_error("mongoc_collection_update() failure: %s", error.message);
 
         rv = OGS_ERROR;
     }
 
+    /* MME host/realm and purge flag are part of the subscription data */
+    ogs_dbi_cache_remove(supi);
+
     if (query) bson_destroy(query);
     if (update) bson_destroy(update);
 
     ogs_free(supi_type);
     ogs_free(supi_id);
 
+    mongoc_collection_destroy(collection);
+    ogs_mongoc_client_push(client);
+
     return rv;
 }
 
 int ogs_dbi_increment_sqn(char *supi)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *collection = NULL;
     bson_t *query = NULL;
     bson_t *update = NULL;
     bson_error_t error;
@@ -252,6 +336,29 @@ int ogs_dbi_increment_sqn(char *supi)
 
     ogs_assert(supi);
 
+    if (ogs_dbi_sqn_journal_is_enabled() == true) {
+        uint64_t sqn = 0, generation;
+
+        do {
+            generation = ogs_dbi_sqn_journal_generation();
+
+            if (ogs_dbi_sqn_journal_get(supi, &sqn) == false) {
+                ogs_dbi_auth_info_t auth_info;
+
+                rv = ogs_dbi_auth_info(supi, &auth_info);
+                if (rv != OGS_OK)
+                    return rv;
+
+                sqn = auth_info.sqn;
+            }
+        } while (ogs_dbi_sqn_journal_increment(
+                    supi, &sqn, generation) == OGS_RETRY);
+
+        ogs_dbi_cache_update_sqn(supi, sqn);
+
+        return OGS_OK;
+    }
+
     supi_type = ogs_id_get_type(supi);
     ogs_assert(supi_type);
     supi_id = ogs_id_get_value(supi);
@@ -262,7 +369,14 @@ int ogs_dbi_increment_sqn(char *supi)
             "{",
                 "security.sqn", BCON_INT64(32),
             "}");
-    if (!mongoc_collection_update(ogs_mongoc()->collection.subscriber,
+
+    client = ogs_mongoc_client_pop();
+    ogs_assert(client);
+    collection = mongoc_client_get_collection(
+            client, ogs_mongoc()->name, "subscribers");
+    ogs_assert(collection);
+
+    if (!mongoc_collection_update(collection,
             MONGOC_UPDATE_NONE, query, update, NULL, &error)) {
         ogs_error("mongoc_collection_update() failure: %s", error.message);
 
@@ -276,7 +390,7 @@ int ogs_dbi_increment_sqn(char *supi)
                 "security.sqn", 
                 "{", "and", BCON_INT64(max_sqn), "}",
             "}");
-    if (!mongoc_collection_update(ogs_mongoc()->collection.subscriber,
+    if (!mongoc_collection_update(collection,
             MONGOC_UPDATE_NONE, query, update, NULL, &error)) {
         ogs_error("mongoc_collection_update() failure: %s", error.message);
 
@@ -284,12 +398,20 @@ int ogs_dbi_increment_sqn(char *supi)
     }
 
 out:
+    if (rv == OGS_OK)
+        ogs_dbi_cache_increment_sqn(supi);
+    else
+        ogs_dbi_cache_remove(supi);
+
     if (query) bson_destroy(query);
     if (update) bson_destroy(update);
 
     ogs_free(supi_type);
     ogs_free(supi_id);
 
+    mongoc_collection_destroy(collection);
+    ogs_mongoc_client_push(client);
+
     return rv;
 }
 
@@ -297,7 +419,10 @@ int ogs_dbi_subscription_data(char *supi,
         ogs_subscription_data_t *subscription_data)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *collection = NULL;
     mongoc_cursor_t *cursor = NULL;
+    uint64_t version = 0;
     bson_t *query = NULL;
     bson_error_t error;
     const bson_t *document;
@@ -320,17 +445,29 @@ int ogs_dbi_subscription_data(char *supi,
     /* subscription_data should be initialized to zero */
     ogs_assert(memcmp(subscription_data, &zero_data, sizeof(zero_data)) == 0);
 
+    if (ogs_dbi_cache_get_subscription_data(supi, subscription_data) == true)
+        return OGS_OK;
+
+    version = ogs_dbi_cache_version(supi);
+
     supi_type = ogs_id_get_type(supi);
     ogs_assert(supi_type);
     supi_id = ogs_id_get_value(supi);
     ogs_assert(supi_id);
 
     query = BCON_NEW(supi_type, BCON_UTF8(supi_id));
+
+    client = ogs_mongoc_client_pop();
+    ogs_assert(client);
+    collection = mongoc_client_get_collection(
+            client, ogs_mongoc()->name, "subscribers");
+    ogs_assert(collection);
+
 #if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 5
     cursor = mongoc_collection_find_with_opts(
-            ogs_mongoc()->collection.subscriber, query, NULL, NULL);
+            collection, query, NULL, NULL);
 #else
-    cursor = mongoc_collection_find(ogs_mongoc()->collection.subscriber,
+    cursor = mongoc_collection_find(collection,
             MONGOC_QUERY_NONE, 0, 0, 0, query, NULL, NULL);
 #endif
 
@@ -781,6 +918,8 @@ int ogs_dbi_subscription_data(char *supi,
         }
     }
 
+    ogs_dbi_cache_set_subscription_data(supi, subscription_data, version);
+
 out:
     if (query) bson_destroy(query);
     if (cursor) mongoc_cursor_destroy(cursor);
@@ -788,5 +927,8 @@ out:
     ogs_free(supi_type);
     ogs_free(supi_id);
 
+    mongoc_collection_destroy(collection);
+    ogs_mongoc_client_push(client);
+
     return rv;
 }
@@ -0,0 +1,281 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-diameter-common.h"
+
+typedef struct ogs_diam_async_handler_s {
+    ogs_lnode_t lnode;
+
+    int (*cb)(struct msg **, struct avp *,
+            struct session *, void *, enum disp_action *);
+    void *opaque;
+} ogs_diam_async_handler_t;
+
+typedef struct ogs_diam_async_s {
+    ogs_diam_async_handler_t *handler;
+
+    struct msg *msg;
+    struct avp *avp;
+    struct session *session;
+} ogs_diam_async_t;
+
+static struct {
+    int num_of_thread;
+    ogs_thread_t **thread;
+
+    ogs_queue_t *queue;
+
+    /*
+     * Keeps the dispatch threads off the queue while it is torn down.
+     * The mutex lives until the process exits, since a dispatch thread
+     * can still be in async_dispatch_cb() when the workers are stopped.
+     */
+    ogs_thread_mutex_t mutex;
+    bool mutex_initialized;
+    bool running;
+
+    /* Unregistered handlers that a worker may still be using */
+    ogs_list_t retired_list;
+} worker;
+
+static void worker_main(void *data);
+static void async_handle(ogs_diam_async_t *async);
+
+int ogs_diam_async_init(int num_of_thread, int queue_size)
+{
+    int i;
+
+    ogs_assert(num_of_thread > 0);
+    ogs_assert(queue_size > 0);
+    ogs_assert(worker.num_of_thread == 0);
+
+    if (worker.mutex_initialized == false) {
+        ogs_thread_mutex_init(&worker.mutex);
+        worker.mutex_initialized = true;
+    }
+    ogs_list_init(&worker.retired_list);
+
+    worker.queue = ogs_queue_create(queue_size);
+    ogs_assert(worker.queue);
+
+    worker.thread = ogs_calloc(num_of_thread, sizeof(ogs_thread_t *));
+    ogs_assert(worker.thread);
+
+    for (i = 0; i < num_of_thread; i++) {
+        worker.thread[i] = ogs_thread_create(worker_main, NULL);
+        if (!worker.thread[i]) {
+            ogs_error("ogs_thread_create() failed");
+            worker.num_of_thread = i;
+            ogs_diam_async_final();
+            return OGS_ERROR;
+        }
+    }
+
+    worker.num_of_thread = num_of_thread;
+
+    ogs_thread_mutex_lock(&worker.mutex);
+    worker.running = true;
+    ogs_thread_mutex_unlock(&worker.mutex);
+
+    ogs_info("Diameter worker thread [%d]", worker.num_of_thread);
+
+    return OGS_OK;
+}
+
+void ogs_diam_async_final(void)
+{
+    ogs_diam_async_handler_t *handler = NULL, *next_handler = NULL;
+    int i;
+
+    if (!worker.queue)
+        return;
+
+    /*
+     * No more requests are queued once 'running' is cleared.
+     * The pending ones are dropped here, since ogs_queue_trypop()
+     * returns OGS_DONE as soon as the queue is terminated.
+     */
+    ogs_thread_mutex_lock(&worker.mutex);
+    worker.running = false;
+    for ( ;; ) {
+        ogs_diam_async_t *async = NULL;
+
+        if (ogs_queue_trypop(worker.queue, (void**)&async) != OGS_OK)
+            break;
+
+        ogs_assert(async);
+        fd_msg_free(async->msg);
+        ogs_free(async);
+    }
+    ogs_queue_term(worker.queue);
+    ogs_thread_mutex_unlock(&worker.mutex);
+
+    for (i = 0; i < worker.num_of_thread; i++)
+        ogs_thread_destroy(worker.thread[i]);
+
+    ogs_queue_destroy(worker.queue);
+    worker.queue = NULL;
+    ogs_free(worker.thread);
+    worker.thread = NULL;
+    worker.num_of_thread = 0;
+
+    ogs_list_for_each_safe(&worker.retired_list, next_handler, handler) {
+        ogs_list_remove(&worker.retired_list, handler);
+        ogs_free(handler);
+    }
+}
+
+static int async_dispatch_cb(struct msg **msg, struct avp *avp,
+        struct session *session, void *opaque, enum disp_action *act)
+{
+    int rv;
+    ogs_diam_async_handler_t *handler = opaque;
+    ogs_diam_async_t *async = NULL;
+
+    ogs_assert(msg);
+    ogs_assert(handler);
+    ogs_assert(handler->cb);
+
+    /* Set once by ogs_diam_async_init() before any handler is registered */
+    if (worker.mutex_initialized == false)
+        return handler->cb(msg, avp, session, handler->opaque, act);
+
+    async = ogs_calloc(1, sizeof(*async));
+    if (!async) {
+        ogs_error("ogs_calloc() failed");
+        return handler->cb(msg, avp, session, handler->opaque, act);
+    }
+
+    async->handler = handler;
+    async->msg = *msg;
+    async->avp = avp;
+    async->session = session;
+
+    ogs_thread_mutex_lock(&worker.mutex);
+    rv = worker.running ? ogs_queue_trypush(worker.queue, async) : OGS_DONE;
+    ogs_thread_mutex_unlock(&worker.mutex);
+
+    if (rv != OGS_OK) {
+        if (rv == OGS_RETRY)
+            ogs_warn("Diameter worker queue is full");
+        ogs_free(async);
+        return handler->cb(msg, avp, session, handler->opaque, act);
+    }
+
+    /* The request now belongs to the worker, which sends the answer */
+    *msg = NULL;
+    *act = DISP_ACT_CONT;
+
+    return 0;
+}
+
+int ogs_diam_async_register(
+        int (*cb)(struct msg **, struct avp *,
+            struct session *, void *, enum disp_action *),
+        enum disp_how how, struct disp_when *when, void *opaque,
+        struct disp_hdl **handle)
+{
+    int ret;
+    ogs_diam_async_handler_t *handler = NULL;
+
+    ogs_assert(cb);
+
+    handler = ogs_calloc(1, sizeof(*handler));
+    ogs_assert(handler);
+
+    handler->cb = cb;
+    handler->opaque = opaque;
+
+    ret = fd_disp_register(async_dispatch_cb, how, when, handler, handle);
+    if (ret != 0) {
+        ogs_error("fd_disp_register() failed [%d]", ret);
+        ogs_free(handler);
+    }
+
+    return ret;
+}
+
+int ogs_diam_async_unregister(struct disp_hdl **handle)
+{
+    int ret;
+    void *handler = NULL;
+
+    ogs_assert(handle);
+
+    ret = fd_disp_unregister(handle, &handler);
+    if (handler) {
+        /* A worker may still be running this handler */
+        if (worker.queue)
+            ogs_list_add(&worker.retired_list, handler);
+        else
+            ogs_free(handler);
+    }
+
+    return ret;
+}
+
+static void async_handle(ogs_diam_async_t *async)
+{
+    int ret;
+    ogs_diam_async_handler_t *handler = NULL;
+    enum disp_action act = DISP_ACT_CONT;
+
+    ogs_assert(async);
+    handler = async->handler;
+    ogs_assert(handler);
+
+    ret = handler->cb(&async->msg, async->avp, async->session,
+            handler->opaque, &act);
+    if (ret != 0)
+        ogs_error("Diameter callback failed [%d]", ret);
+
+    /*
+     * freeDiameter answers a request that no callback has consumed.
+     * It is no longer in the dispatch path, so do the same here.
+     */
+    if (async->msg) {
+        ret = fd_msg_new_answer_from_req(
+                fd_g_config->cnf_dict, &async->msg, 0);
+        ogs_assert(ret == 0);
+        ret = fd_msg_rescode_set(async->msg,
+                (char *)"DIAMETER_UNABLE_TO_COMPLY", NULL, NULL, 1);
+        ogs_assert(ret == 0);
+        ret = fd_msg_send(&async->msg, NULL, NULL);
+        ogs_assert(ret == 0);
+    }
+}
+
+static void worker_main(void *data)
+{
+    int rv;
+
+    for ( ;; ) {
+        ogs_diam_async_t *async = NULL;
+
+        rv = ogs_queue_pop(worker.queue, (void**)&async);
+        if (rv == OGS_DONE)
+            break;
+
+        if (rv != OGS_OK)
+            continue;
+
+        async_handle(async);
+        ogs_free(async);
+    }
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined(OGS_DIAMETER_INSIDE) && !defined(OGS_DIAMETER_COMPILATION)
+#error "This header cannot be included directly."
+#endif
+
+#ifndef OGS_DIAM_ASYNC_H
+#define OGS_DIAM_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Asynchronous Request Handling
+ *
+ * A callback registered with ogs_diam_async_register() does not run in
+ * the freeDiameter dispatch thread. The dispatch thread takes the request
+ * from freeDiameter and queues it. One of the Diameter worker threads then
+ * calls the callback with the same arguments, and the callback answers
+ * with fd_msg_send() as usual. A slow handler, e.g. one waiting for
+ * the DB, holds a worker instead of a dispatch thread.
+ *
+ * If no worker thread is configured, or the queue is full, the callback
+ * is called directly from the dispatch thread.
+ *
+ * Unregister the handlers before calling ogs_diam_async_final().
+ */
+int ogs_diam_async_init(int num_of_thread, int queue_size);
+void ogs_diam_async_final(void);
+
+int ogs_diam_async_register(
+        int (*cb)(struct msg **, struct avp *,
+            struct session *, void *, enum disp_action *),
+        enum disp_how how, struct disp_when *when, void *opaque,
+        struct disp_hdl **handle);
+int ogs_diam_async_unregister(struct disp_hdl **handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OGS_DIAM_ASYNC_H */
@@ -76,6 +76,22 @@ typedef struct ogs_gtp_node_s {
 
     ogs_list_t      local_list;
     ogs_list_t      remote_list;
+    ogs_hash_t      *local_hash;    /* Local transactions indexed by key */
+    ogs_hash_t      *remote_hash;   /* Remote transactions indexed by key */
+
+    struct {
+        uint16_t    sequence;       /* Sequence of outstanding Echo Request */
+        ogs_time_t  sent;           /* 0 if no Echo Request outstanding */
+        int         missed;         /* Consecutive unanswered requests */
+        bool        failed;
+
+        uint64_t    tx;             /* Echo Requests sent */
+        uint64_t    rx;             /* Echo Responses matched */
+        uint64_t    lost;
+
+        ogs_time_t  rtt;            /* Last round-trip time */
+        ogs_time_t  rtt_avg;        /* Smoothed round-trip time */
+    } echo;                         /* GTP-U path supervision (echo.c) */
 } ogs_gtp_node_t;
 
 typedef struct ogs_gtpu_resource_s {
@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-gtp.h"
+
+#define ECHO_OPTIONAL_LEN           4   /* Sequence, N-PDU, Next Ext. */
+#define ECHO_RECOVERY_TYPE          14
+
+static ogs_timer_t *t_echo = NULL;
+static ogs_gtpu_echo_path_cb path_cb = NULL;
+static uint16_t echo_sequence = 0;
+
+/* Version 1, PT, S : the sequence number is written per peer */
+static const uint8_t echo_req_template[
+        OGS_GTPV1U_HEADER_LEN + ECHO_OPTIONAL_LEN] = {
+    OGS_GTPU_FLAGS_V | OGS_GTPU_FLAGS_PT | OGS_GTPU_FLAGS_S,
+    OGS_GTPU_MSGTYPE_ECHO_REQ,
+    0, ECHO_OPTIONAL_LEN,
+    0, 0, 0, 0,
+    0, 0, 0, 0,
+};
+
+/* The Recovery IE carries a restart counter of zero */
+static const uint8_t echo_rsp_template[
+        OGS_GTPV1U_HEADER_LEN + ECHO_OPTIONAL_LEN + 2] = {
+    OGS_GTPU_FLAGS_V | OGS_GTPU_FLAGS_PT,
+    OGS_GTPU_MSGTYPE_ECHO_RSP,
+    0, ECHO_OPTIONAL_LEN + 2,
+    0, 0, 0, 0,
+    0, 0, 0, 0,
+    ECHO_RECOVERY_TYPE, 0,
+};
+
+static const uint8_t echo_rsp_short_template[
+        OGS_GTPV1U_HEADER_LEN + 2] = {
+    OGS_GTPU_FLAGS_V | OGS_GTPU_FLAGS_PT,
+    OGS_GTPU_MSGTYPE_ECHO_RSP,
+    0, 2,
+    0, 0, 0, 0,
+    ECHO_RECOVERY_TYPE, 0,
+};
+
+static void echo_timeout(void *data);
+
+void ogs_gtpu_echo_init(ogs_gtpu_echo_path_cb cb)
+{
+    ogs_assert(t_echo == NULL);
+
+    path_cb = cb;
+
+    if (!ogs_app()->time.gtpu_echo.interval)
+        return;
+
+    t_echo = ogs_timer_add(ogs_app()->timer_mgr, echo_timeout, NULL);
+    ogs_assert(t_echo);
+    ogs_timer_start(t_echo, ogs_app()->time.gtpu_echo.interval);
+}
+
+void ogs_gtpu_echo_final(void)
+{
+    if (t_echo)
+        ogs_timer_delete(t_echo);
+    t_echo = NULL;
+    path_cb = NULL;
+}
+
+void ogs_gtpu_echo_send_rsp(
+        ogs_socket_t fd, ogs_pkbuf_t *pkbuf, ogs_sockaddr_t *from)
+{
+    uint8_t rsp[sizeof(echo_rsp_template)];
+    uint8_t *req = NULL;
+    size_t len;
+    ssize_t sent;
+
+    ogs_assert(pkbuf);
+    ogs_assert(from);
+
+    req = pkbuf->data;
+
+    if (req[0] & (OGS_GTPU_FLAGS_PN | OGS_GTPU_FLAGS_S)) {
+        if (pkbuf->len < OGS_GTPV1U_HEADER_LEN + ECHO_OPTIONAL_LEN) {
+            ogs_error("[DROP] Small Echo Request [len:%d]", pkbuf->len);
+            return;
+        }
+
+        len = sizeof(echo_rsp_template);
+        memcpy(rsp, echo_rsp_template, len);
+
+        rsp[0] |= req[0] & (OGS_GTPU_FLAGS_PN | OGS_GTPU_FLAGS_S);
+        if (req[0] & OGS_GTPU_FLAGS_S) {
+            rsp[8] = req[8];
+            rsp[9] = req[9];
+        }
+        if (req[0] & OGS_GTPU_FLAGS_PN)
+            rsp[10] = req[10];
+    } else {
+        len = sizeof(echo_rsp_short_template);
+        memcpy(rsp, echo_rsp_short_template, len);
+    }
+
+    if (ogs_log_get_domain_level(OGS_LOG_DOMAIN) >= OGS_LOG_DEBUG) {
+        char buf[OGS_ADDRSTRLEN];
+        ogs_debug("[SEND] Echo Response to [%s]", OGS_ADDR(from, buf));
+    }
+
+    sent = ogs_sendto(fd, rsp, len, 0, from);
+    if (sent < 0 || sent != len) {
+        if (ogs_socket_errno != OGS_EAGAIN)
+            ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
+                    "ogs_sendto() failed");
+    }
+}
+
+void ogs_gtpu_echo_handle_rsp(ogs_pkbuf_t *pkbuf, ogs_sockaddr_t *from)
+{
+    ogs_gtp_node_t *gnode = NULL;
+    uint8_t *rsp = NULL;
+    uint16_t sequence;
+    ogs_time_t rtt;
+    char buf[OGS_ADDRSTRLEN];
+
+    ogs_assert(pkbuf);
+    ogs_assert(from);
+
+    gnode = ogs_gtp_node_find_by_addr(&ogs_gtp_self()->gtpu_peer_list, from);
+    if (!gnode || !gnode->echo.sent) {
+        ogs_debug("Unexpected Echo Response");
+        return;
+    }
+
+    rsp = pkbuf->data;
+    if (!(rsp[0] & OGS_GTPU_FLAGS_S) ||
+        pkbuf->len < OGS_GTPV1U_HEADER_LEN + ECHO_OPTIONAL_LEN) {
+        ogs_debug("No Sequence Number in Echo Response");
+        return;
+    }
+
+    sequence = (rsp[8] << 8) | rsp[9];
+    if (sequence != gnode->echo.sequence) {
+        ogs_debug("Stale Echo Response [%d:%d]",
+                sequence, gnode->echo.sequence);
+        return;
+    }
+
+    rtt = ogs_get_monotonic_time() - gnode->echo.sent;
+
+    gnode->echo.rtt = rtt;
+    if (gnode->echo.rx)
+        gnode->echo.rtt_avg += (rtt - gnode->echo.rtt_avg) / 8;
+    else
+        gnode->echo.rtt_avg = rtt;
+    gnode->echo.rx++;
+
+    gnode->echo.sent = 0;
+    gnode->echo.missed = 0;
+
+    if (gnode->echo.failed) {
+        gnode->echo.failed = false;
+
+        ogs_warn("[%s] GTP-U path recovered [RTT:%lldus]",
+                OGS_ADDR(&gnode->addr, buf), (long long)rtt);
+        if (path_cb)
+            path_cb(gnode, false);
+    }
+}
+
+static void send_echo_req(ogs_gtp_node_t *gnode, ogs_time_t now)
+{
+    uint8_t req[sizeof(echo_req_template)];
+    ssize_t sent;
+
+    ogs_assert(gnode);
+    ogs_assert(gnode->sock);
+
+    memcpy(req, echo_req_template, sizeof(req));
+
+    gnode->echo.sequence = echo_sequence++;
+    req[8] = gnode->echo.sequence >> 8;
+    req[9] = gnode->echo.sequence & 0xff;
+
+    /* A request that could not be sent counts as unanswered */
+    gnode->echo.sent = now;
+    gnode->echo.tx++;
+
+    sent = ogs_sendto(gnode->sock->fd, req, sizeof(req), 0, &gnode->addr);
+    if (sent < 0 || sent != sizeof(req)) {
+        if (ogs_socket_errno != OGS_EAGAIN)
+            ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
+                    "ogs_sendto() failed");
+    }
+}
+
+static void echo_timeout(void *data)
+{
+    ogs_gtp_node_t *gnode = NULL;
+    ogs_time_t now = ogs_get_monotonic_time();
+    char buf[OGS_ADDRSTRLEN];
+
+    ogs_list_for_each(&ogs_gtp_self()->gtpu_peer_list, gnode) {
+        if (!gnode->sock)
+            continue;
+
+        if (gnode->echo.sent) {
+            gnode->echo.lost++;
+            gnode->echo.missed++;
+
+            if (gnode->echo.failed == false &&
+                gnode->echo.missed >= ogs_app()->time.gtpu_echo.max_missed) {
+                gnode->echo.failed = true;
+
+                ogs_error("[%s] GTP-U path failure "
+                        "[Missed:%d, TX:%llu, RX:%llu]",
+                        OGS_ADDR(&gnode->addr, buf), gnode->echo.missed,
+                        (unsigned long long)gnode->echo.tx,
+                        (unsigned long long)gnode->echo.rx);
+                if (path_cb)
+                    path_cb(gnode, true);
+            }
+        }
+
+        send_echo_req(gnode, now);
+    }
+
+    ogs_timer_start(t_echo, ogs_app()->time.gtpu_echo.interval);
+}
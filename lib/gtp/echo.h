@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined(OGS_GTP_INSIDE) && !defined(OGS_GTP_COMPILATION)
+#error "This header cannot be included directly."
+#endif
+
+#ifndef OGS_GTP_ECHO_H
+#define OGS_GTP_ECHO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * GTP-U path supervision.
+ *
+ * Echo Requests are answered from a preformatted response on the stack.
+ * When ogs_app()->time.gtpu_echo.interval is set, a timer on the main
+ * loop probes every peer in ogs_gtp_self()->gtpu_peer_list and keeps
+ * the RTT/loss statistics in gnode->echo. Nothing is done per G-PDU.
+ *
+ * 'cb' is called with failed=true once a peer misses max_missed Echo
+ * Requests in a row, and with failed=false when it answers again.
+ */
+typedef void (*ogs_gtpu_echo_path_cb)(ogs_gtp_node_t *gnode, bool failed);
+
+void ogs_gtpu_echo_init(ogs_gtpu_echo_path_cb cb);
+void ogs_gtpu_echo_final(void);
+
+void ogs_gtpu_echo_send_rsp(
+        ogs_socket_t fd, ogs_pkbuf_t *pkbuf, ogs_sockaddr_t *from);
+void ogs_gtpu_echo_handle_rsp(ogs_pkbuf_t *pkbuf, ogs_sockaddr_t *from);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OGS_GTP_ECHO_H */
@@ -28,6 +28,10 @@ typedef enum {
     GTP_XACT_FINAL_STAGE,
 } ogs_gtp_xact_stage_t;
 
+/* GTPv1 and GTPv2 share the per-node hash, so the key carries the version */
+#define GTP_XACT_KEY(__vERSION, __xID) \
+    (((uint32_t)(__vERSION) << 24) | ((__xID) & 0xffffff))
+
 static int ogs_gtp_xact_initialized = 0;
 static uint32_t g_xact_id = 0;
 
@@ -103,6 +107,9 @@ ogs_gtp_xact_t *ogs_gtp1_xact_local_create(ogs_gtp_node_t *gnode,
     xact->holding_rcount = ogs_app()->time.message.gtp.n3_holding_rcount;
 
     ogs_list_add(&xact->gnode->local_list, xact);
+    xact->key = GTP_XACT_KEY(xact->gtp_version, xact->xid);
+    ogs_hash_set(xact->gnode->local_hash,
+            &xact->key, sizeof(xact->key), xact);
 
     rv = ogs_gtp1_xact_update_tx(xact, hdesc, pkbuf);
     if (rv != OGS_OK) {
@@ -159,6 +166,9 @@ ogs_gtp_xact_t *ogs_gtp_xact_local_create(ogs_gtp_node_t *gnode,
     xact->holding_rcount = ogs_app()->time.message.gtp.n3_holding_rcount,
 
     ogs_list_add(&xact->gnode->local_list, xact);
+    xact->key = GTP_XACT_KEY(xact->gtp_version, xact->xid);
+    ogs_hash_set(xact->gnode->local_hash,
+            &xact->key, sizeof(xact->key), xact);
 
     rv = ogs_gtp_xact_update_tx(xact, hdesc, pkbuf);
     if (rv != OGS_OK) {
@@ -204,6 +214,9 @@ static ogs_gtp_xact_t *ogs_gtp_xact_remote_create(ogs_gtp_node_t *gnode, uint8_t
     xact->holding_rcount = ogs_app()->time.message.gtp.n3_holding_rcount,
 
     ogs_list_add(&xact->gnode->remote_list, xact);
+    xact->key = GTP_XACT_KEY(xact->gtp_version, xact->xid);
+    ogs_hash_set(xact->gnode->remote_hash,
+            &xact->key, sizeof(xact->key), xact);
 
     ogs_debug("[%d] REMOTE Create  peer [%s]:%d",
             xact->xid,
@@ -807,8 +820,9 @@ int ogs_gtp1_xact_receive(
 
     uint8_t type;
     uint32_t sqn, xid;
+    uint32_t key;
     ogs_gtp_xact_stage_t stage;
-    ogs_list_t *list = NULL;
+    ogs_hash_t *hash = NULL;
     ogs_gtp_xact_t *new = NULL;
 
     ogs_assert(gnode);
@@ -827,13 +841,13 @@ int ogs_gtp1_xact_receive(
 
     switch (stage) {
     case GTP_XACT_INITIAL_STAGE:
-        list = &gnode->remote_list;
+        hash = gnode->remote_hash;
         break;
     case GTP_XACT_INTERMEDIATE_STAGE:
-        list = &gnode->local_list;
+        hash = gnode->local_hash;
         break;
     case GTP_XACT_FINAL_STAGE:
-        list = &gnode->local_list; // FIXME: is this correct?
+        hash = gnode->local_hash; // FIXME: is this correct?
         break;
     default:
         ogs_error("[%d] Unexpected type %u from GTPv1 peer [%s]:%d",
@@ -841,24 +855,23 @@ int ogs_gtp1_xact_receive(
         return OGS_ERROR;
     }
 
-    ogs_assert(list);
-    ogs_list_for_each(list, new) {
-        if (new->gtp_version == 1 && new->xid == xid) {
-            ogs_debug("[%d] %s Find GTPv%u peer [%s]:%d",
-                    new->xid,
-                    new->org == OGS_GTP_LOCAL_ORIGINATOR ? "LOCAL " : "REMOTE",
-                    new->gtp_version,
-                    OGS_ADDR(&gnode->addr, buf),
-                    OGS_PORT(&gnode->addr));
-            break;
-        }
-    }
-
-    ogs_debug("[%d] Cannot find xact type %u from GTPv1 peer [%s]:%d",
-            xid, type, OGS_ADDR(&gnode->addr, buf), OGS_PORT(&gnode->addr));
+    ogs_assert(hash);
+    key = GTP_XACT_KEY(1, xid);
+    new = ogs_hash_get(hash, &key, sizeof(key));
+    if (new) {
+        ogs_debug("[%d] %s Find GTPv%u peer [%s]:%d",
+                new->xid,
+                new->org == OGS_GTP_LOCAL_ORIGINATOR ? "LOCAL " : "REMOTE",
+                new->gtp_version,
+                OGS_ADDR(&gnode->addr, buf),
+                OGS_PORT(&gnode->addr));
+    } else {
+        ogs_debug("[%d] Cannot find xact type %u from GTPv1 peer [%s]:%d",
+                xid, type,
+                OGS_ADDR(&gnode->addr, buf), OGS_PORT(&gnode->addr));
 
-    if (!new)
         new = ogs_gtp_xact_remote_create(gnode, 1, sqn);
+    }
     ogs_assert(new);
 
     ogs_debug("[%d] %s Receive peer [%s]:%d",
@@ -888,8 +901,9 @@ int ogs_gtp_xact_receive(
 
     uint8_t type;
     uint32_t sqn, xid;
+    uint32_t key;
     ogs_gtp_xact_stage_t stage;
-    ogs_list_t *list = NULL;
+    ogs_hash_t *hash = NULL;
     ogs_gtp_xact_t *new = NULL;
 
     ogs_assert(gnode);
@@ -905,22 +919,22 @@ int ogs_gtp_xact_receive(
 
     switch (stage) {
     case GTP_XACT_INITIAL_STAGE:
-        list = &gnode->remote_list;
+        hash = gnode->remote_hash;
         break;
     case GTP_XACT_INTERMEDIATE_STAGE:
-        list = &gnode->local_list;
+        hash = gnode->local_hash;
         break;
     case GTP_XACT_FINAL_STAGE:
         if (xid & OGS_GTP_CMD_XACT_ID) {
             if (type == OGS_GTP2_MODIFY_BEARER_FAILURE_INDICATION_TYPE ||
                 type == OGS_GTP2_DELETE_BEARER_FAILURE_INDICATION_TYPE ||
                 type == OGS_GTP2_BEARER_RESOURCE_FAILURE_INDICATION_TYPE) {
-                list = &gnode->local_list;
+                hash = gnode->local_hash;
             } else {
-                list = &gnode->remote_list;
+                hash = gnode->remote_hash;
             }
         } else {
-            list = &gnode->local_list;
+            hash = gnode->local_hash;
         }
         break;
     default:
@@ -929,25 +943,23 @@ int ogs_gtp_xact_receive(
         return OGS_ERROR;
     }
 
-    ogs_assert(list);
-    ogs_list_for_each(list, new) {
-        if (new->gtp_version == 2 && new->xid == xid) {
-            ogs_debug("[%d] %s Find GTPv%u peer [%s]:%d",
-                    new->xid,
-                    new->org == OGS_GTP_LOCAL_ORIGINATOR ? "LOCAL " : "REMOTE",
-                    new->gtp_version,
-                    OGS_ADDR(&gnode->addr, buf),
-                    OGS_PORT(&gnode->addr));
-            break;
-        }
-    }
-
-    ogs_debug("[%d] Cannot find xact type %u from GTPv2 peer [%s]:%d",
-            xid, type,
-            OGS_ADDR(&gnode->addr, buf), OGS_PORT(&gnode->addr));
+    ogs_assert(hash);
+    key = GTP_XACT_KEY(2, xid);
+    new = ogs_hash_get(hash, &key, sizeof(key));
+    if (new) {
+        ogs_debug("[%d] %s Find GTPv%u peer [%s]:%d",
+                new->xid,
+                new->org == OGS_GTP_LOCAL_ORIGINATOR ? "LOCAL " : "REMOTE",
+                new->gtp_version,
+                OGS_ADDR(&gnode->addr, buf),
+                OGS_PORT(&gnode->addr));
+    } else {
+        ogs_debug("[%d] Cannot find xact type %u from GTPv2 peer [%s]:%d",
+                xid, type,
+                OGS_ADDR(&gnode->addr, buf), OGS_PORT(&gnode->addr));
 
-    if (!new)
         new = ogs_gtp_xact_remote_create(gnode, 2, sqn);
+    }
     ogs_assert(new);
 
     ogs_debug("[%d] %s Receive peer [%s]:%d",
@@ -1126,6 +1138,7 @@ void ogs_gtp_xact_deassociate(ogs_gtp_xact_t *xact1, ogs_gtp_xact_t *xact2)
 static int ogs_gtp_xact_delete(ogs_gtp_xact_t *xact)
 {
     char buf[OGS_ADDRSTRLEN];
+    ogs_hash_t *hash = NULL;
 
     ogs_assert(xact);
     ogs_assert(xact->gnode);
@@ -1151,6 +1164,11 @@ static int ogs_gtp_xact_delete(ogs_gtp_xact_t *xact)
     if (xact->assoc_xact)
         ogs_gtp_xact_deassociate(xact, xact->assoc_xact);
 
+    hash = xact->org == OGS_GTP_LOCAL_ORIGINATOR ?
+            xact->gnode->local_hash : xact->gnode->remote_hash;
+    if (ogs_hash_get(hash, &xact->key, sizeof(xact->key)) == xact)
+        ogs_hash_set(hash, &xact->key, sizeof(xact->key), NULL);
+
     ogs_list_remove(xact->org == OGS_GTP_LOCAL_ORIGINATOR ?
             &xact->gnode->local_list : &xact->gnode->remote_list, xact);
     ogs_pool_free(&pool, xact);
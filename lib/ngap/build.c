@@ -254,3 +254,158 @@ ogs_pkbuf_t *ogs_ngap_build_ng_reset_ack(
 
     return ogs_ngap_encode(&pdu);
 }
+
+/*
+ * The APER encoding of a DownlinkNASTransport with only the three
+ * mandatory IEs is a fixed template. Every field is octet-aligned and
+ * only the UE IDs, the NAS-PDU and the lengths in front of them change
+ * between messages, so the PDU is written directly from the template.
+ *
+ *   00 04 40 LL          initiatingMessage, id-DownlinkNASTransport, ignore
+ *   00 00 03             protocolIEs (3 items)
+ *   00 0a 00 LL <id>     AMF-UE-NGAP-ID, reject
+ *   00 55 00 LL <id>     RAN-UE-NGAP-ID, reject
+ *   00 26 00 LL LL <nas> NAS-PDU, reject
+ *
+ * X.691 10.5.7.4: an INTEGER whose range needs more than 16 bits is sent
+ * as the octet count in the leading bits of the first octet, followed by
+ * the value in the minimum number of octets.
+ */
+#define APER_MAX_LENGTH 16383
+
+#define NGAP_AMF_UE_NGAP_ID_MAX 0xffffffffffULL
+
+static const uint8_t downlink_nas_transport_header[] = {
+    0x00, NGAP_ProcedureCode_id_DownlinkNASTransport,
+    NGAP_Criticality_ignore << 6 };
+
+static const uint8_t downlink_nas_transport_ies[] = { 0x00, 0x00, 0x03 };
+
+static int template_length_size(int length)
+{
+    return length < 128 ? 1 : 2;
+}
+
+static uint8_t *template_put_length(uint8_t *p, int length)
+{
+    if (length < 128) {
+        *p++ = length;
+    } else {
+        *p++ = 0x80 | (length >> 8);
+        *p++ = length & 0xff;
+    }
+
+    return p;
+}
+
+static int template_uint_size(uint64_t value)
+{
+    int size = 1;
+
+    while (value >>= 8)
+        size++;
+
+    return size;
+}
+
+static uint8_t *template_put_ie_header(uint8_t *p,
+        NGAP_ProtocolIE_ID_t id, NGAP_Criticality_t criticality, int length)
+{
+    *p++ = (id >> 8) & 0xff;
+    *p++ = id & 0xff;
+    *p++ = criticality << 6;
+
+    return template_put_length(p, length);
+}
+
+static uint8_t *template_put_uint_ie(uint8_t *p,
+        NGAP_ProtocolIE_ID_t id, NGAP_Criticality_t criticality,
+        uint64_t value, int size, int length_bits)
+{
+    int i;
+
+    p = template_put_ie_header(p, id, criticality, 1 + size);
+
+    *p++ = (size - 1) << (8 - length_bits);
+    for (i = size - 1; i >= 0; i--)
+        *p++ = (value >> (i * 8)) & 0xff;
+
+    return p;
+}
+
+ogs_pkbuf_t *ogs_ngap_build_downlink_nas_transport(
+        uint64_t amf_ue_ngap_id, uint32_t ran_ue_ngap_id,
+        ogs_pkbuf_t *naspdu)
+{
+    ogs_pkbuf_t *pkbuf = NULL;
+    uint8_t *p = NULL;
+
+    int amf_ue_ngap_id_size, ran_ue_ngap_id_size;
+    int nas_pdu_length, value_length, length;
+
+    ogs_assert(naspdu);
+
+    /* asn_fprint() needs the asn1c tree */
+    if (ogs_log_get_domain_level(OGS_LOG_DOMAIN) >= OGS_LOG_TRACE)
+        return NULL;
+
+    if (amf_ue_ngap_id > NGAP_AMF_UE_NGAP_ID_MAX) {
+        ogs_error("Invalid AMF_UE_NGAP_ID[%lld]", (long long)amf_ue_ngap_id);
+        return NULL;
+    }
+
+    /* Fragmented lengths are left to asn1c */
+    if (naspdu->len > APER_MAX_LENGTH)
+        return NULL;
+
+    amf_ue_ngap_id_size = template_uint_size(amf_ue_ngap_id);
+    ran_ue_ngap_id_size = template_uint_size(ran_ue_ngap_id);
+
+    nas_pdu_length = template_length_size(naspdu->len) + naspdu->len;
+
+    value_length = sizeof(downlink_nas_transport_ies) +
+        3 + 1 + 1 + amf_ue_ngap_id_size +
+        3 + 1 + 1 + ran_ue_ngap_id_size +
+        3 + template_length_size(nas_pdu_length) + nas_pdu_length;
+    if (value_length > APER_MAX_LENGTH)
+        return NULL;
+
+    length = sizeof(downlink_nas_transport_header) +
+        template_length_size(value_length) + value_length;
+
+    pkbuf = ogs_pkbuf_alloc(NULL, length);
+    if (!pkbuf) {
+        ogs_error("ogs_pkbuf_alloc() failed");
+        return NULL;
+    }
+    p = ogs_pkbuf_put(pkbuf, length);
+
+    memcpy(p, downlink_nas_transport_header,
+            sizeof(downlink_nas_transport_header));
+    p += sizeof(downlink_nas_transport_header);
+    p = template_put_length(p, value_length);
+
+    memcpy(p, downlink_nas_transport_ies, sizeof(downlink_nas_transport_ies));
+    p += sizeof(downlink_nas_transport_ies);
+
+    /* AMF-UE-NGAP-ID ::= INTEGER (0..1099511627775) : 3-bit octet count */
+    p = template_put_uint_ie(p,
+            NGAP_ProtocolIE_ID_id_AMF_UE_NGAP_ID, NGAP_Criticality_reject,
+            amf_ue_ngap_id, amf_ue_ngap_id_size, 3);
+
+    /* RAN-UE-NGAP-ID ::= INTEGER (0..4294967295) : 2-bit octet count */
+    p = template_put_uint_ie(p,
+            NGAP_ProtocolIE_ID_id_RAN_UE_NGAP_ID, NGAP_Criticality_reject,
+            ran_ue_ngap_id, ran_ue_ngap_id_size, 2);
+
+    p = template_put_ie_header(p,
+            NGAP_ProtocolIE_ID_id_NAS_PDU, NGAP_Criticality_reject,
+            nas_pdu_length);
+    p = template_put_length(p, naspdu->len);
+    memcpy(p, naspdu->data, naspdu->len);
+    p += naspdu->len;
+
+    ogs_assert(p == pkbuf->tail);
+
+    return pkbuf;
+}
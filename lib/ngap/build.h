@@ -44,6 +44,17 @@ void ogs_ngap_build_part_of_ng_interface(
 ogs_pkbuf_t *ogs_ngap_build_ng_reset_ack(
     NGAP_UE_associatedLogicalNG_connectionList_t *partOfNG_Interface);
 
+/*
+ * Writes the APER encoding of a DownlinkNASTransport carrying only
+ * AMF-UE-NGAP-ID, RAN-UE-NGAP-ID and NAS-PDU without building an asn1c
+ * tree. The NAS-PDU is copied, not consumed. Returns NULL when the
+ * message cannot be written this way, in which case the caller falls
+ * back to the generic encoder.
+ */
+ogs_pkbuf_t *ogs_ngap_build_downlink_nas_transport(
+    uint64_t amf_ue_ngap_id, uint32_t ran_ue_ngap_id,
+    ogs_pkbuf_t *naspdu);
+
 #ifdef __cplusplus
 }
 #endif
@@ -305,6 +305,123 @@ ogs_pkbuf_t *ogs_pfcp_up_build_association_setup_response(uint8_t type,
     return pkbuf;
 }
 
+ogs_pkbuf_t *ogs_pfcp_up_build_node_report_request(uint8_t type,
+        ogs_pfcp_node_report_type_t report_type, ogs_ip_t *remote_peer)
+{
+    ogs_pfcp_message_t *pfcp_message = NULL;
+    ogs_pfcp_node_report_request_t *req = NULL;
+    ogs_pkbuf_t *pkbuf = NULL;
+
+    ogs_pfcp_node_id_t node_id;
+    int node_id_len = 0;
+
+    ogs_pfcp_remote_gtp_u_peer_t remote_gtp_u_peer;
+    int remote_gtp_u_peer_len = 0;
+
+    int rv;
+
+    ogs_assert(remote_peer);
+
+    ogs_debug("Node Report Request");
+
+    pfcp_message = ogs_calloc(1, sizeof(*pfcp_message));
+    if (!pfcp_message) {
+        ogs_error("ogs_calloc() failed");
+        return NULL;
+    }
+
+    req = &pfcp_message->pfcp_node_report_request;
+
+    rv = ogs_pfcp_sockaddr_to_node_id(&node_id, &node_id_len);
+    if (rv != OGS_OK) {
+        ogs_error("ogs_pfcp_sockaddr_to_node_id() failed");
+        ogs_free(pfcp_message);
+        return NULL;
+    }
+    req->node_id.presence = 1;
+    req->node_id.data = &node_id;
+    req->node_id.len = node_id_len;
+
+    req->node_report_type.presence = 1;
+    req->node_report_type.data = &report_type;
+    req->node_report_type.len = sizeof(report_type);
+
+    rv = ogs_pfcp_ip_to_remote_gtp_u_peer(
+            remote_peer, &remote_gtp_u_peer, &remote_gtp_u_peer_len);
+    if (rv != OGS_OK) {
+        ogs_error("ogs_pfcp_ip_to_remote_gtp_u_peer() failed");
+        ogs_free(pfcp_message);
+        return NULL;
+    }
+
+    if (report_type.user_plane_path_failure_report) {
+        req->user_plane_path_failure_report.presence = 1;
+        req->user_plane_path_failure_report.remote_gtp_u_peer.presence = 1;
+        req->user_plane_path_failure_report.remote_gtp_u_peer.data =
+            &remote_gtp_u_peer;
+        req->user_plane_path_failure_report.remote_gtp_u_peer.len =
+            remote_gtp_u_peer_len;
+    }
+    if (report_type.user_plane_path_recovery_report) {
+        req->user_plane_path_recovery_report.presence = 1;
+        req->user_plane_path_recovery_report.remote_gtp_u_peer.presence = 1;
+        req->user_plane_path_recovery_report.remote_gtp_u_peer.data =
+            &remote_gtp_u_peer;
+        req->user_plane_path_recovery_report.remote_gtp_u_peer.len =
+            remote_gtp_u_peer_len;
+    }
+
+    pfcp_message->h.type = type;
+    pkbuf = ogs_pfcp_build_msg(pfcp_message);
+    ogs_expect(pkbuf);
+
+    ogs_free(pfcp_message);
+
+    return pkbuf;
+}
+
+ogs_pkbuf_t *ogs_pfcp_cp_build_node_report_response(uint8_t type,
+        uint8_t cause)
+{
+    ogs_pfcp_message_t *pfcp_message = NULL;
+    ogs_pfcp_node_report_response_t *rsp = NULL;
+    ogs_pkbuf_t *pkbuf = NULL;
+
+    ogs_pfcp_node_id_t node_id;
+    int node_id_len = 0, rv;
+
+    ogs_debug("Node Report Response");
+
+    pfcp_message = ogs_calloc(1, sizeof(*pfcp_message));
+    if (!pfcp_message) {
+        ogs_error("ogs_calloc() failed");
+        return NULL;
+    }
+
+    rsp = &pfcp_message->pfcp_node_report_response;
+
+    rv = ogs_pfcp_sockaddr_to_node_id(&node_id, &node_id_len);
+    if (rv != OGS_OK) {
+        ogs_error("ogs_pfcp_sockaddr_to_node_id() failed");
+        ogs_free(pfcp_message);
+        return NULL;
+    }
+    rsp->node_id.presence = 1;
+    rsp->node_id.data = &node_id;
+    rsp->node_id.len = node_id_len;
+
+    rsp->cause.presence = 1;
+    rsp->cause.u8 = cause;
+
+    pfcp_message->h.type = type;
+    pkbuf = ogs_pfcp_build_msg(pfcp_message);
+    ogs_expect(pkbuf);
+
+    ogs_free(pfcp_message);
+
+    return pkbuf;
+}
+
 static struct {
     ogs_pfcp_f_teid_t f_teid;
     char dnn[OGS_MAX_DNN_LEN+1];
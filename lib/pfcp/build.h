@@ -35,6 +35,11 @@ ogs_pkbuf_t *ogs_pfcp_up_build_association_setup_request(uint8_t type);
 ogs_pkbuf_t *ogs_pfcp_up_build_association_setup_response(uint8_t type,
         uint8_t cause);
 
+ogs_pkbuf_t *ogs_pfcp_up_build_node_report_request(uint8_t type,
+        ogs_pfcp_node_report_type_t report_type, ogs_ip_t *remote_peer);
+ogs_pkbuf_t *ogs_pfcp_cp_build_node_report_response(uint8_t type,
+        uint8_t cause);
+
 void ogs_pfcp_pdrbuf_init(void);
 void ogs_pfcp_pdrbuf_clear(void);
 
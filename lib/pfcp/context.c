@@ -40,6 +40,9 @@ static OGS_POOL(ogs_pfcp_rule_pool, ogs_pfcp_rule_t);
 
 static OGS_POOL(ogs_pfcp_dev_pool, ogs_pfcp_dev_t);
 static OGS_POOL(ogs_pfcp_subnet_pool, ogs_pfcp_subnet_t);
+static OGS_POOL(ogs_pfcp_ue_ip_pool, ogs_pfcp_ue_ip_t);
+
+static void dnn_buffer_remove_all(void);
 
 void ogs_pfcp_context_init(void)
 {
@@ -83,6 +86,8 @@ void ogs_pfcp_context_init(void)
 
     ogs_pool_init(&ogs_pfcp_dev_pool, OGS_MAX_NUM_OF_DEV);
     ogs_pool_init(&ogs_pfcp_subnet_pool, OGS_MAX_NUM_OF_SUBNET);
+    /* IPv4 and IPv6 for each session */
+    ogs_pool_init(&ogs_pfcp_ue_ip_pool, ogs_app()->pool.sess * 2);
 
     self.object_teid_hash = ogs_hash_make();
     ogs_assert(self.object_teid_hash);
@@ -90,6 +95,8 @@ void ogs_pfcp_context_init(void)
     ogs_assert(self.far_f_teid_hash);
     self.far_teid_hash = ogs_hash_make();
     ogs_assert(self.far_teid_hash);
+    self.buffer.dnn_hash = ogs_hash_make();
+    ogs_assert(self.buffer.dnn_hash);
 
     context_initialized = 1;
 }
@@ -105,11 +112,16 @@ void ogs_pfcp_context_final(void)
     ogs_assert(self.far_teid_hash);
     ogs_hash_destroy(self.far_teid_hash);
 
+    dnn_buffer_remove_all();
+    ogs_assert(self.buffer.dnn_hash);
+    ogs_hash_destroy(self.buffer.dnn_hash);
+
     ogs_pfcp_dev_remove_all();
     ogs_pfcp_subnet_remove_all();
 
     ogs_pool_final(&ogs_pfcp_dev_pool);
     ogs_pool_final(&ogs_pfcp_subnet_pool);
+    ogs_pool_final(&ogs_pfcp_ue_ip_pool);
     ogs_pool_final(&ogs_pfcp_rule_pool);
 
     ogs_pool_final(&ogs_pfcp_pdr_pool);
@@ -530,6 +542,7 @@ int ogs_pfcp_context_parse_config(const char *local, const char *remote)
                         int num_of_e_cell_id = 0;
                         uint64_t nr_cell_id[OGS_MAX_NUM_OF_CELL_ID] = {0,};
                         int num_of_nr_cell_id = 0;
+                        int weight = 1;
 
                         if (ogs_yaml_iter_type(&pfcp_array) ==
                                 YAML_MAPPING_NODE) {
@@ -587,6 +600,13 @@ int ogs_pfcp_context_parse_config(const char *local, const char *remote)
                             } else if (!strcmp(pfcp_key, "port")) {
                                 const char *v = ogs_yaml_iter_value(&pfcp_iter);
                                 if (v) port = atoi(v);
+                            } else if (!strcmp(pfcp_key, "weight")) {
+                                const char *v = ogs_yaml_iter_value(&pfcp_iter);
+                                if (v) weight = atoi(v);
+                                if (weight <= 0) {
+                                    ogs_error("Invalid weight(%d)", weight);
+                                    return OGS_ERROR;
+                                }
                             } else if (!strcmp(pfcp_key, "tac")) {
                                 ogs_yaml_iter_t tac_iter;
                                 ogs_yaml_iter_recurse(&pfcp_iter, &tac_iter);
@@ -716,6 +736,8 @@ int ogs_pfcp_context_parse_config(const char *local, const char *remote)
                         ogs_assert(node);
                         ogs_list_add(&self.pfcp_peer_list, node);
 
+                        node->weight = weight;
+
                         node->num_of_tac = num_of_tac;
                         if (num_of_tac != 0)
                             memcpy(node->tac, tac, sizeof(node->tac));
@@ -761,9 +783,14 @@ ogs_pfcp_node_t *ogs_pfcp_node_new(ogs_sockaddr_t *sa_list)
     memset(node, 0, sizeof(ogs_pfcp_node_t));
 
     node->sa_list = sa_list;
+    node->weight = 1;
 
     ogs_list_init(&node->local_list);
     ogs_list_init(&node->remote_list);
+    node->local_hash = ogs_hash_make();
+    ogs_assert(node->local_hash);
+    node->remote_hash = ogs_hash_make();
+    ogs_assert(node->remote_hash);
 
     ogs_list_init(&node->gtpu_resource_list);
 
@@ -778,6 +805,9 @@ void ogs_pfcp_node_free(ogs_pfcp_node_t *node)
 
     ogs_pfcp_xact_delete_all(node);
 
+    ogs_hash_destroy(node->local_hash);
+    ogs_hash_destroy(node->remote_hash);
+
     ogs_freeaddrinfo(node->sa_list);
     ogs_pool_free(&ogs_pfcp_node_pool, node);
 }
@@ -1523,7 +1553,6 @@ ogs_pfcp_far_t *ogs_pfcp_far_find_by_teid(uint32_t teid)
 
 void ogs_pfcp_far_remove(ogs_pfcp_far_t *far)
 {
-    int i;
     ogs_pfcp_sess_t *sess = NULL;
 
     ogs_assert(far);
@@ -1543,8 +1572,7 @@ void ogs_pfcp_far_remove(ogs_pfcp_far_t *far)
     if (far->dnn)
         ogs_free(far->dnn);
 
-    for (i = 0; i < far->num_of_buffered_packet; i++)
-        ogs_pkbuf_free(far->buffered_packet[i]);
+    ogs_pfcp_far_clear_buffer(far);
 
     if (far->id_node)
         ogs_pool_free(&far->sess->far_id_pool, far->id_node);
@@ -1562,6 +1590,221 @@ void ogs_pfcp_far_remove_all(ogs_pfcp_sess_t *sess)
         ogs_pfcp_far_remove(far);
 }
 
+static ogs_pfcp_dnn_buffer_t *dnn_buffer_find_or_add(const char *dnn)
+{
+    ogs_pfcp_dnn_buffer_t *dnn_buffer = NULL;
+
+    ogs_assert(dnn);
+
+    dnn_buffer = ogs_hash_get(self.buffer.dnn_hash, dnn, OGS_HASH_KEY_STRING);
+    if (dnn_buffer)
+        return dnn_buffer;
+
+    dnn_buffer = ogs_calloc(1, sizeof(*dnn_buffer));
+    ogs_assert(dnn_buffer);
+    dnn_buffer->dnn = ogs_strdup(dnn);
+    ogs_assert(dnn_buffer->dnn);
+
+    ogs_hash_set(self.buffer.dnn_hash,
+            dnn_buffer->dnn, OGS_HASH_KEY_STRING, dnn_buffer);
+
+    return dnn_buffer;
+}
+
+static void dnn_buffer_remove_all(void)
+{
+    ogs_hash_index_t *hi = NULL;
+
+    for (hi = ogs_hash_first(self.buffer.dnn_hash);
+            hi; hi = ogs_hash_next(hi)) {
+        ogs_pfcp_dnn_buffer_t *dnn_buffer = ogs_hash_this_val(hi);
+        ogs_assert(dnn_buffer);
+
+        ogs_hash_set(self.buffer.dnn_hash,
+                dnn_buffer->dnn, OGS_HASH_KEY_STRING, NULL);
+        ogs_free(dnn_buffer->dnn);
+        ogs_free(dnn_buffer);
+    }
+}
+
+/* A DNN entry is freed once nothing is buffered for it any more */
+static void dnn_buffer_release(ogs_pfcp_dnn_buffer_t *dnn_buffer)
+{
+    if (!dnn_buffer || dnn_buffer->bytes)
+        return;
+
+    ogs_hash_set(self.buffer.dnn_hash,
+            dnn_buffer->dnn, OGS_HASH_KEY_STRING, NULL);
+    ogs_free(dnn_buffer->dnn);
+    ogs_free(dnn_buffer);
+}
+
+static bool far_buffer_fits(ogs_pfcp_far_t *far,
+        ogs_pfcp_dnn_buffer_t *dnn_buffer, uint64_t size)
+{
+    ogs_pfcp_sess_t *sess = NULL;
+
+    ogs_assert(far);
+    sess = far->sess;
+    ogs_assert(sess);
+
+    if (self.buffer.bytes + size > ogs_app()->buffer.max)
+        return false;
+    if (sess->buffered_bytes + size > ogs_app()->buffer.ue)
+        return false;
+    if (dnn_buffer && ogs_app()->buffer.dnn &&
+        dnn_buffer->bytes + size > ogs_app()->buffer.dnn)
+        return false;
+
+    return true;
+}
+
+static ogs_pkbuf_t *far_buffer_unlink(ogs_pfcp_far_t *far)
+{
+    ogs_pfcp_sess_t *sess = NULL;
+    ogs_pkbuf_t *pkbuf = NULL;
+    uint64_t size;
+
+    ogs_assert(far);
+    sess = far->sess;
+    ogs_assert(sess);
+
+    pkbuf = ogs_list_first(&far->buffer.list);
+    if (!pkbuf)
+        return NULL;
+
+    ogs_list_remove(&far->buffer.list, pkbuf);
+
+    size = pkbuf->end - pkbuf->head;
+
+    ogs_assert(far->buffer.num_of_packet);
+    far->buffer.num_of_packet--;
+    ogs_assert(far->buffer.bytes >= size);
+    far->buffer.bytes -= size;
+    ogs_assert(sess->buffered_bytes >= size);
+    sess->buffered_bytes -= size;
+    ogs_assert(self.buffer.bytes >= size);
+    self.buffer.bytes -= size;
+    if (far->buffer.dnn) {
+        ogs_assert(far->buffer.dnn->bytes >= size);
+        far->buffer.dnn->bytes -= size;
+    }
+
+    if (far->buffer.num_of_packet == 0)
+        far->buffer.dnn = NULL;
+
+    return pkbuf;
+}
+
+/*
+ * Queue a downlink packet on a buffering FAR. The FAR takes ownership of
+ * the packet. If the packet does not fit in the global budget or the
+ * per-UE(session)/per-DNN quota, it is dropped according to the policy:
+ *
+ * - tail : drop the arriving packet
+ * - head : drop the oldest packets of this FAR to make room, and fall back
+ *          to dropping the arriving packet once the queue is empty
+ *
+ * Returns false if the arriving packet was dropped.
+ */
+bool ogs_pfcp_far_buffer_packet(
+        ogs_pfcp_far_t *far, const char *dnn, ogs_pkbuf_t *pkbuf)
+{
+    ogs_pfcp_sess_t *sess = NULL;
+    ogs_pfcp_dnn_buffer_t *dnn_buffer = NULL;
+    uint64_t size;
+
+    ogs_assert(far);
+    sess = far->sess;
+    ogs_assert(sess);
+    ogs_assert(pkbuf);
+
+    size = pkbuf->end - pkbuf->head;
+
+    dnn_buffer = far->buffer.dnn;
+    if (!dnn_buffer && dnn)
+        dnn_buffer = dnn_buffer_find_or_add(dnn);
+
+    while (far_buffer_fits(far, dnn_buffer, size) == false) {
+        if (ogs_app()->buffer.drop == OGS_BUFFER_DROP_HEAD &&
+            far->buffer.num_of_packet) {
+            ogs_pkbuf_t *oldest = far_buffer_unlink(far);
+            ogs_assert(oldest);
+            ogs_pkbuf_free(oldest);
+            self.buffer.dropped++;
+            ogs_pfcp_metrics_inst_global_inc(
+                    OGS_PFCP_METR_GLOB_CTR_BUFFER_DROPPED);
+            continue;
+        }
+
+        ogs_debug("Buffer full [UE:%lld,DNN:%lld,TOTAL:%lld]",
+                (long long)sess->buffered_bytes,
+                dnn_buffer ? (long long)dnn_buffer->bytes : 0,
+                (long long)self.buffer.bytes);
+
+        ogs_pkbuf_free(pkbuf);
+        self.buffer.dropped++;
+        ogs_pfcp_metrics_inst_global_inc(
+                OGS_PFCP_METR_GLOB_CTR_BUFFER_DROPPED);
+        dnn_buffer_release(dnn_buffer);
+        return false;
+    }
+
+    ogs_list_add(&far->buffer.list, pkbuf);
+
+    far->buffer.dnn = dnn_buffer;
+    far->buffer.num_of_packet++;
+    far->buffer.bytes += size;
+    sess->buffered_bytes += size;
+    self.buffer.bytes += size;
+    if (far->buffer.dnn)
+        far->buffer.dnn->bytes += size;
+
+    self.buffer.buffered++;
+    ogs_pfcp_metrics_inst_global_inc(OGS_PFCP_METR_GLOB_CTR_BUFFER_BUFFERED);
+
+    return true;
+}
+
+ogs_pkbuf_t *ogs_pfcp_far_dequeue_packet(ogs_pfcp_far_t *far)
+{
+    ogs_pfcp_dnn_buffer_t *dnn_buffer = NULL;
+    ogs_pkbuf_t *pkbuf = NULL;
+
+    ogs_assert(far);
+
+    dnn_buffer = far->buffer.dnn;
+
+    pkbuf = far_buffer_unlink(far);
+    if (pkbuf) {
+        self.buffer.flushed++;
+        ogs_pfcp_metrics_inst_global_inc(
+                OGS_PFCP_METR_GLOB_CTR_BUFFER_FLUSHED);
+        dnn_buffer_release(dnn_buffer);
+    }
+
+    return pkbuf;
+}
+
+void ogs_pfcp_far_clear_buffer(ogs_pfcp_far_t *far)
+{
+    ogs_pfcp_dnn_buffer_t *dnn_buffer = NULL;
+    ogs_pkbuf_t *pkbuf = NULL;
+
+    ogs_assert(far);
+
+    dnn_buffer = far->buffer.dnn;
+
+    while ((pkbuf = far_buffer_unlink(far)) != NULL) {
+        ogs_pkbuf_free(pkbuf);
+        self.buffer.dropped++;
+        ogs_pfcp_metrics_inst_global_inc(
+                OGS_PFCP_METR_GLOB_CTR_BUFFER_DROPPED);
+    }
+
+    dnn_buffer_release(dnn_buffer);
+}
+
 ogs_pfcp_urr_t *ogs_pfcp_urr_add(ogs_pfcp_sess_t *sess)
 {
     ogs_pfcp_urr_t *urr = NULL;
@@ -1828,6 +2071,161 @@ void ogs_pfcp_rule_remove_all(ogs_pfcp_pdr_t *pdr)
         ogs_pfcp_rule_remove(rule);
 }
 
+#define UE_POOL_WORDS(n) (((n) + 63) / 64)
+
+static void ue_pool_set(ogs_pfcp_subnet_t *subnet, uint32_t slot)
+{
+    uint32_t w = slot / 64;
+
+    subnet->pool.bits[w] |= (1ULL << (slot % 64));
+    if (subnet->pool.bits[w] == UINT64_MAX)
+        subnet->pool.full[w / 64] |= (1ULL << (w % 64));
+}
+
+static void ue_pool_clear(ogs_pfcp_subnet_t *subnet, uint32_t slot)
+{
+    uint32_t w = slot / 64;
+
+    subnet->pool.bits[w] &= ~(1ULL << (slot % 64));
+    subnet->pool.full[w / 64] &= ~(1ULL << (w % 64));
+}
+
+static bool ue_pool_isset(ogs_pfcp_subnet_t *subnet, uint32_t slot)
+{
+    return (subnet->pool.bits[slot / 64] >> (slot % 64)) & 1;
+}
+
+/* Find the word which has a free slot, starting from the 'from' word */
+static uint32_t ue_pool_find_word(ogs_pfcp_subnet_t *subnet, uint32_t from)
+{
+    uint32_t nwords = UE_POOL_WORDS(subnet->pool.size);
+    uint32_t nfull = UE_POOL_WORDS(nwords);
+    uint32_t i, f;
+    uint64_t mask;
+
+    from %= nwords;
+
+    for (i = 0; i <= nfull; i++) {
+        f = (from / 64 + i) % nfull;
+        mask = subnet->pool.full[f];
+
+        /* Skip the words before 'from' until wrapping around */
+        if (i == 0)
+            mask |= (1ULL << (from % 64)) - 1;
+
+        if (mask != UINT64_MAX)
+            return f * 64 + __builtin_ctzll(~mask);
+    }
+
+    ogs_assert_if_reached();
+    return 0;
+}
+
+static uint32_t ue_pool_alloc(ogs_pfcp_subnet_t *subnet)
+{
+    uint32_t w, slot;
+    uint64_t bits;
+
+    if (subnet->pool.avail == 0)
+        return OGS_PFCP_UE_IP_NO_SLOT;
+
+    /*
+     * Next-fit : the released address is not reused
+     * until the cursor wraps around.
+     */
+    w = subnet->pool.next / 64;
+    bits = ~subnet->pool.bits[w] & (UINT64_MAX << (subnet->pool.next % 64));
+    if (!bits) {
+        w = ue_pool_find_word(subnet, w + 1);
+        bits = ~subnet->pool.bits[w];
+    }
+    ogs_assert(bits);
+
+    slot = w * 64 + __builtin_ctzll(bits);
+    ogs_assert(slot < subnet->pool.size);
+
+    ue_pool_set(subnet, slot);
+    subnet->pool.avail--;
+
+    subnet->pool.next = slot + 1;
+    if (subnet->pool.next >= subnet->pool.size)
+        subnet->pool.next = 0;
+
+    return slot;
+}
+
+static void ue_pool_free(ogs_pfcp_subnet_t *subnet, uint32_t slot)
+{
+    ogs_assert(slot < subnet->pool.size);
+    ogs_assert(ue_pool_isset(subnet, slot));
+
+    ue_pool_clear(subnet, slot);
+    subnet->pool.avail++;
+}
+
+static int ue_pool_lastindex(ogs_pfcp_subnet_t *subnet)
+{
+    /* IPv6 : Default Prefixlen 64bits */
+    return subnet->family == AF_INET6 ? 1 : 0;
+}
+
+static void ue_pool_slot_to_addr(
+        ogs_pfcp_subnet_t *subnet, uint32_t slot, uint32_t *addr)
+{
+    int i, lastindex;
+    uint32_t offset;
+
+    lastindex = ue_pool_lastindex(subnet);
+
+    for (i = subnet->pool.num_of_block - 1; i > 0; i--)
+        if (slot >= subnet->pool.block[i].base)
+            break;
+
+    offset = slot - subnet->pool.block[i].base;
+    ogs_assert(offset < subnet->pool.block[i].count);
+
+    memset(addr, 0, sizeof(uint32_t) * 4);
+    memcpy(addr, subnet->pool.block[i].start,
+            sizeof(uint32_t) * (lastindex + 1));
+    addr[lastindex] = htobe32(be32toh(addr[lastindex]) + offset);
+
+    /* Allocate Full IPv6 Address */
+    if (lastindex == 1)
+        addr[3] = htobe32(offset + 1);
+}
+
+static uint32_t ue_pool_addr_to_slot(
+        ogs_pfcp_subnet_t *subnet, const uint32_t *addr)
+{
+    int i, lastindex;
+    uint32_t offset;
+
+    lastindex = ue_pool_lastindex(subnet);
+
+    for (i = 0; i < subnet->pool.num_of_block; i++) {
+        if (lastindex == 1 && addr[0] != subnet->pool.block[i].start[0])
+            continue;
+
+        offset = be32toh(addr[lastindex]) -
+            be32toh(subnet->pool.block[i].start[lastindex]);
+        if (offset < subnet->pool.block[i].count)
+            return subnet->pool.block[i].base + offset;
+    }
+
+    return OGS_PFCP_UE_IP_NO_SLOT;
+}
+
+static void ue_pool_reserve(ogs_pfcp_subnet_t *subnet, const uint32_t *addr)
+{
+    uint32_t slot = ue_pool_addr_to_slot(subnet, addr);
+
+    if (slot != OGS_PFCP_UE_IP_NO_SLOT && !ue_pool_isset(subnet, slot)) {
+        ue_pool_set(subnet, slot);
+        subnet->pool.avail--;
+        subnet->pool.reserved++;
+    }
+}
+
 int ogs_pfcp_ue_pool_generate(void)
 {
     int i, rv;
@@ -1838,19 +2236,17 @@ int ogs_pfcp_ue_pool_generate(void)
         int lastindex = 0;
         uint32_t start[4], end[4], broadcast[4];
         int rangeindex, num_of_range;
-        int poolindex;
-        int inc;
+        uint32_t size, count, nwords;
 
         if (subnet->family == AF_INET) {
             maxbytes = 4;
-            lastindex = 0;
         } else if (subnet->family == AF_INET6) {
             maxbytes = 8; /* Default Prefixlen 64bits */
-            lastindex = 1;
         } else {
             /* subnet->family might be AF_UNSPEC. So, skip it */
             continue;
         }
+        lastindex = ue_pool_lastindex(subnet);
 
         for (i = 0; i < 4; i++) {
             broadcast[i] = subnet->sub.sub[i] + ~subnet->sub.mask[i];
@@ -1859,7 +2255,11 @@ int ogs_pfcp_ue_pool_generate(void)
         num_of_range = subnet->num_of_range;
         if (!num_of_range) num_of_range = 1;
 
-        poolindex = 0;
+        /*
+         * Only the ranges are kept. As before, the number of addresses
+         * is limited by the number of sessions.
+         */
+        size = 0;
         for (rangeindex = 0; rangeindex < num_of_range; rangeindex++) {
 
             if (subnet->num_of_range &&
@@ -1877,49 +2277,53 @@ int ogs_pfcp_ue_pool_generate(void)
                 ogs_ipsubnet_t high;
                 rv = ogs_ipsubnet(&high, subnet->range[rangeindex].high, NULL);
                 ogs_assert(rv == OGS_OK);
-                high.sub[lastindex] += htobe32(1);
                 memcpy(end, high.sub, maxbytes);
+                end[lastindex] = htobe32(be32toh(end[lastindex]) + 1);
             } else {
                 memcpy(end, broadcast, maxbytes);
             }
 
-            inc = 0;
-            while(poolindex < ogs_app()->pool.sess) {
-                ogs_pfcp_ue_ip_t *ue_ip = NULL;
+            count = be32toh(end[lastindex]) - be32toh(start[lastindex]);
+            if (count > ogs_app()->pool.sess - size)
+                count = ogs_app()->pool.sess - size;
+            if (!count)
+                continue;
 
-                ue_ip = &subnet->pool.array[poolindex];
-                ogs_assert(ue_ip);
-                memset(ue_ip, 0, sizeof *ue_ip);
-                ue_ip->subnet = subnet;
+            i = subnet->pool.num_of_block++;
+            memset(subnet->pool.block[i].start, 0,
+                    sizeof(subnet->pool.block[i].start));
+            memcpy(subnet->pool.block[i].start, start, maxbytes);
+            subnet->pool.block[i].base = size;
+            subnet->pool.block[i].count = count;
 
-                memcpy(ue_ip->addr, start, maxbytes);
-                ue_ip->addr[lastindex] += htobe32(inc);
-                inc++;
+            size += count;
+        }
 
-                if (memcmp(ue_ip->addr, end, maxbytes) == 0)
-                    break;
+        if (!size)
+            continue;
 
-                /* Exclude Network Address */
-                if (memcmp(ue_ip->addr, subnet->sub.sub, maxbytes) == 0)
-                    continue;
+        nwords = UE_POOL_WORDS(size);
+        subnet->pool.bits = calloc(nwords, sizeof(uint64_t));
+        ogs_assert(subnet->pool.bits);
+        subnet->pool.full = calloc(UE_POOL_WORDS(nwords), sizeof(uint64_t));
+        ogs_assert(subnet->pool.full);
+        subnet->pool.size = subnet->pool.avail = size;
 
-                /* Exclude TUN IP Address */
-                if (memcmp(ue_ip->addr, subnet->gw.sub, maxbytes) == 0)
-                    continue;
+        /* The bits after the last slot are never allocated */
+        if (size % 64)
+            subnet->pool.bits[nwords-1] = UINT64_MAX << (size % 64);
+        for (i = nwords; i < UE_POOL_WORDS(nwords) * 64; i++)
+            subnet->pool.full[i / 64] |= (1ULL << (i % 64));
 
-                /* Allocate Full IPv6 Address */
-                if (lastindex == 1)
-                    ue_ip->addr[3] += htobe32(inc);
+        /* Exclude Network Address */
+        ue_pool_reserve(subnet, subnet->sub.sub);
 
-                ogs_trace("[%d] - %x:%x:%x:%x",
-                        poolindex,
-                        ue_ip->addr[0], ue_ip->addr[1],
-                        ue_ip->addr[2], ue_ip->addr[3]);
+        /* Exclude TUN IP Address */
+        ue_pool_reserve(subnet, subnet->gw.sub);
 
-                poolindex++;
-            }
-        }
-        subnet->pool.size = subnet->pool.avail = poolindex;
+        ogs_debug("UE Pool [%s] %d ranges, %d addresses",
+                subnet->dnn[0] ? subnet->dnn : "-",
+                subnet->pool.num_of_block, subnet->pool.avail);
     }
 
     return OGS_OK;
@@ -1956,25 +2360,52 @@ ogs_pfcp_ue_ip_t *ogs_pfcp_ue_ip_alloc(
         return NULL;
     }
 
+    ogs_pool_alloc(&ogs_pfcp_ue_ip_pool, &ue_ip);
+    if (!ue_ip) {
+        ogs_error("No resources available");
+        *cause_value = OGS_PFCP_CAUSE_NO_RESOURCES_AVAILABLE;
+        return NULL;
+    }
+    memset(ue_ip, 0, sizeof *ue_ip);
+    ue_ip->subnet = subnet;
+    ue_ip->slot = OGS_PFCP_UE_IP_NO_SLOT;
+
     /* if assigning a static IP, do so. If not, assign dynamically! */
     if (memcmp(addr, zero, maxbytes) != 0) {
-        ue_ip = ogs_calloc(1, sizeof(ogs_pfcp_ue_ip_t));
-        if (!ue_ip) {
-            ogs_error("All dynamic addresses are occupied");
-            *cause_value = OGS_PFCP_CAUSE_ALL_DYNAMIC_ADDRESS_ARE_OCCUPIED;
-            return NULL;
-        }
-
-        ue_ip->subnet = subnet;
         ue_ip->static_ip = true;
         memcpy(ue_ip->addr, addr, maxbytes);
+
+        /* Reserve it if the static IP is in the dynamic pool */
+        if (subnet->pool.size) {
+            uint32_t slot = ue_pool_addr_to_slot(subnet, ue_ip->addr);
+            if (slot != OGS_PFCP_UE_IP_NO_SLOT) {
+                if (ue_pool_isset(subnet, slot) == false) {
+                    ue_pool_set(subnet, slot);
+                    subnet->pool.avail--;
+                    ue_ip->slot = slot;
+                } else {
+                    ogs_warn("Static IP is already in use "
+                            "[%08x:%08x:%08x:%08x]",
+                            be32toh(ue_ip->addr[0]), be32toh(ue_ip->addr[1]),
+                            be32toh(ue_ip->addr[2]), be32toh(ue_ip->addr[3]));
+                }
+            }
+        }
     } else {
-        ogs_pool_alloc(&subnet->pool, &ue_ip);
-        if (!ue_ip) {
-            ogs_error("No resources available");
-            *cause_value = OGS_PFCP_CAUSE_NO_RESOURCES_AVAILABLE;
+        ue_ip->slot = ue_pool_alloc(subnet);
+        if (ue_ip->slot == OGS_PFCP_UE_IP_NO_SLOT) {
+            ogs_error("All dynamic addresses are occupied");
+            *cause_value = OGS_PFCP_CAUSE_ALL_DYNAMIC_ADDRESS_ARE_OCCUPIED;
+            ogs_pool_free(&ogs_pfcp_ue_ip_pool, ue_ip);
             return NULL;
         }
+
+        ue_pool_slot_to_addr(subnet, ue_ip->slot, ue_ip->addr);
+
+        ogs_trace("[%d] - %x:%x:%x:%x",
+                ue_ip->slot,
+                ue_ip->addr[0], ue_ip->addr[1],
+                ue_ip->addr[2], ue_ip->addr[3]);
     }
 
     return ue_ip;
@@ -1989,11 +2420,22 @@ void ogs_pfcp_ue_ip_free(ogs_pfcp_ue_ip_t *ue_ip)
 
     ogs_assert(subnet);
 
-    if (ue_ip->static_ip) {
-        ogs_free(ue_ip);
-    } else {
-        ogs_pool_free(&subnet->pool, ue_ip);
-    }
+    if (ue_ip->slot != OGS_PFCP_UE_IP_NO_SLOT)
+        ue_pool_free(subnet, ue_ip->slot);
+
+    ogs_pool_free(&ogs_pfcp_ue_ip_pool, ue_ip);
+}
+
+/* Returns the number of addresses in use */
+uint32_t ogs_pfcp_ue_pool_occupancy(
+        ogs_pfcp_subnet_t *subnet, uint32_t *size)
+{
+    ogs_assert(subnet);
+
+    if (size)
+        *size = subnet->pool.size - subnet->pool.reserved;
+
+    return subnet->pool.size - subnet->pool.reserved - subnet->pool.avail;
 }
 
 ogs_pfcp_dev_t *ogs_pfcp_dev_add(const char *ifname)
@@ -2079,8 +2521,6 @@ ogs_pfcp_subnet_t *ogs_pfcp_subnet_add(
     if (dnn)
         strcpy(subnet->dnn, dnn);
 
-    ogs_pool_init(&subnet->pool, ogs_app()->pool.sess);
-
     ogs_list_add(&self.subnet_list, subnet);
 
     return subnet;
@@ -2092,7 +2532,14 @@ void ogs_pfcp_subnet_remove(ogs_pfcp_subnet_t *subnet)
 
     ogs_list_remove(&self.subnet_list, subnet);
 
-    ogs_pool_final(&subnet->pool);
+    if (ogs_pfcp_ue_pool_occupancy(subnet, NULL))
+        ogs_error("%d in UE Pool [%s] were not released.",
+                ogs_pfcp_ue_pool_occupancy(subnet, NULL),
+                subnet->dnn[0] ? subnet->dnn : "-");
+    if (subnet->pool.bits)
+        free(subnet->pool.bits);
+    if (subnet->pool.full)
+        free(subnet->pool.full);
 
     ogs_pool_free(&ogs_pfcp_subnet_pool, subnet);
 }
@@ -2114,7 +2561,7 @@ ogs_pfcp_subnet_t *ogs_pfcp_find_subnet(int family)
     ogs_list_for_each(&self.subnet_list, subnet) {
         if ((subnet->family == AF_UNSPEC || subnet->family == family) &&
             (strlen(subnet->dnn) == 0) &&
-            subnet->pool.avail)
+            (subnet->family == AF_UNSPEC || subnet->pool.avail))
             break;
     }
 
@@ -2132,7 +2579,7 @@ ogs_pfcp_subnet_t *ogs_pfcp_find_subnet_by_dnn(int family, const char *dnn)
         if ((subnet->family == AF_UNSPEC || subnet->family == family) &&
             (strlen(subnet->dnn) == 0 ||
                 (strlen(subnet->dnn) && ogs_strcasecmp(subnet->dnn, dnn) == 0)) &&
-            subnet->pool.avail)
+            (subnet->family == AF_UNSPEC || subnet->pool.avail))
             break;
     }
 
@@ -72,6 +72,16 @@ typedef struct ogs_pfcp_context_s {
     ogs_hash_t      *object_teid_hash; /* hash table for PFCP OBJ(TEID) */
     ogs_hash_t      *far_f_teid_hash;  /* hash table for FAR(TEID+ADDR) */
     ogs_hash_t      *far_teid_hash; /* hash table for FAR(TEID) */
+
+    /* Downlink Data Buffering */
+    struct {
+        uint64_t    bytes;          /* Bytes buffered in all FARs */
+        ogs_hash_t  *dnn_hash;      /* Bytes buffered per DNN */
+
+        uint64_t    buffered;       /* Num of buffered packets */
+        uint64_t    dropped;        /* Num of dropped packets */
+        uint64_t    flushed;        /* Num of flushed packets */
+    } buffer;
 } ogs_pfcp_context_t;
 
 #define OGS_SETUP_PFCP_NODE(__cTX, __pNODE) \
@@ -91,6 +101,8 @@ typedef struct ogs_pfcp_node_s {
 
     ogs_list_t      local_list;
     ogs_list_t      remote_list;
+    ogs_hash_t      *local_hash;    /* Local transactions indexed by xid */
+    ogs_hash_t      *remote_hash;   /* Remote transactions indexed by xid */
 
     ogs_fsm_t       sm;             /* A state machine */
     ogs_timer_t     *t_association; /* timer to retry to associate peer node */
@@ -105,6 +117,15 @@ typedef struct ogs_pfcp_node_s {
     uint64_t        nr_cell_id[OGS_MAX_NUM_OF_CELL_ID];
     uint8_t         num_of_nr_cell_id;
 
+    int             weight;         /* Weight for UPF selection */
+    int             current_weight; /* Smooth weighted round-robin */
+
+    /* PFCP Load Control Information from the peer */
+    struct {
+        uint32_t    sequence_number;
+        uint8_t     metric;         /* 0(no load) ~ 100(maximum load) */
+    } load;
+
     uint32_t        remote_recovery; /* UTC time */
     bool            restoration_required;
 
@@ -229,8 +250,13 @@ typedef struct ogs_pfcp_far_s {
 
     ogs_pfcp_smreq_flags_t  smreq_flags;
 
-    uint32_t                num_of_buffered_packet;
-    ogs_pkbuf_t             *buffered_packet[OGS_MAX_NUM_OF_PACKET_BUFFER];
+    /* Downlink packets queued while the FAR is buffering */
+    struct {
+        ogs_list_t          list;
+        uint32_t            num_of_packet;
+        uint64_t            bytes;
+        struct ogs_pfcp_dnn_buffer_s *dnn;
+    } buffer;
 
     struct {
         bool prepared;
@@ -308,13 +334,23 @@ typedef struct ogs_pfcp_sess_s {
     OGS_POOL(urr_id_pool, uint8_t);
     OGS_POOL(qer_id_pool, uint8_t);
     OGS_POOL(bar_id_pool, uint8_t);
+
+    uint64_t            buffered_bytes; /* Bytes buffered in all FARs */
 } ogs_pfcp_sess_t;
 
+typedef struct ogs_pfcp_dnn_buffer_s {
+    char                *dnn;
+    uint64_t            bytes;          /* Bytes buffered for this DNN */
+} ogs_pfcp_dnn_buffer_t;
+
 typedef struct ogs_pfcp_subnet_s ogs_pfcp_subnet_t;
 typedef struct ogs_pfcp_ue_ip_s {
     uint32_t        addr[4];
     bool            static_ip;
 
+#define OGS_PFCP_UE_IP_NO_SLOT UINT32_MAX
+    uint32_t        slot;           /* Bit in the subnet bitmap */
+
     /* Related Context */
     ogs_pfcp_subnet_t    *subnet;
 } ogs_pfcp_ue_ip_t;
@@ -346,7 +382,29 @@ typedef struct ogs_pfcp_subnet_s {
 
     int             family;         /* AF_INET or AF_INET6 */
     uint8_t         prefixlen;      /* prefixlen */
-    OGS_POOL(pool, ogs_pfcp_ue_ip_t);
+
+    /*
+     * UE IP Address Pool
+     *
+     * Each address is a slot in the bitmap, and is calculated from
+     * the range(block) which contains the slot. 'full' has one bit
+     * for each word of 'bits' to skip the fully occupied words.
+     */
+    struct {
+        struct {
+            uint32_t start[4];      /* First address of the range */
+            uint32_t base;          /* First slot of the range */
+            uint32_t count;         /* Number of slots in the range */
+        } block[OGS_MAX_NUM_OF_SUBNET_RANGE];
+        int num_of_block;
+
+        uint64_t *bits;             /* 1 if the address is used */
+        uint64_t *full;             /* 1 if the word of 'bits' is full */
+        uint32_t size;              /* Number of slots */
+        uint32_t avail;             /* Number of free slots */
+        uint32_t reserved;          /* Network and TUN address */
+        uint32_t next;              /* Next-fit cursor */
+    } pool;
 
     ogs_pfcp_dev_t  *dev;           /* Related Context */
 } ogs_pfcp_subnet_t;
@@ -439,6 +497,11 @@ ogs_pfcp_far_t *ogs_pfcp_far_find_by_teid(uint32_t teid);
 void ogs_pfcp_far_remove(ogs_pfcp_far_t *far);
 void ogs_pfcp_far_remove_all(ogs_pfcp_sess_t *sess);
 
+bool ogs_pfcp_far_buffer_packet(
+        ogs_pfcp_far_t *far, const char *dnn, ogs_pkbuf_t *pkbuf);
+ogs_pkbuf_t *ogs_pfcp_far_dequeue_packet(ogs_pfcp_far_t *far);
+void ogs_pfcp_far_clear_buffer(ogs_pfcp_far_t *far);
+
 ogs_pfcp_urr_t *ogs_pfcp_urr_add(ogs_pfcp_sess_t *sess);
 ogs_pfcp_urr_t *ogs_pfcp_urr_find(
         ogs_pfcp_sess_t *sess, ogs_pfcp_urr_id_t id);
@@ -468,6 +531,8 @@ int ogs_pfcp_ue_pool_generate(void);
 ogs_pfcp_ue_ip_t *ogs_pfcp_ue_ip_alloc(
         uint8_t *cause_value, int family, const char *dnn, uint8_t *addr);
 void ogs_pfcp_ue_ip_free(ogs_pfcp_ue_ip_t *ip);
+uint32_t ogs_pfcp_ue_pool_occupancy(
+        ogs_pfcp_subnet_t *subnet, uint32_t *size);
 
 ogs_pfcp_dev_t *ogs_pfcp_dev_add(const char *ifname);
 void ogs_pfcp_dev_remove(ogs_pfcp_dev_t *dev);
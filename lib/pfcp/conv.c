@@ -474,3 +474,57 @@ void ogs_pfcp_outer_header_creation_to_ip(
         memcpy(ip->addr6, outer_header_creation->addr6, OGS_IPV6_LEN);
     }
 }
+
+int ogs_pfcp_ip_to_remote_gtp_u_peer(ogs_ip_t *ip,
+        ogs_pfcp_remote_gtp_u_peer_t *remote_gtp_u_peer, int *len)
+{
+    const int hdr_len = 1;
+
+    ogs_assert(ip);
+    ogs_assert(remote_gtp_u_peer);
+    memset(remote_gtp_u_peer, 0, sizeof *remote_gtp_u_peer);
+
+    if (ip->ipv4 && ip->ipv6) {
+        remote_gtp_u_peer->ipv4 = 1;
+        remote_gtp_u_peer->both.addr = ip->addr;
+        remote_gtp_u_peer->ipv6 = 1;
+        memcpy(remote_gtp_u_peer->both.addr6, ip->addr6, OGS_IPV6_LEN);
+        *len = OGS_IPV4V6_LEN + hdr_len;
+    } else if (ip->ipv4) {
+        remote_gtp_u_peer->ipv4 = 1;
+        remote_gtp_u_peer->addr = ip->addr;
+        *len = OGS_IPV4_LEN + hdr_len;
+    } else if (ip->ipv6) {
+        remote_gtp_u_peer->ipv6 = 1;
+        memcpy(remote_gtp_u_peer->addr6, ip->addr6, OGS_IPV6_LEN);
+        *len = OGS_IPV6_LEN + hdr_len;
+    } else {
+        ogs_error("No IPv4 or IPv6");
+        return OGS_ERROR;
+    }
+
+    return OGS_OK;
+}
+
+void ogs_pfcp_remote_gtp_u_peer_to_ip(
+        ogs_pfcp_remote_gtp_u_peer_t *remote_gtp_u_peer, ogs_ip_t *ip)
+{
+    ogs_assert(remote_gtp_u_peer);
+    ogs_assert(ip);
+    memset(ip, 0, sizeof *ip);
+
+    if (remote_gtp_u_peer->ipv4 && remote_gtp_u_peer->ipv6) {
+        ip->ipv4 = 1; ip->ipv6 = 1;
+        ip->len = OGS_IPV4V6_LEN;
+        ip->addr = remote_gtp_u_peer->both.addr;
+        memcpy(ip->addr6, remote_gtp_u_peer->both.addr6, OGS_IPV6_LEN);
+    } else if (remote_gtp_u_peer->ipv4) {
+        ip->ipv4 = 1;
+        ip->len = OGS_IPV4_LEN;
+        ip->addr = remote_gtp_u_peer->addr;
+    } else if (remote_gtp_u_peer->ipv6) {
+        ip->ipv6 = 1;
+        ip->len = OGS_IPV6_LEN;
+        memcpy(ip->addr6, remote_gtp_u_peer->addr6, OGS_IPV6_LEN);
+    }
+}
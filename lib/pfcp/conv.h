@@ -55,6 +55,11 @@ int ogs_pfcp_ip_to_outer_header_creation(ogs_ip_t *ip,
 void ogs_pfcp_outer_header_creation_to_ip(
     ogs_pfcp_outer_header_creation_t *outer_header_creation, ogs_ip_t *ip);
 
+int ogs_pfcp_ip_to_remote_gtp_u_peer(ogs_ip_t *ip,
+    ogs_pfcp_remote_gtp_u_peer_t *remote_gtp_u_peer, int *len);
+void ogs_pfcp_remote_gtp_u_peer_to_ip(
+    ogs_pfcp_remote_gtp_u_peer_t *remote_gtp_u_peer, ogs_ip_t *ip);
+
 #ifdef __cplusplus
 }
 #endif
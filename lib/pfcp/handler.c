@@ -186,6 +186,117 @@ bool ogs_pfcp_cp_handle_association_setup_response(
     return true;
 }
 
+void ogs_pfcp_cp_handle_load_control_information(ogs_pfcp_node_t *node,
+        ogs_pfcp_tlv_load_control_information_t *message)
+{
+    uint32_t sequence_number;
+    uint8_t metric;
+
+    ogs_assert(node);
+    ogs_assert(message);
+
+    if (message->presence == 0)
+        return;
+
+    if (message->load_control_sequence_number.presence == 0 ||
+        message->load_control_sequence_number.len != sizeof(uint32_t) ||
+        message->load_metric.presence == 0 ||
+        message->load_metric.len != sizeof(uint8_t)) {
+        ogs_error("Invalid Load Control Information");
+        return;
+    }
+
+    memcpy(&sequence_number,
+            message->load_control_sequence_number.data, sizeof(uint32_t));
+    sequence_number = be32toh(sequence_number);
+    metric = *(uint8_t *)message->load_metric.data;
+
+    /*
+     * Ignore outdated information whose sequence number is not higher
+     * than the one received before (with wrap-around).
+     */
+    if (node->load.sequence_number &&
+        (int32_t)(sequence_number - node->load.sequence_number) <= 0)
+        return;
+
+    if (metric > 100) {
+        ogs_error("Invalid Load Metric [%d]", metric);
+        return;
+    }
+
+    node->load.sequence_number = sequence_number;
+    node->load.metric = metric;
+}
+
+static void remote_gtp_u_peer_log(ogs_pfcp_node_t *node,
+        const char *what, ogs_pfcp_tlv_remote_gtp_u_peer_t *message)
+{
+    ogs_pfcp_remote_gtp_u_peer_t remote_gtp_u_peer;
+    ogs_ip_t ip;
+    char buf[OGS_ADDRSTRLEN];
+    char buf1[OGS_ADDRSTRLEN];
+
+    if (message->presence == 0 || message->len == 0 ||
+        message->len > sizeof(remote_gtp_u_peer)) {
+        ogs_error("Invalid Remote GTP-U Peer");
+        return;
+    }
+
+    memset(&remote_gtp_u_peer, 0, sizeof(remote_gtp_u_peer));
+    memcpy(&remote_gtp_u_peer, message->data, message->len);
+    ogs_pfcp_remote_gtp_u_peer_to_ip(&remote_gtp_u_peer, &ip);
+
+    if (ip.ipv4)
+        OGS_INET_NTOP(&ip.addr, buf1);
+    else if (ip.ipv6)
+        OGS_INET6_NTOP(ip.addr6, buf1);
+    else
+        strcpy(buf1, "Unknown");
+
+    ogs_warn("[%s] User Plane Path %s : Remote GTP-U Peer [%s]",
+            OGS_ADDR(&node->addr, buf), what, buf1);
+}
+
+bool ogs_pfcp_cp_handle_node_report_request(
+        ogs_pfcp_node_t *node, ogs_pfcp_xact_t *xact,
+        ogs_pfcp_node_report_request_t *req)
+{
+    int rv;
+    ogs_pfcp_node_report_type_t report_type;
+
+    ogs_assert(node);
+    ogs_assert(xact);
+    ogs_assert(req);
+
+    if (req->node_report_type.presence == 0 ||
+        req->node_report_type.len < 1) {
+        ogs_error("No Node Report Type");
+        ogs_expect(OGS_OK == ogs_pfcp_cp_send_node_report_response(
+                    xact, OGS_PFCP_CAUSE_MANDATORY_IE_MISSING));
+        return false;
+    }
+
+    report_type.value = *(uint8_t *)req->node_report_type.data;
+
+    if (report_type.user_plane_path_failure_report &&
+        req->user_plane_path_failure_report.presence)
+        remote_gtp_u_peer_log(node, "Failure",
+            &req->user_plane_path_failure_report.remote_gtp_u_peer);
+    if (report_type.user_plane_path_recovery_report &&
+        req->user_plane_path_recovery_report.presence)
+        remote_gtp_u_peer_log(node, "Recovery",
+            &req->user_plane_path_recovery_report.remote_gtp_u_peer);
+
+    rv = ogs_pfcp_cp_send_node_report_response(
+            xact, OGS_PFCP_CAUSE_REQUEST_ACCEPTED);
+    if (rv != OGS_OK) {
+        ogs_error("ogs_pfcp_cp_send_node_report_response() failed");
+        return false;
+    }
+
+    return true;
+}
+
 bool ogs_pfcp_up_handle_association_setup_request(
         ogs_pfcp_node_t *node, ogs_pfcp_xact_t *xact,
         ogs_pfcp_association_setup_request_t *req)
@@ -217,6 +328,33 @@ bool ogs_pfcp_up_handle_association_setup_response(
     return true;
 }
 
+bool ogs_pfcp_up_handle_node_report_response(
+        ogs_pfcp_node_t *node, ogs_pfcp_xact_t *xact,
+        ogs_pfcp_node_report_response_t *rsp)
+{
+    ogs_assert(xact);
+    ogs_assert(rsp);
+
+    ogs_pfcp_xact_commit(xact);
+
+    if (rsp->cause.presence == 0) {
+        ogs_error("No Cause");
+        return false;
+    }
+
+    if (rsp->cause.u8 != OGS_PFCP_CAUSE_REQUEST_ACCEPTED) {
+        ogs_warn("Node Report rejected [Cause:%d]", rsp->cause.u8);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * The received packet is forwarded or buffered in place: the outer GTP-U
+ * header is pushed into the headroom left by the receiver. The caller hands
+ * over 'recvbuf' and must not use or free it after this call.
+ */
 bool ogs_pfcp_up_handle_pdr(
         ogs_pfcp_pdr_t *pdr, uint8_t type,
         ogs_gtp2_header_desc_t *recvhdr, ogs_pkbuf_t *recvbuf,
@@ -236,11 +374,7 @@ bool ogs_pfcp_up_handle_pdr(
 
     memset(report, 0, sizeof(*report));
 
-    sendbuf = ogs_pkbuf_copy(recvbuf);
-    if (!sendbuf) {
-        ogs_error("ogs_pkbuf_copy() failed");
-        return false;
-    }
+    sendbuf = recvbuf;
 
     buffering = false;
 
@@ -269,6 +403,13 @@ bool ogs_pfcp_up_handle_pdr(
                 }
             }
 
+            /*
+             * The FAR has just been switched back to FORW. Flush what was
+             * buffered first so that the downlink packets stay in order.
+             */
+            if (far->buffer.num_of_packet)
+                ogs_pfcp_send_buffered_packet(pdr);
+
             ogs_pfcp_send_g_pdu(pdr, &sendhdr, sendbuf);
 
         } else if (far->apply_action & OGS_PFCP_APPLY_ACTION_BUFF) {
@@ -283,17 +424,13 @@ bool ogs_pfcp_up_handle_pdr(
 
     if (buffering == true) {
 
-        if (far->num_of_buffered_packet == 0) {
+        if (far->buffer.num_of_packet == 0) {
             /* Only the first time a packet is buffered,
              * it reports downlink notifications. */
             report->type.downlink_data_report = 1;
         }
 
-        if (far->num_of_buffered_packet < OGS_MAX_NUM_OF_PACKET_BUFFER) {
-            far->buffered_packet[far->num_of_buffered_packet++] = sendbuf;
-        } else {
-            ogs_pkbuf_free(sendbuf);
-        }
+        ogs_pfcp_far_buffer_packet(far, pdr->dnn, sendbuf);
     }
 
     return true;
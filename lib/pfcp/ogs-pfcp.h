@@ -23,6 +23,7 @@
 #include "pfcp/pfcp-config.h"
 
 #include "gtp/ogs-gtp.h"
+#include "metrics/ogs-metrics.h"
 
 #define OGS_PFCP_UDP_PORT               8805
 
@@ -43,6 +44,7 @@
 #include "pfcp/path.h"
 #include "pfcp/xact.h"
 #include "pfcp/handler.h"
+#include "pfcp/metrics.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -343,6 +343,77 @@ int ogs_pfcp_up_send_association_setup_response(ogs_pfcp_xact_t *xact,
     return rv;
 }
 
+int ogs_pfcp_up_send_node_report_request(ogs_pfcp_node_t *node,
+        ogs_pfcp_node_report_type_t report_type, ogs_ip_t *remote_peer)
+{
+    int rv;
+    ogs_pkbuf_t *pkbuf = NULL;
+    ogs_pfcp_header_t h;
+    ogs_pfcp_xact_t *xact = NULL;
+
+    ogs_assert(node);
+    ogs_assert(remote_peer);
+
+    memset(&h, 0, sizeof(ogs_pfcp_header_t));
+    h.type = OGS_PFCP_NODE_REPORT_REQUEST_TYPE;
+    h.seid = 0;
+
+    xact = ogs_pfcp_xact_local_create(node, NULL, node);
+    if (!xact) {
+        ogs_error("ogs_pfcp_xact_local_create() failed");
+        return OGS_ERROR;
+    }
+
+    pkbuf = ogs_pfcp_up_build_node_report_request(
+            h.type, report_type, remote_peer);
+    if (!pkbuf) {
+        ogs_error("ogs_pfcp_up_build_node_report_request() failed");
+        return OGS_ERROR;
+    }
+
+    rv = ogs_pfcp_xact_update_tx(xact, &h, pkbuf);
+    if (rv != OGS_OK) {
+        ogs_error("ogs_pfcp_xact_update_tx() failed");
+        return OGS_ERROR;
+    }
+
+    rv = ogs_pfcp_xact_commit(xact);
+    ogs_expect(rv == OGS_OK);
+
+    return rv;
+}
+
+int ogs_pfcp_cp_send_node_report_response(ogs_pfcp_xact_t *xact,
+        uint8_t cause)
+{
+    int rv;
+    ogs_pkbuf_t *pkbuf = NULL;
+    ogs_pfcp_header_t h;
+
+    ogs_assert(xact);
+
+    memset(&h, 0, sizeof(ogs_pfcp_header_t));
+    h.type = OGS_PFCP_NODE_REPORT_RESPONSE_TYPE;
+    h.seid = 0;
+
+    pkbuf = ogs_pfcp_cp_build_node_report_response(h.type, cause);
+    if (!pkbuf) {
+        ogs_error("ogs_pfcp_cp_build_node_report_response() failed");
+        return OGS_ERROR;
+    }
+
+    rv = ogs_pfcp_xact_update_tx(xact, &h, pkbuf);
+    if (rv != OGS_OK) {
+        ogs_error("ogs_pfcp_xact_update_tx() failed");
+        return OGS_ERROR;
+    }
+
+    rv = ogs_pfcp_xact_commit(xact);
+    ogs_expect(rv == OGS_OK);
+
+    return rv;
+}
+
 void ogs_pfcp_send_g_pdu(
         ogs_pfcp_pdr_t *pdr,
         ogs_gtp2_header_desc_t *sendhdr, ogs_pkbuf_t *sendbuf)
@@ -446,23 +517,21 @@ int ogs_pfcp_send_end_marker(ogs_pfcp_pdr_t *pdr)
 void ogs_pfcp_send_buffered_packet(ogs_pfcp_pdr_t *pdr)
 {
     ogs_pfcp_far_t *far = NULL;
-    int i;
 
     ogs_assert(pdr);
     far = pdr->far;
 
     if (far && far->gnode) {
         if (far->apply_action & OGS_PFCP_APPLY_ACTION_FORW) {
-            for (i = 0; i < far->num_of_buffered_packet; i++) {
-                ogs_gtp2_header_desc_t sendhdr;
+            ogs_gtp2_header_desc_t sendhdr;
+            ogs_pkbuf_t *pkbuf = NULL;
 
-                memset(&sendhdr, 0, sizeof(sendhdr));
-                sendhdr.type = OGS_GTPU_MSGTYPE_GPDU;
+            memset(&sendhdr, 0, sizeof(sendhdr));
+            sendhdr.type = OGS_GTPU_MSGTYPE_GPDU;
 
-                ogs_pfcp_send_g_pdu(
-                        pdr, &sendhdr, far->buffered_packet[i]);
-            }
-            far->num_of_buffered_packet = 0;
+            /* Drain the whole queue in one pass, oldest packet first */
+            while ((pkbuf = ogs_pfcp_far_dequeue_packet(far)) != NULL)
+                ogs_pfcp_send_g_pdu(pdr, &sendhdr, pkbuf);
         }
     }
 }
@@ -78,6 +78,11 @@ int ogs_pfcp_up_send_association_setup_request(ogs_pfcp_node_t *node,
 int ogs_pfcp_up_send_association_setup_response(ogs_pfcp_xact_t *xact,
         uint8_t cause);
 
+int ogs_pfcp_up_send_node_report_request(ogs_pfcp_node_t *node,
+        ogs_pfcp_node_report_type_t report_type, ogs_ip_t *remote_peer);
+int ogs_pfcp_cp_send_node_report_response(ogs_pfcp_xact_t *xact,
+        uint8_t cause);
+
 void ogs_pfcp_send_g_pdu(
         ogs_pfcp_pdr_t *pdr,
         ogs_gtp2_header_desc_t *sendhdr, ogs_pkbuf_t *sendbuf);
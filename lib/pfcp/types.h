@@ -1069,6 +1069,58 @@ ED8(uint8_t     spare:1;,
     };
 } __attribute__ ((packed)) ogs_pfcp_report_type_t;
 
+/*
+ * 8.2.69 Node Report Type
+ *
+ * - Bit 1 – UPFR (User Plane Path Failure Report): when set to "1",
+ *           this indicates a User Plane Path Failure Report.
+ * - Bit 2 – UPRR (User Plane Path Recovery Report): when set to "1",
+ *           this indicates a User Plane Path Recovery Report.
+ * - Bit 3 – CKDR (Clock Drift Report)
+ * - Bit 4 – GPQR (GTP-U Path QoS Report)
+ * - Bit 5 – PURR (Peer GTP-U entity Restart Report)
+ * - Bit 6 to 8 – Spare, for future use and set to "0".
+ */
+typedef struct ogs_pfcp_node_report_type_s {
+    union {
+        struct {
+ED6(uint8_t     spare:3;,
+    uint8_t     peer_restart_report:1;,
+    uint8_t     gtpu_path_qos_report:1;,
+    uint8_t     clock_drift_report:1;,
+    uint8_t     user_plane_path_recovery_report:1;,
+    uint8_t     user_plane_path_failure_report:1;)
+        };
+        uint8_t value;
+    };
+} __attribute__ ((packed)) ogs_pfcp_node_report_type_t;
+
+/*
+ * 8.2.70 Remote GTP-U Peer
+ *
+ * - Bit 1 – V6: If this bit is set to "1", then the IPv6 address field
+ *   shall be present, otherwise the IPv6 address field shall not be present.
+ * - Bit 2 – V4: If this bit is set to "1", then the IPv4 address field
+ *   shall be present, otherwise the IPv4 address field shall not be present.
+ * - Bit 3 – DI (Destination Interface) and Bit 4 – NI (Network Instance)
+ *   are not used and set to "0".
+ */
+typedef struct ogs_pfcp_remote_gtp_u_peer_s {
+ED5(uint8_t     spare:4;,
+    uint8_t     ni:1;,
+    uint8_t     di:1;,
+    uint8_t     ipv4:1;,
+    uint8_t     ipv6:1;)
+    union {
+        uint32_t addr;
+        uint8_t addr6[OGS_IPV6_LEN];
+        struct {
+            uint32_t addr;
+            uint8_t addr6[OGS_IPV6_LEN];
+        } both;
+    };
+} __attribute__ ((packed)) ogs_pfcp_remote_gtp_u_peer_t;
+
 /*
  * 8.2.27 Downlink Data Service Information
  */
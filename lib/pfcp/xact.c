@@ -45,6 +45,23 @@ static void response_timeout(void *data);
 static void holding_timeout(void *data);
 static void delayed_commit_timeout(void *data);
 
+/*
+ * Most transactions complete without starting the holding
+ * or the delayed-commit timer, so each timer is added on first use.
+ */
+static void xact_timer_start(ogs_pfcp_xact_t *xact, ogs_timer_t **timer,
+        void (*cb)(void *data), ogs_time_t duration)
+{
+    ogs_assert(xact);
+    ogs_assert(timer);
+
+    if (!*timer) {
+        *timer = ogs_timer_add(ogs_app()->timer_mgr, cb, xact);
+        ogs_assert(*timer);
+    }
+    ogs_timer_start(*timer, duration);
+}
+
 int ogs_pfcp_xact_init(void)
 {
     ogs_assert(ogs_pfcp_xact_initialized == 0);
@@ -86,22 +103,15 @@ ogs_pfcp_xact_t *ogs_pfcp_xact_local_create(ogs_pfcp_node_t *node,
     xact->cb = cb;
     xact->data = data;
 
-    xact->tm_response = ogs_timer_add(
-            ogs_app()->timer_mgr, response_timeout, xact);
-    ogs_assert(xact->tm_response);
+    /* Timers are added on first use by xact_timer_start() */
     xact->response_rcount = ogs_app()->time.message.pfcp.n1_response_rcount;
-
-    xact->tm_holding = ogs_timer_add(
-            ogs_app()->timer_mgr, holding_timeout, xact);
-    ogs_assert(xact->tm_holding);
     xact->holding_rcount = ogs_app()->time.message.pfcp.n1_holding_rcount;
 
-    xact->tm_delayed_commit = ogs_timer_add(
-            ogs_app()->timer_mgr, delayed_commit_timeout, xact);
-    ogs_assert(xact->tm_delayed_commit);
-
     ogs_list_add(xact->org == OGS_PFCP_LOCAL_ORIGINATOR ?
             &xact->node->local_list : &xact->node->remote_list, xact);
+    ogs_hash_set(xact->org == OGS_PFCP_LOCAL_ORIGINATOR ?
+            xact->node->local_hash : xact->node->remote_hash,
+            &xact->xid, sizeof(xact->xid), xact);
 
     ogs_list_init(&xact->pdr_to_create_list);
 
@@ -131,22 +141,15 @@ static ogs_pfcp_xact_t *ogs_pfcp_xact_remote_create(
     xact->xid = OGS_PFCP_SQN_TO_XID(sqn);
     xact->node = node;
 
-    xact->tm_response = ogs_timer_add(
-            ogs_app()->timer_mgr, response_timeout, xact);
-    ogs_assert(xact->tm_response);
+    /* Timers are added on first use by xact_timer_start() */
     xact->response_rcount = ogs_app()->time.message.pfcp.n1_response_rcount;
-
-    xact->tm_holding = ogs_timer_add(
-            ogs_app()->timer_mgr, holding_timeout, xact);
-    ogs_assert(xact->tm_holding);
     xact->holding_rcount = ogs_app()->time.message.pfcp.n1_holding_rcount;
 
-    xact->tm_delayed_commit = ogs_timer_add(
-            ogs_app()->timer_mgr, delayed_commit_timeout, xact);
-    ogs_assert(xact->tm_delayed_commit);
-
     ogs_list_add(xact->org == OGS_PFCP_LOCAL_ORIGINATOR ?
             &xact->node->local_list : &xact->node->remote_list, xact);
+    ogs_hash_set(xact->org == OGS_PFCP_LOCAL_ORIGINATOR ?
+            xact->node->local_hash : xact->node->remote_hash,
+            &xact->xid, sizeof(xact->xid), xact);
 
     ogs_debug("[%d] %s Create  peer [%s]:%d",
             xact->xid,
@@ -311,10 +314,8 @@ static int ogs_pfcp_xact_update_rx(ogs_pfcp_xact_t *xact, uint8_t type)
 
                 pkbuf = xact->seq[2].pkbuf;
                 if (pkbuf) {
-                    if (xact->tm_holding)
-                        ogs_timer_start(xact->tm_holding,
-                                ogs_app()->time.message.
-                                    pfcp.t1_holding_duration);
+                    xact_timer_start(xact, &xact->tm_holding, holding_timeout,
+                            ogs_app()->time.message.pfcp.t1_holding_duration);
 
                     ogs_warn("[%d] %s Request Duplicated. Retransmit!"
                             " for step %d type %d peer [%s]:%d",
@@ -346,9 +347,8 @@ static int ogs_pfcp_xact_update_rx(ogs_pfcp_xact_t *xact, uint8_t type)
                 return OGS_ERROR;
             }
 
-            if (xact->tm_holding)
-                ogs_timer_start(xact->tm_holding,
-                        ogs_app()->time.message.pfcp.t1_holding_duration);
+            xact_timer_start(xact, &xact->tm_holding, holding_timeout,
+                    ogs_app()->time.message.pfcp.t1_holding_duration);
 
             break;
 
@@ -376,10 +376,8 @@ static int ogs_pfcp_xact_update_rx(ogs_pfcp_xact_t *xact, uint8_t type)
 
                 pkbuf = xact->seq[1].pkbuf;
                 if (pkbuf) {
-                    if (xact->tm_holding)
-                        ogs_timer_start(xact->tm_holding,
-                                ogs_app()->time.message.
-                                    pfcp.t1_holding_duration);
+                    xact_timer_start(xact, &xact->tm_holding, holding_timeout,
+                            ogs_app()->time.message.pfcp.t1_holding_duration);
 
                     ogs_warn("[%d] %s Request Duplicated. Retransmit!"
                             " for step %d type %d peer [%s]:%d",
@@ -410,9 +408,8 @@ static int ogs_pfcp_xact_update_rx(ogs_pfcp_xact_t *xact, uint8_t type)
                 ogs_error("invalid step[%d] type[%d]", xact->step, type);
                 return OGS_ERROR;
             }
-            if (xact->tm_holding)
-                ogs_timer_start(xact->tm_holding,
-                        ogs_app()->time.message.pfcp.t1_holding_duration);
+            xact_timer_start(xact, &xact->tm_holding, holding_timeout,
+                    ogs_app()->time.message.pfcp.t1_holding_duration);
 
             break;
 
@@ -479,9 +476,8 @@ int ogs_pfcp_xact_commit(ogs_pfcp_xact_t *xact)
                 return OGS_ERROR;
             }
 
-            if (xact->tm_response)
-                ogs_timer_start(xact->tm_response,
-                        ogs_app()->time.message.pfcp.t1_response_duration);
+            xact_timer_start(xact, &xact->tm_response, response_timeout,
+                    ogs_app()->time.message.pfcp.t1_response_duration);
 
             break;
 
@@ -521,9 +517,8 @@ int ogs_pfcp_xact_commit(ogs_pfcp_xact_t *xact)
                 ogs_pfcp_xact_delete(xact);
                 return OGS_ERROR;
             }
-            if (xact->tm_response)
-                ogs_timer_start(xact->tm_response,
-                        ogs_app()->time.message.pfcp.t1_response_duration);
+            xact_timer_start(xact, &xact->tm_response, response_timeout,
+                    ogs_app()->time.message.pfcp.t1_response_duration);
 
             break;
 
@@ -563,9 +558,9 @@ void ogs_pfcp_xact_delayed_commit(ogs_pfcp_xact_t *xact, ogs_time_t duration)
 {
     ogs_assert(xact);
     ogs_assert(duration);
-    ogs_assert(xact->tm_delayed_commit);
 
-    ogs_timer_start(xact->tm_delayed_commit, duration);
+    xact_timer_start(xact, &xact->tm_delayed_commit,
+            delayed_commit_timeout, duration);
 }
 
 static void response_timeout(void *data)
@@ -671,7 +666,7 @@ int ogs_pfcp_xact_receive(
     uint8_t type;
     uint32_t sqn, xid;
     ogs_pfcp_xact_stage_t stage;
-    ogs_list_t *list = NULL;
+    ogs_hash_t *hash = NULL;
     ogs_pfcp_xact_t *new = NULL;
 
     ogs_assert(node);
@@ -684,13 +679,13 @@ int ogs_pfcp_xact_receive(
 
     switch (stage) {
     case PFCP_XACT_INITIAL_STAGE:
-        list = &node->remote_list;
+        hash = node->remote_hash;
         break;
     case PFCP_XACT_INTERMEDIATE_STAGE:
-        list = &node->local_list;
+        hash = node->local_hash;
         break;
     case PFCP_XACT_FINAL_STAGE:
-        list = &node->local_list;
+        hash = node->local_hash;
         break;
     default:
         ogs_error("[%d] Unexpected type %u from PFCP peer [%s]:%d",
@@ -698,23 +693,20 @@ int ogs_pfcp_xact_receive(
         return OGS_ERROR;
     }
 
-    ogs_assert(list);
-    ogs_list_for_each(list, new) {
-        if (new->xid == xid) {
-            ogs_debug("[%d] %s Find    peer [%s]:%d",
-                new->xid,
-                new->org == OGS_PFCP_LOCAL_ORIGINATOR ? "LOCAL " : "REMOTE",
-                OGS_ADDR(&node->addr, buf),
-                OGS_PORT(&node->addr));
-            break;
-        }
-    }
-
-    ogs_debug("[%d] Cannot find new type %u from PFCP peer [%s]:%d",
-            xid, type, OGS_ADDR(&node->addr, buf), OGS_PORT(&node->addr));
+    ogs_assert(hash);
+    new = ogs_hash_get(hash, &xid, sizeof(xid));
+    if (new) {
+        ogs_debug("[%d] %s Find    peer [%s]:%d",
+            new->xid,
+            new->org == OGS_PFCP_LOCAL_ORIGINATOR ? "LOCAL " : "REMOTE",
+            OGS_ADDR(&node->addr, buf),
+            OGS_PORT(&node->addr));
+    } else {
+        ogs_debug("[%d] Cannot find new type %u from PFCP peer [%s]:%d",
+                xid, type, OGS_ADDR(&node->addr, buf), OGS_PORT(&node->addr));
 
-    if (!new)
         new = ogs_pfcp_xact_remote_create(node, sqn);
+    }
     ogs_assert(new);
 
     ogs_debug("[%d] %s Receive peer [%s]:%d",
@@ -774,6 +766,7 @@ static ogs_pfcp_xact_stage_t ogs_pfcp_xact_get_stage(uint8_t type, uint32_t xid)
 int ogs_pfcp_xact_delete(ogs_pfcp_xact_t *xact)
 {
     char buf[OGS_ADDRSTRLEN];
+    ogs_hash_t *hash = NULL;
 
     ogs_assert(xact);
     ogs_assert(xact->node);
@@ -798,6 +791,11 @@ int ogs_pfcp_xact_delete(ogs_pfcp_xact_t *xact)
     if (xact->tm_delayed_commit)
         ogs_timer_delete(xact->tm_delayed_commit);
 
+    hash = xact->org == OGS_PFCP_LOCAL_ORIGINATOR ?
+            xact->node->local_hash : xact->node->remote_hash;
+    if (ogs_hash_get(hash, &xact->xid, sizeof(xact->xid)) == xact)
+        ogs_hash_set(hash, &xact->xid, sizeof(xact->xid), NULL);
+
     ogs_list_remove(xact->org == OGS_PFCP_LOCAL_ORIGINATOR ?
             &xact->node->local_list : &xact->node->remote_list, xact);
     ogs_pool_free(&pool, xact);
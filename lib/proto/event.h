@@ -41,6 +41,7 @@ typedef enum {
 
     OGS_EVENT_DBI_POLL_TIMER,
     OGS_EVENT_DBI_MESSAGE,
+    OGS_EVENT_DBI_ASYNC,
 
     OGS_MAX_NUM_OF_PROTO_EVENT,
 
@@ -65,6 +66,7 @@ typedef struct ogs_event_s {
 
     struct {
         void *document;
+        void *async;
     } dbi;
 } ogs_event_t;
 
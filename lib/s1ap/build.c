@@ -284,3 +284,156 @@ ogs_pkbuf_t *ogs_s1ap_build_s1_reset_ack(
 
     return ogs_s1ap_encode(&pdu);
 }
+
+/*
+ * The APER encoding of a DownlinkNASTransport with only the three
+ * mandatory IEs is a fixed template. Every field is octet-aligned and
+ * only the UE IDs, the NAS-PDU and the lengths in front of them change
+ * between messages, so the PDU is written directly from the template.
+ *
+ *   00 0b 40 LL          initiatingMessage, id-downlinkNASTransport, ignore
+ *   00 00 03             protocolIEs (3 items)
+ *   00 00 00 LL <id>     MME-UE-S1AP-ID, reject
+ *   00 08 00 LL <id>     eNB-UE-S1AP-ID, reject
+ *   00 1a 00 LL LL <nas> NAS-PDU, reject
+ *
+ * X.691 10.5.7.4: an INTEGER whose range needs more than 16 bits is sent
+ * as the octet count in the leading bits of the first octet, followed by
+ * the value in the minimum number of octets.
+ */
+#define APER_MAX_LENGTH 16383
+
+#define S1AP_ENB_UE_S1AP_ID_MAX 0xffffff
+
+static const uint8_t downlink_nas_transport_header[] = {
+    0x00, S1AP_ProcedureCode_id_downlinkNASTransport,
+    S1AP_Criticality_ignore << 6 };
+
+static const uint8_t downlink_nas_transport_ies[] = { 0x00, 0x00, 0x03 };
+
+static int template_length_size(int length)
+{
+    return length < 128 ? 1 : 2;
+}
+
+static uint8_t *template_put_length(uint8_t *p, int length)
+{
+    if (length < 128) {
+        *p++ = length;
+    } else {
+        *p++ = 0x80 | (length >> 8);
+        *p++ = length & 0xff;
+    }
+
+    return p;
+}
+
+static int template_uint_size(uint32_t value)
+{
+    int size = 1;
+
+    while (value >>= 8)
+        size++;
+
+    return size;
+}
+
+static uint8_t *template_put_ie_header(uint8_t *p,
+        S1AP_ProtocolIE_ID_t id, S1AP_Criticality_t criticality, int length)
+{
+    *p++ = (id >> 8) & 0xff;
+    *p++ = id & 0xff;
+    *p++ = criticality << 6;
+
+    return template_put_length(p, length);
+}
+
+/* Both UE IDs have a range of more than 2 octets : 2-bit octet count */
+static uint8_t *template_put_uint_ie(uint8_t *p,
+        S1AP_ProtocolIE_ID_t id, S1AP_Criticality_t criticality,
+        uint32_t value, int size)
+{
+    int i;
+
+    p = template_put_ie_header(p, id, criticality, 1 + size);
+
+    *p++ = (size - 1) << 6;
+    for (i = size - 1; i >= 0; i--)
+        *p++ = (value >> (i * 8)) & 0xff;
+
+    return p;
+}
+
+ogs_pkbuf_t *ogs_s1ap_build_downlink_nas_transport(
+        uint32_t mme_ue_s1ap_id, uint32_t enb_ue_s1ap_id,
+        ogs_pkbuf_t *naspdu)
+{
+    ogs_pkbuf_t *pkbuf = NULL;
+    uint8_t *p = NULL;
+
+    int mme_ue_s1ap_id_size, enb_ue_s1ap_id_size;
+    int nas_pdu_length, value_length, length;
+
+    ogs_assert(naspdu);
+
+    /* asn_fprint() needs the asn1c tree */
+    if (ogs_log_get_domain_level(OGS_LOG_DOMAIN) >= OGS_LOG_TRACE)
+        return NULL;
+
+    if (enb_ue_s1ap_id > S1AP_ENB_UE_S1AP_ID_MAX) {
+        ogs_error("Invalid ENB_UE_S1AP_ID[%d]", enb_ue_s1ap_id);
+        return NULL;
+    }
+
+    /* Fragmented lengths are left to asn1c */
+    if (naspdu->len > APER_MAX_LENGTH)
+        return NULL;
+
+    mme_ue_s1ap_id_size = template_uint_size(mme_ue_s1ap_id);
+    enb_ue_s1ap_id_size = template_uint_size(enb_ue_s1ap_id);
+
+    nas_pdu_length = template_length_size(naspdu->len) + naspdu->len;
+
+    value_length = sizeof(downlink_nas_transport_ies) +
+        3 + 1 + 1 + mme_ue_s1ap_id_size +
+        3 + 1 + 1 + enb_ue_s1ap_id_size +
+        3 + template_length_size(nas_pdu_length) + nas_pdu_length;
+    if (value_length > APER_MAX_LENGTH)
+        return NULL;
+
+    length = sizeof(downlink_nas_transport_header) +
+        template_length_size(value_length) + value_length;
+
+    pkbuf = ogs_pkbuf_alloc(NULL, length);
+    if (!pkbuf) {
+        ogs_error("ogs_pkbuf_alloc() failed");
+        return NULL;
+    }
+    p = ogs_pkbuf_put(pkbuf, length);
+
+    memcpy(p, downlink_nas_transport_header,
+            sizeof(downlink_nas_transport_header));
+    p += sizeof(downlink_nas_transport_header);
+    p = template_put_length(p, value_length);
+
+    memcpy(p, downlink_nas_transport_ies, sizeof(downlink_nas_transport_ies));
+    p += sizeof(downlink_nas_transport_ies);
+
+    p = template_put_uint_ie(p,
+            S1AP_ProtocolIE_ID_id_MME_UE_S1AP_ID, S1AP_Criticality_reject,
+            mme_ue_s1ap_id, mme_ue_s1ap_id_size);
+    p = template_put_uint_ie(p,
+            S1AP_ProtocolIE_ID_id_eNB_UE_S1AP_ID, S1AP_Criticality_reject,
+            enb_ue_s1ap_id, enb_ue_s1ap_id_size);
+
+    p = template_put_ie_header(p,
+            S1AP_ProtocolIE_ID_id_NAS_PDU, S1AP_Criticality_reject,
+            nas_pdu_length);
+    p = template_put_length(p, naspdu->len);
+    memcpy(p, naspdu->data, naspdu->len);
+    p += naspdu->len;
+
+    ogs_assert(p == pkbuf->tail);
+
+    return pkbuf;
+}
@@ -45,6 +45,17 @@ void ogs_s1ap_build_part_of_s1_interface(
 ogs_pkbuf_t *ogs_s1ap_build_s1_reset_ack(
     S1AP_UE_associatedLogicalS1_ConnectionListRes_t *partOfS1_Interface);
 
+/*
+ * Writes the APER encoding of a DownlinkNASTransport carrying only
+ * MME-UE-S1AP-ID, eNB-UE-S1AP-ID and NAS-PDU without building an asn1c
+ * tree. The NAS-PDU is copied, not consumed. Returns NULL when the
+ * message cannot be written this way, in which case the caller falls
+ * back to the generic encoder.
+ */
+ogs_pkbuf_t *ogs_s1ap_build_downlink_nas_transport(
+    uint32_t mme_ue_s1ap_id, uint32_t enb_ue_s1ap_id,
+    ogs_pkbuf_t *naspdu);
+
 #ifdef __cplusplus
 }
 #endif
@@ -103,6 +103,7 @@ ogs_sbi_client_t *ogs_sbi_client_add(
 {
     ogs_sbi_client_t *client = NULL;
     CURLM *multi = NULL;
+    CURLSH *share = NULL;
 
     ogs_assert(scheme);
     ogs_assert(addr);
@@ -137,6 +138,17 @@ ogs_sbi_client_t *ogs_sbi_client_add(
                         ogs_app()->pool.stream);
 #endif
 
+    /*
+     * Every request is made with a new easy handle, so the TLS session
+     * is shared across the handles. When the connection to the server
+     * is closed, the next one resumes the session
+     * instead of doing the full handshake.
+     */
+    share = client->share = curl_share_init();
+    ogs_assert(share);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+
     ogs_list_init(&client->connection_list);
 
     ogs_list_add(&ogs_sbi_self()->client_list, client);
@@ -173,6 +185,15 @@ void ogs_sbi_client_remove(ogs_sbi_client_t *client)
     ogs_assert(client->multi);
     curl_multi_cleanup(client->multi);
 
+    if (client->handshake.connect)
+        ogs_info("TLS handshake [connect:%llu, average:%lldusec]",
+                (unsigned long long)client->handshake.connect,
+                (long long)(client->handshake.time /
+                    client->handshake.connect));
+
+    ogs_assert(client->share);
+    curl_share_cleanup(client->share);
+
     ogs_assert(client->node.addr);
     ogs_freeaddrinfo(client->node.addr);
 
@@ -384,6 +405,9 @@ static connection_t *connection_add(
 
     curl_easy_setopt(conn->easy, CURLOPT_BUFFERSIZE, OGS_MAX_SDU_LEN);
 
+    ogs_assert(client->share);
+    curl_easy_setopt(conn->easy, CURLOPT_SHARE, client->share);
+
     if (ogs_app()->sbi.client.no_tls == false) {
         ogs_assert(ogs_app()->sbi.client.key);
         ogs_assert(ogs_app()->sbi.client.cert);
@@ -538,6 +562,30 @@ static void connection_timer_expired(void *data)
     connection_remove(conn);
 }
 
+static void handshake_stats(ogs_sbi_client_t *client, CURL *easy)
+{
+    long num_connects = 0;
+    double connect_time = 0, appconnect_time = 0;
+
+    ogs_assert(client);
+    ogs_assert(easy);
+
+    /* The transfer was done over the already established connection */
+    curl_easy_getinfo(easy, CURLINFO_NUM_CONNECTS, &num_connects);
+    if (num_connects <= 0)
+        return;
+
+    curl_easy_getinfo(easy, CURLINFO_CONNECT_TIME, &connect_time);
+    curl_easy_getinfo(easy, CURLINFO_APPCONNECT_TIME, &appconnect_time);
+
+    client->handshake.connect++;
+    ogs_sbi_metrics_inst_global_inc(
+            OGS_SBI_METR_GLOB_CTR_CLIENT_TLS_HANDSHAKE);
+    if (appconnect_time > connect_time)
+        client->handshake.time +=
+            (ogs_time_t)((appconnect_time - connect_time) * 1000000);
+}
+
 static void check_multi_info(ogs_sbi_client_t *client)
 {
     CURLM *multi = NULL;
@@ -570,6 +618,9 @@ static void check_multi_info(ogs_sbi_client_t *client)
             curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &res_status);
             curl_easy_getinfo(easy, CURLINFO_CONTENT_TYPE, &content_type);
 
+            if (ogs_app()->sbi.client.no_tls == false)
+                handshake_stats(client, easy);
+
             res = resource->data.result;
             if (res == CURLE_OK) {
                 ogs_log_level_e level = OGS_LOG_DEBUG;
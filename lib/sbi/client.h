@@ -64,6 +64,12 @@ typedef struct ogs_sbi_client_s {
     void            *multi;             /* CURL multi handle */
     int             still_running;      /* number of running CURL handle */
 
+    void            *share;             /* CURL share handle(TLS session) */
+    struct {
+        uint64_t    connect;            /* number of new TLS connections */
+        ogs_time_t  time;               /* total TLS handshake time */
+    } handshake;
+
     unsigned int    reference_count;    /* reference count for memory free */
 } ogs_sbi_client_t;
 
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2019-2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-sbi.h"
+
+typedef struct ogs_sbi_metrics_spec_def_s {
+    ogs_metrics_metric_type_t type;
+    const char *name;
+    const char *description;
+} ogs_sbi_metrics_spec_def_t;
+
+static ogs_metrics_spec_t *metrics_spec_global[_OGS_SBI_METR_GLOB_MAX];
+static ogs_metrics_inst_t *metrics_inst_global[_OGS_SBI_METR_GLOB_MAX];
+static ogs_sbi_metrics_spec_def_t
+        metrics_spec_def_global[_OGS_SBI_METR_GLOB_MAX] = {
+[OGS_SBI_METR_GLOB_CTR_SERVER_TLS_HANDSHAKE_FULL] = {
+    .type = OGS_METRICS_METRIC_TYPE_COUNTER,
+    .name = "sbi_server_tls_handshake_full",
+    .description = "Number of full TLS handshakes accepted by the SBI server",
+},
+[OGS_SBI_METR_GLOB_CTR_SERVER_TLS_HANDSHAKE_RESUMED] = {
+    .type = OGS_METRICS_METRIC_TYPE_COUNTER,
+    .name = "sbi_server_tls_handshake_resumed",
+    .description = "Number of resumed TLS sessions accepted by the SBI server",
+},
+[OGS_SBI_METR_GLOB_CTR_CLIENT_TLS_HANDSHAKE] = {
+    .type = OGS_METRICS_METRIC_TYPE_COUNTER,
+    .name = "sbi_client_tls_handshake",
+    .description = "Number of new TLS connections made by the SBI client",
+},
+};
+
+void ogs_sbi_metrics_init(void)
+{
+    ogs_metrics_context_t *ctx = ogs_metrics_self();
+    unsigned int i;
+
+    for (i = 0; i < _OGS_SBI_METR_GLOB_MAX; i++) {
+        metrics_spec_global[i] = ogs_metrics_spec_new(ctx,
+                metrics_spec_def_global[i].type,
+                metrics_spec_def_global[i].name,
+                metrics_spec_def_global[i].description,
+                0, 0, NULL, NULL);
+        ogs_assert(metrics_spec_global[i]);
+        metrics_inst_global[i] =
+            ogs_metrics_inst_new(metrics_spec_global[i], 0, NULL);
+        ogs_assert(metrics_inst_global[i]);
+    }
+}
+
+void ogs_sbi_metrics_final(void)
+{
+    /* Specs and instances are freed by ogs_metrics_context_final() */
+    memset(metrics_inst_global, 0, sizeof(metrics_inst_global));
+    memset(metrics_spec_global, 0, sizeof(metrics_spec_global));
+}
+
+/* Also called from the I/O threads of the SBI server */
+void ogs_sbi_metrics_inst_global_inc(ogs_sbi_metric_type_global_t t)
+{
+    ogs_assert(t < _OGS_SBI_METR_GLOB_MAX);
+
+    if (metrics_inst_global[t])
+        ogs_metrics_inst_inc(metrics_inst_global[t]);
+}
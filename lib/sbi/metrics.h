@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2019-2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined(OGS_SBI_INSIDE) && !defined(OGS_SBI_COMPILATION)
+#error "This header cannot be included directly."
+#endif
+
+#ifndef OGS_SBI_METRICS_H
+#define OGS_SBI_METRICS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum ogs_sbi_metric_type_global_s {
+    OGS_SBI_METR_GLOB_CTR_SERVER_TLS_HANDSHAKE_FULL = 0,
+    OGS_SBI_METR_GLOB_CTR_SERVER_TLS_HANDSHAKE_RESUMED,
+    OGS_SBI_METR_GLOB_CTR_CLIENT_TLS_HANDSHAKE,
+    _OGS_SBI_METR_GLOB_MAX,
+} ogs_sbi_metric_type_global_t;
+
+/*
+ * Called by the NF after ogs_metrics_context_init().
+ * Without it, the counters below are not exported.
+ */
+void ogs_sbi_metrics_init(void);
+void ogs_sbi_metrics_final(void);
+
+void ogs_sbi_metrics_inst_global_inc(ogs_sbi_metric_type_global_t t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OGS_SBI_METRICS_H */
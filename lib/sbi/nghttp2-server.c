@@ -57,6 +57,64 @@ struct h2_settings {
     bool enable_push;
 };
 
+/*
+ * SBI Server I/O Thread
+ *
+ * If sbi.server.io_thread is configured, the listening socket stays
+ * on the main loop, but each accepted connection is handed over to one of
+ * the I/O threads. The I/O thread owns the connection: TLS, HTTP/2 framing,
+ * HPACK and header parsing are all done there. Only the complete request
+ * is passed to the main loop, and the response is passed back to
+ * the owning I/O thread.
+ */
+typedef struct ogs_sbi_io_thread_s {
+    ogs_thread_t            *thread;
+    ogs_pollset_t           *pollset;
+    ogs_queue_t             *queue;
+
+    ogs_list_t              session_list;
+    ogs_list_t              orphan_list;    /* Closed while handed over */
+
+    /*
+     * Responses which did not fit in the full queue. They are owned by
+     * the main loop, and pushed again once the I/O thread has drained
+     * the queue and cleared 'backlog' to wake up the main loop.
+     */
+    ogs_list_t              retry_list;
+    bool                    backlog;
+} ogs_sbi_io_thread_t;
+
+typedef enum {
+    IO_EVENT_ACCEPT = 1,
+    IO_EVENT_REQUEST,
+    IO_EVENT_RESPONSE,
+} io_event_e;
+
+typedef struct io_event_s {
+    ogs_lnode_t             lnode;          /* Retry list of the main loop */
+
+    io_event_e              id;
+
+    ogs_sbi_server_t        *server;
+    ogs_sock_t              *sock;
+
+    ogs_sbi_stream_t        *stream;
+    ogs_sbi_request_t       *request;
+    ogs_sbi_response_t      *response;
+    bool                    persistent;
+} io_event_t;
+
+static struct {
+    int                     num_of_thread;
+    ogs_sbi_io_thread_t     *thread;
+    int                     next;
+
+    /* I/O thread -> main loop */
+    ogs_queue_t             *queue;
+    ogs_socket_t            fd[2];
+    ogs_poll_t              *poll;
+} io;
+
 typedef struct ogs_sbi_session_s {
     ogs_lnode_t             lnode;
 
@@ -66,6 +124,8 @@ typedef struct ogs_sbi_session_s {
         ogs_poll_t          *read;
         ogs_poll_t          *write;
     } poll;
+    ogs_pollset_t           *pollset;
+    ogs_sbi_io_thread_t     *io_thread;
 
     nghttp2_session         *session;
     ogs_list_t              write_queue;
@@ -85,13 +145,25 @@ typedef struct ogs_sbi_stream_s {
     ogs_sbi_request_t       *request;
     bool                    memory_overflow;
 
+    ogs_sbi_server_t        *server;
     ogs_sbi_session_t       *session;
+    ogs_sbi_io_thread_t     *io_thread;
+
+    /*
+     * Set by the I/O thread while the request is being processed
+     * by the main loop. Such a stream is not freed on close, but moved
+     * to the orphan list until the main loop returns the response.
+     */
+    bool                    handed_over;
 } ogs_sbi_stream_t;
 
+static void session_start(ogs_sbi_server_t *server,
+        ogs_sock_t *sock, ogs_sbi_io_thread_t *io_thread);
 static void session_remove(ogs_sbi_session_t *sbi_sess);
-static void session_remove_all(ogs_sbi_server_t *server);
+static void session_remove_all(ogs_list_t *list);
 
 static void stream_remove(ogs_sbi_stream_t *stream);
+static void stream_free(ogs_sbi_stream_t *stream);
 
 static void accept_handler(short when, ogs_socket_t fd, void *data);
 static void recv_handler(short when, ogs_socket_t fd, void *data);
@@ -102,19 +174,35 @@ static int session_send(ogs_sbi_session_t *sbi_sess);
 static void session_write_to_buffer(
         ogs_sbi_session_t *sbi_sess, ogs_pkbuf_t *pkbuf);
 
+static int io_thread_start(void);
+static void io_thread_stop(void);
+static int io_event_push(ogs_sbi_io_thread_t *io_thread, io_event_t *e);
+static void io_response_retry(ogs_sbi_io_thread_t *io_thread);
+static void io_event_free(io_event_t *e);
+
 static OGS_POOL(session_pool, ogs_sbi_session_t);
 static OGS_POOL(stream_pool, ogs_sbi_stream_t);
 
+/*
+ * Sessions and streams are allocated by all I/O threads.
+ * The handshake counters of the server are also updated under this lock.
+ */
+static ogs_thread_mutex_t pool_mutex;
+
 static void server_init(int num_of_session_pool, int num_of_stream_pool)
 {
     ogs_pool_init(&session_pool, num_of_session_pool);
     ogs_pool_init(&stream_pool, num_of_stream_pool);
+
+    ogs_thread_mutex_init(&pool_mutex);
 }
 
 static void server_final(void)
 {
     ogs_pool_final(&stream_pool);
     ogs_pool_final(&session_pool);
+
+    ogs_thread_mutex_destroy(&pool_mutex);
 }
 
 #ifndef OPENSSL_NO_NEXTPROTONEG
@@ -190,6 +278,7 @@ static int ssl_ctx_set_proto_versions(SSL_CTX *ssl_ctx, int min, int max)
 
 static SSL_CTX *create_ssl_ctx(const char *key_file, const char *cert_file)
 {
+    static const unsigned char sid_ctx[] = "open5gs-sbi";
     SSL_CTX *ssl_ctx;
     uint64_t ssl_opts;
 
@@ -231,6 +320,33 @@ static SSL_CTX *create_ssl_ctx(const char *key_file, const char *cert_file)
     SSL_CTX_set_mode(ssl_ctx, SSL_MODE_AUTO_RETRY);
     SSL_CTX_set_mode(ssl_ctx, SSL_MODE_RELEASE_BUFFERS);
 
+    /*
+     * Session resumption
+     *
+     * NF consumers open a new connection to the same producer over and
+     * over again, so the full handshake(certificate exchange and
+     * verification) dominates the connection setup cost.
+     *
+     * - TLS 1.2 : Server-side session cache and session tickets
+     * - TLS 1.3 : Stateless session tickets (PSK resumption)
+     *
+     * With mutual TLS, OpenSSL refuses to resume a session
+     * if the session ID context is not set.
+     */
+    SSL_CTX_set_session_cache_mode(ssl_ctx, SSL_SESS_CACHE_SERVER);
+    SSL_CTX_sess_set_cache_size(ssl_ctx, OGS_SBI_TLS_SESSION_CACHE_SIZE);
+    SSL_CTX_set_timeout(ssl_ctx, OGS_SBI_TLS_SESSION_TIMEOUT);
+    if (SSL_CTX_set_session_id_context(ssl_ctx,
+                sid_ctx, sizeof(sid_ctx)-1) != 1) {
+        ogs_error("SSL_CTX_set_session_id_context failed: %s",
+                ERR_error_string(ERR_get_error(), NULL));
+        SSL_CTX_free(ssl_ctx);
+        return NULL;
+    }
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+    SSL_CTX_set_num_tickets(ssl_ctx, OGS_SBI_TLS_NUM_TICKETS);
+#endif
+
     if (SSL_CTX_set_default_verify_paths(ssl_ctx) != 1) {
         ogs_warn("Could not load system trusted ca certificates: %s",
                 ERR_error_string(ERR_get_error(), NULL));
@@ -381,6 +497,19 @@ static int server_start(ogs_sbi_server_t *server,
     /* Setup callback function */
     server->cb = cb;
 
+    if (ogs_app()->sbi.server.num_of_io_thread && !io.num_of_thread) {
+        if (io_thread_start() != OGS_OK) {
+            ogs_error("Cannot start SBI server I/O thread");
+
+            if (server->ssl_ctx)
+                SSL_CTX_free(server->ssl_ctx);
+            ogs_sock_destroy(sock);
+            server->node.sock = NULL;
+
+            return OGS_ERROR;
+        }
+    }
+
     /* Setup poll for server listening socket */
     server->node.poll = ogs_pollset_add(ogs_app()->pollset,
             OGS_POLLIN, sock->fd, accept_handler, server);
@@ -403,17 +532,28 @@ static void server_stop(ogs_sbi_server_t *server)
 {
     ogs_assert(server);
 
-    /* Free SSL CTX */
-    if (server->ssl_ctx)
-        SSL_CTX_free(server->ssl_ctx);
-
     if (server->node.poll)
         ogs_pollset_remove(server->node.poll);
 
     if (server->node.sock)
         ogs_sock_destroy(server->node.sock);
 
-    session_remove_all(server);
+    /*
+     * I/O threads are shared by all servers.
+     * All sessions owned by I/O threads are removed when the threads exit.
+     */
+    if (io.num_of_thread)
+        io_thread_stop();
+
+    session_remove_all(&server->session_list);
+
+    /* Free SSL CTX */
+    if (server->ssl_ctx) {
+        ogs_info("TLS handshake [full:%llu, resumed:%llu]",
+                (unsigned long long)server->handshake.full,
+                (unsigned long long)server->handshake.resumed);
+        SSL_CTX_free(server->ssl_ctx);
+    }
 }
 
 static void add_header(nghttp2_nv *nv, const char *key, const char *value)
@@ -538,7 +678,7 @@ static ssize_t response_read_callback(nghttp2_session *session,
     return response->http.content_length;
 }
 
-static bool server_send_rspmem_persistent(
+static bool session_send_response(
         ogs_sbi_stream_t *stream, ogs_sbi_response_t *response)
 {
     ogs_sbi_session_t *sbi_sess = NULL;
@@ -560,7 +700,9 @@ static bool server_send_rspmem_persistent(
         return false;
     }
 
+    ogs_thread_mutex_lock(&pool_mutex);
     stream = ogs_pool_cycle(&stream_pool, stream);
+    ogs_thread_mutex_unlock(&pool_mutex);
     if (!stream) {
         ogs_error("stream has already been removed");
         return true;
@@ -653,6 +795,59 @@ static bool server_send_rspmem_persistent(
     return true;
 }
 
+static bool io_response_push(ogs_sbi_stream_t *stream,
+        ogs_sbi_response_t *response, bool persistent)
+{
+    io_event_t *e = NULL;
+    int rv;
+
+    ogs_assert(stream);
+    ogs_assert(response);
+
+    /*
+     * The I/O thread keeps a handed-over stream until this response
+     * is processed, so the stream is still valid here even if
+     * the HTTP/2 stream has already been closed.
+     */
+    ogs_assert(stream->io_thread);
+
+    e = ogs_calloc(1, sizeof *e);
+    ogs_assert(e);
+
+    e->id = IO_EVENT_RESPONSE;
+    e->stream = stream;
+    e->response = response;
+    e->persistent = persistent;
+
+    /*
+     * A full queue is not an error for the caller. The response waits
+     * on the retry list behind the earlier ones, and is sent in order.
+     */
+    if (ogs_list_first(&stream->io_thread->retry_list) == NULL) {
+        rv = io_event_push(stream->io_thread, e);
+        if (rv == OGS_OK)
+            return true;
+        if (rv != OGS_RETRY) {
+            io_event_free(e);
+            return false;
+        }
+    }
+
+    ogs_list_add(&stream->io_thread->retry_list, e);
+    io_response_retry(stream->io_thread);
+
+    return true;
+}
+
+static bool server_send_rspmem_persistent(
+        ogs_sbi_stream_t *stream, ogs_sbi_response_t *response)
+{
+    if (io.num_of_thread)
+        return io_response_push(stream, response, true);
+
+    return session_send_response(stream, response);
+}
+
 static bool server_send_response(
         ogs_sbi_stream_t *stream, ogs_sbi_response_t *response)
 {
@@ -660,7 +855,10 @@ static bool server_send_response(
 
     ogs_assert(response);
 
-    rc = server_send_rspmem_persistent(stream, response);
+    if (io.num_of_thread)
+        return io_response_push(stream, response, false);
+
+    rc = session_send_response(stream, response);
 
     ogs_sbi_response_free(response);
 
@@ -669,14 +867,10 @@ static bool server_send_response(
 
 static ogs_sbi_server_t *server_from_stream(ogs_sbi_stream_t *stream)
 {
-    ogs_sbi_session_t *sbi_sess = NULL;
-
     ogs_assert(stream);
-    sbi_sess = stream->session;
-    ogs_assert(sbi_sess);
-    ogs_assert(sbi_sess->server);
+    ogs_assert(stream->server);
 
-    return sbi_sess->server;
+    return stream->server;
 }
 
 static ogs_sbi_stream_t *stream_add(
@@ -686,7 +880,9 @@ static ogs_sbi_stream_t *stream_add(
 
     ogs_assert(sbi_sess);
 
+    ogs_thread_mutex_lock(&pool_mutex);
     ogs_pool_alloc(&stream_pool, &stream);
+    ogs_thread_mutex_unlock(&pool_mutex);
     if (!stream) {
         ogs_error("ogs_pool_alloc() failed");
         return NULL;
@@ -696,14 +892,18 @@ static ogs_sbi_stream_t *stream_add(
     stream->request = ogs_sbi_request_new();
     if (!stream->request) {
         ogs_error("ogs_sbi_request_new() failed");
+        ogs_thread_mutex_lock(&pool_mutex);
         ogs_pool_free(&stream_pool, stream);
+        ogs_thread_mutex_unlock(&pool_mutex);
         return NULL;
     }
 
     stream->stream_id = stream_id;
     sbi_sess->last_stream_id = stream_id;
 
+    stream->server = sbi_sess->server;
     stream->session = sbi_sess;
+    stream->io_thread = sbi_sess->io_thread;
 
     ogs_list_add(&sbi_sess->stream_list, stream);
 
@@ -720,10 +920,27 @@ static void stream_remove(ogs_sbi_stream_t *stream)
 
     ogs_list_remove(&sbi_sess->stream_list, stream);
 
+    if (stream->handed_over == true) {
+        ogs_assert(stream->io_thread);
+
+        stream->session = NULL;
+        ogs_list_add(&stream->io_thread->orphan_list, stream);
+        return;
+    }
+
+    stream_free(stream);
+}
+
+static void stream_free(ogs_sbi_stream_t *stream)
+{
+    ogs_assert(stream);
+
     ogs_assert(stream->request);
     ogs_sbi_request_free(stream->request);
 
+    ogs_thread_mutex_lock(&pool_mutex);
     ogs_pool_free(&stream_pool, stream);
+    ogs_thread_mutex_unlock(&pool_mutex);
 }
 
 static void stream_remove_all(ogs_sbi_session_t *sbi_sess)
@@ -736,15 +953,28 @@ static void stream_remove_all(ogs_sbi_session_t *sbi_sess)
         stream_remove(stream);
 }
 
-static ogs_sbi_session_t *session_add(
-        ogs_sbi_server_t *server, ogs_sock_t *sock)
+static ogs_list_t *session_list(ogs_sbi_session_t *sbi_sess)
+{
+    ogs_assert(sbi_sess);
+
+    if (sbi_sess->io_thread)
+        return &sbi_sess->io_thread->session_list;
+
+    ogs_assert(sbi_sess->server);
+    return &sbi_sess->server->session_list;
+}
+
+static ogs_sbi_session_t *session_add(ogs_sbi_server_t *server,
+        ogs_sock_t *sock, ogs_sbi_io_thread_t *io_thread)
 {
     ogs_sbi_session_t *sbi_sess = NULL;
 
     ogs_assert(server);
     ogs_assert(sock);
 
+    ogs_thread_mutex_lock(&pool_mutex);
     ogs_pool_alloc(&session_pool, &sbi_sess);
+    ogs_thread_mutex_unlock(&pool_mutex);
     if (!sbi_sess) {
         ogs_error("ogs_pool_alloc() failed");
         return NULL;
@@ -754,10 +984,15 @@ static ogs_sbi_session_t *session_add(
     sbi_sess->server = server;
     sbi_sess->sock = sock;
 
+    sbi_sess->io_thread = io_thread;
+    sbi_sess->pollset = io_thread ? io_thread->pollset : ogs_app()->pollset;
+
     sbi_sess->addr = ogs_calloc(1, sizeof(ogs_sockaddr_t));
     if (!sbi_sess->addr) {
         ogs_error("ogs_calloc() failed");
+        ogs_thread_mutex_lock(&pool_mutex);
         ogs_pool_free(&session_pool, sbi_sess);
+        ogs_thread_mutex_unlock(&pool_mutex);
         return NULL;
     }
     memcpy(sbi_sess->addr, &sock->remote_addr, sizeof(ogs_sockaddr_t));
@@ -766,27 +1001,26 @@ static ogs_sbi_session_t *session_add(
         sbi_sess->ssl = SSL_new(server->ssl_ctx);
         if (!sbi_sess->ssl) {
             ogs_error("SSL_new() failed");
-            ogs_pool_free(&session_pool, sbi_sess);
             ogs_free(sbi_sess->addr);
+            ogs_thread_mutex_lock(&pool_mutex);
+            ogs_pool_free(&session_pool, sbi_sess);
+            ogs_thread_mutex_unlock(&pool_mutex);
             return NULL;
         }
     }
 
-    ogs_list_add(&server->session_list, sbi_sess);
+    ogs_list_add(session_list(sbi_sess), sbi_sess);
 
     return sbi_sess;
 }
 
 static void session_remove(ogs_sbi_session_t *sbi_sess)
 {
-    ogs_sbi_server_t *server = NULL;
     ogs_pkbuf_t *pkbuf = NULL, *next_pkbuf = NULL;
 
     ogs_assert(sbi_sess);
-    server = sbi_sess->server;
-    ogs_assert(server);
 
-    ogs_list_remove(&server->session_list, sbi_sess);
+    ogs_list_remove(session_list(sbi_sess), sbi_sess);
 
     if (sbi_sess->ssl)
         SSL_free(sbi_sess->ssl);
@@ -811,23 +1045,24 @@ static void session_remove(ogs_sbi_session_t *sbi_sess)
     ogs_assert(sbi_sess->sock);
     ogs_sock_destroy(sbi_sess->sock);
 
+    ogs_thread_mutex_lock(&pool_mutex);
     ogs_pool_free(&session_pool, sbi_sess);
+    ogs_thread_mutex_unlock(&pool_mutex);
 }
 
-static void session_remove_all(ogs_sbi_server_t *server)
+static void session_remove_all(ogs_list_t *list)
 {
     ogs_sbi_session_t *sbi_sess = NULL, *next_sbi_sess = NULL;
 
-    ogs_assert(server);
+    ogs_assert(list);
 
-    ogs_list_for_each_safe(&server->session_list, next_sbi_sess, sbi_sess)
+    ogs_list_for_each_safe(list, next_sbi_sess, sbi_sess)
         session_remove(sbi_sess);
 }
 
 static void accept_handler(short when, ogs_socket_t fd, void *data)
 {
     ogs_sbi_server_t *server = data;
-    ogs_sbi_session_t *sbi_sess = NULL;
     ogs_sock_t *sock = NULL;
     ogs_sock_t *new = NULL;
 
@@ -853,12 +1088,50 @@ static void accept_handler(short when, ogs_socket_t fd, void *data)
         return;
     }
 
-    sbi_sess = session_add(server, new);
-    ogs_assert(sbi_sess);
+    if (io.num_of_thread) {
+        io_event_t *e = NULL;
+        ogs_sbi_io_thread_t *io_thread = NULL;
+
+        io_thread = &io.thread[io.next];
+        io.next = (io.next + 1) % io.num_of_thread;
+
+        e = ogs_calloc(1, sizeof *e);
+        ogs_assert(e);
+
+        e->id = IO_EVENT_ACCEPT;
+        e->server = server;
+        e->sock = new;
+
+        if (io_event_push(io_thread, e) != OGS_OK) {
+            ogs_error("Cannot hand over the connection to the I/O thread");
+            ogs_sock_destroy(new);
+            ogs_free(e);
+        }
+
+        return;
+    }
+
+    session_start(server, new, NULL);
+}
+
+static void session_start(ogs_sbi_server_t *server,
+        ogs_sock_t *sock, ogs_sbi_io_thread_t *io_thread)
+{
+    ogs_sbi_session_t *sbi_sess = NULL;
+
+    ogs_assert(server);
+    ogs_assert(sock);
+
+    sbi_sess = session_add(server, sock, io_thread);
+    if (!sbi_sess) {
+        ogs_error("session_add() failed");
+        ogs_sock_destroy(sock);
+        return;
+    }
 
     if (sbi_sess->ssl) {
         int err;
-        SSL_set_fd(sbi_sess->ssl, new->fd);
+        SSL_set_fd(sbi_sess->ssl, sock->fd);
         SSL_set_accept_state(sbi_sess->ssl);
         err = SSL_accept(sbi_sess->ssl);
         if (err <= 0) {
@@ -866,10 +1139,22 @@ static void accept_handler(short when, ogs_socket_t fd, void *data)
             session_remove(sbi_sess);
             return;
         }
+
+        ogs_thread_mutex_lock(&pool_mutex);
+        if (SSL_session_reused(sbi_sess->ssl)) {
+            server->handshake.resumed++;
+            ogs_sbi_metrics_inst_global_inc(
+                    OGS_SBI_METR_GLOB_CTR_SERVER_TLS_HANDSHAKE_RESUMED);
+        } else {
+            server->handshake.full++;
+            ogs_sbi_metrics_inst_global_inc(
+                    OGS_SBI_METR_GLOB_CTR_SERVER_TLS_HANDSHAKE_FULL);
+        }
+        ogs_thread_mutex_unlock(&pool_mutex);
     }
 
-    sbi_sess->poll.read = ogs_pollset_add(ogs_app()->pollset,
-        OGS_POLLIN, new->fd, recv_handler, sbi_sess);
+    sbi_sess->poll.read = ogs_pollset_add(sbi_sess->pollset,
+        OGS_POLLIN, sock->fd, recv_handler, sbi_sess);
     ogs_assert(sbi_sess->poll.read);
 
     if (session_set_callbacks(sbi_sess) != OGS_OK ||
@@ -1125,6 +1410,26 @@ static int on_frame_recv(nghttp2_session *session,
                 break;
             }
 
+            if (sbi_sess->io_thread) {
+                io_event_t *e = ogs_calloc(1, sizeof *e);
+                ogs_assert(e);
+
+                e->id = IO_EVENT_REQUEST;
+                e->server = server;
+                e->stream = stream;
+                e->request = request;
+
+                stream->handed_over = true;
+                if (io_event_push(NULL, e) != OGS_OK) {
+                    stream->handed_over = false;
+                    ogs_free(e);
+                    nghttp2_submit_rst_stream(session, NGHTTP2_FLAG_NONE,
+                            stream->stream_id, NGHTTP2_INTERNAL_ERROR);
+                }
+
+                return 0;
+            }
+
             if (server->cb(request, stream) != OGS_OK) {
                 ogs_warn("server callback error");
                 ogs_assert(true ==
@@ -1697,8 +2002,298 @@ static void session_write_to_buffer(
     ogs_list_add(&sbi_sess->write_queue, pkbuf);
 
     if (!sbi_sess->poll.write) {
-        sbi_sess->poll.write = ogs_pollset_add(ogs_app()->pollset,
+        sbi_sess->poll.write = ogs_pollset_add(sbi_sess->pollset,
             OGS_POLLOUT, fd, session_write_callback, sbi_sess);
         ogs_assert(sbi_sess->poll.write);
     }
 }
+
+static void io_thread_main(void *data)
+{
+    ogs_sbi_io_thread_t *io_thread = data;
+    ogs_sbi_stream_t *stream = NULL, *next_stream = NULL;
+    int rv;
+    char c = 0;
+
+    ogs_assert(io_thread);
+
+    for ( ;; ) {
+        ogs_pollset_poll(io_thread->pollset, OGS_INFINITE_TIME);
+
+        for ( ;; ) {
+            io_event_t *e = NULL;
+
+            rv = ogs_queue_trypop(io_thread->queue, (void**)&e);
+            ogs_assert(rv != OGS_ERROR);
+
+            if (rv == OGS_DONE)
+                goto done;
+
+            if (rv == OGS_RETRY) {
+                /* The main loop is waiting for room in the queue */
+                if (__atomic_exchange_n(
+                            &io_thread->backlog, false, __ATOMIC_ACQ_REL))
+                    ogs_send(io.fd[1], &c, 1, 0);
+                break;
+            }
+
+            ogs_assert(e);
+            switch (e->id) {
+            case IO_EVENT_ACCEPT:
+                session_start(e->server, e->sock, io_thread);
+                break;
+            case IO_EVENT_RESPONSE:
+                stream = e->stream;
+                ogs_assert(stream);
+                ogs_assert(stream->io_thread == io_thread);
+                ogs_assert(e->response);
+
+                stream->handed_over = false;
+
+                if (stream->session) {
+                    session_send_response(stream, e->response);
+                } else {
+                    ogs_warn("STREAM has already been closed");
+                    ogs_list_remove(&io_thread->orphan_list, stream);
+                    stream_free(stream);
+                }
+
+                if (e->persistent == false)
+                    ogs_sbi_response_free(e->response);
+                break;
+            default:
+                ogs_error("Unknown event [%d]", e->id);
+                break;
+            }
+
+            ogs_free(e);
+        }
+    }
+done:
+
+    session_remove_all(&io_thread->session_list);
+
+    /* The main loop is stopping and will not respond anymore */
+    ogs_list_for_each_safe(&io_thread->orphan_list, next_stream, stream) {
+        ogs_list_remove(&io_thread->orphan_list, stream);
+        stream_free(stream);
+    }
+}
+
+static void io_request_handler(short when, ogs_socket_t fd, void *data)
+{
+    char buf[256];
+    int i, rv;
+
+    /* Drain the notification from the I/O threads (non-blocking) */
+    while (ogs_recv(fd, buf, sizeof(buf), 0) > 0);
+
+    for (i = 0; i < io.num_of_thread; i++)
+        io_response_retry(&io.thread[i]);
+
+    for ( ;; ) {
+        io_event_t *e = NULL;
+        ogs_sbi_server_t *server = NULL;
+
+        rv = ogs_queue_trypop(io.queue, (void**)&e);
+        if (rv != OGS_OK)
+            break;
+
+        ogs_assert(e);
+        ogs_assert(e->id == IO_EVENT_REQUEST);
+        server = e->server;
+        ogs_assert(server);
+        ogs_assert(server->cb);
+
+        if (server->cb(e->request, e->stream) != OGS_OK) {
+            ogs_warn("server callback error");
+            ogs_assert(true ==
+                ogs_sbi_server_send_error(e->stream,
+                    OGS_SBI_HTTP_STATUS_INTERNAL_SERVER_ERROR, NULL,
+                    "server callback error", NULL));
+        }
+
+        ogs_free(e);
+    }
+}
+
+static int io_event_push(ogs_sbi_io_thread_t *io_thread, io_event_t *e)
+{
+    int rv;
+    char c = 0;
+
+    ogs_assert(e);
+
+    if (!io_thread) {
+        /* I/O thread -> Main loop */
+        rv = ogs_queue_push(io.queue, e);
+        if (rv != OGS_OK) {
+            ogs_error("ogs_queue_push() failed:%d", (int)rv);
+            return OGS_ERROR;
+        }
+
+        /* EAGAIN is fine since the main loop has not been woken up yet */
+        ogs_send(io.fd[1], &c, 1, 0);
+
+        return OGS_OK;
+    }
+
+    /* Main loop -> I/O thread : never block the main loop */
+    rv = ogs_queue_trypush(io_thread->queue, e);
+    if (rv != OGS_OK) {
+        if (rv == OGS_RETRY)
+            ogs_warn("I/O thread queue is full");
+        else
+            ogs_error("ogs_queue_trypush() failed:%d", (int)rv);
+        return rv;
+    }
+
+    ogs_pollset_notify(io_thread->pollset);
+
+    return OGS_OK;
+}
+
+/* Main loop only */
+static void io_response_retry(ogs_sbi_io_thread_t *io_thread)
+{
+    io_event_t *e = NULL;
+    int rv;
+
+    ogs_assert(io_thread);
+
+    while ((e = ogs_list_first(&io_thread->retry_list))) {
+        /*
+         * Set before pushing. If the queue is full, the I/O thread
+         * sees it after draining the queue, and wakes up the main loop.
+         */
+        __atomic_store_n(&io_thread->backlog, true, __ATOMIC_RELEASE);
+
+        /* Once pushed, the event belongs to the I/O thread */
+        ogs_list_remove(&io_thread->retry_list, e);
+
+        rv = ogs_queue_trypush(io_thread->queue, e);
+        if (rv == OGS_RETRY) {
+            ogs_list_prepend(&io_thread->retry_list, e);
+            break;
+        }
+
+        if (rv != OGS_OK) {
+            ogs_error("ogs_queue_trypush() failed:%d", (int)rv);
+            io_event_free(e);
+            continue;
+        }
+
+        ogs_pollset_notify(io_thread->pollset);
+    }
+}
+
+static void io_event_free(io_event_t *e)
+{
+    ogs_assert(e);
+
+    if (e->response && e->persistent == false)
+        ogs_sbi_response_free(e->response);
+
+    ogs_free(e);
+}
+
+static int io_thread_start(void)
+{
+    int i, rv;
+    int num_of_thread = ogs_app()->sbi.server.num_of_io_thread;
+
+    ogs_assert(num_of_thread > 0);
+    ogs_assert(io.num_of_thread == 0);
+
+    rv = ogs_socketpair(AF_SOCKPAIR, SOCK_STREAM, 0, io.fd);
+    if (rv != OGS_OK) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
+                "ogs_socketpair() failed");
+        return OGS_ERROR;
+    }
+    rv = ogs_nonblocking(io.fd[0]);
+    ogs_assert(rv == OGS_OK);
+    rv = ogs_nonblocking(io.fd[1]);
+    ogs_assert(rv == OGS_OK);
+
+    io.queue = ogs_queue_create(ogs_app()->pool.stream);
+    ogs_assert(io.queue);
+
+    io.poll = ogs_pollset_add(ogs_app()->pollset,
+            OGS_POLLIN, io.fd[0], io_request_handler, NULL);
+    ogs_assert(io.poll);
+
+    io.thread = ogs_calloc(num_of_thread, sizeof(ogs_sbi_io_thread_t));
+    ogs_assert(io.thread);
+
+    for (i = 0; i < num_of_thread; i++) {
+        ogs_sbi_io_thread_t *io_thread = &io.thread[i];
+
+        ogs_list_init(&io_thread->session_list);
+        ogs_list_init(&io_thread->orphan_list);
+        ogs_list_init(&io_thread->retry_list);
+        io_thread->backlog = false;
+
+        io_thread->pollset = ogs_pollset_create(ogs_app()->pool.socket);
+        ogs_assert(io_thread->pollset);
+        io_thread->queue = ogs_queue_create(ogs_app()->pool.stream);
+        ogs_assert(io_thread->queue);
+
+        io_thread->thread = ogs_thread_create(io_thread_main, io_thread);
+        ogs_assert(io_thread->thread);
+    }
+
+    io.num_of_thread = num_of_thread;
+    io.next = 0;
+
+    ogs_info("nghttp2_server() I/O thread [%d]", io.num_of_thread);
+
+    return OGS_OK;
+}
+
+static void io_thread_stop(void)
+{
+    int i, rv;
+
+    ogs_assert(io.num_of_thread);
+
+    for (i = 0; i < io.num_of_thread; i++) {
+        ogs_sbi_io_thread_t *io_thread = &io.thread[i];
+        io_event_t *e = NULL, *next_e = NULL;
+
+        ogs_queue_term(io_thread->queue);
+        ogs_pollset_notify(io_thread->pollset);
+
+        ogs_thread_destroy(io_thread->thread);
+
+        /* The streams have been freed by the I/O thread */
+        ogs_list_for_each_safe(&io_thread->retry_list, next_e, e) {
+            ogs_list_remove(&io_thread->retry_list, e);
+            io_event_free(e);
+        }
+
+        ogs_queue_destroy(io_thread->queue);
+        ogs_pollset_destroy(io_thread->pollset);
+    }
+
+    ogs_free(io.thread);
+    io.thread = NULL;
+    io.num_of_thread = 0;
+
+    /* The streams of pending requests have been freed by the I/O threads */
+    for ( ;; ) {
+        io_event_t *e = NULL;
+
+        rv = ogs_queue_trypop(io.queue, (void**)&e);
+        if (rv != OGS_OK)
+            break;
+
+        ogs_free(e);
+    }
+
+    ogs_pollset_remove(io.poll);
+    ogs_queue_destroy(io.queue);
+
+    ogs_closesocket(io.fd[0]);
+    ogs_closesocket(io.fd[1]);
+}
@@ -22,6 +22,7 @@
 
 #include "crypt/ogs-crypt.h"
 #include "app/ogs-app.h"
+#include "metrics/ogs-metrics.h"
 
 #if defined(__GNUC__)
 #pragma GCC diagnostic push
@@ -99,6 +100,7 @@
 #include "sbi/server.h"
 #include "sbi/client.h"
 #include "sbi/context.h"
+#include "sbi/metrics.h"
 
 #include "sbi/nf-sm.h"
 
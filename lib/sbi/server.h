@@ -31,6 +31,10 @@ extern "C" {
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 
+#define OGS_SBI_TLS_SESSION_CACHE_SIZE      (1024*20)
+#define OGS_SBI_TLS_SESSION_TIMEOUT         7200 /* seconds */
+#define OGS_SBI_TLS_NUM_TICKETS             2
+
 typedef struct ogs_sbi_stream_s ogs_sbi_stream_t;
 
 typedef struct ogs_sbi_server_s {
@@ -39,6 +43,11 @@ typedef struct ogs_sbi_server_s {
 
     SSL_CTX *ssl_ctx;
 
+    struct {
+        uint64_t full;      /* Full handshakes */
+        uint64_t resumed;   /* Abbreviated handshakes(session resumption) */
+    } handshake;
+
     int (*cb)(ogs_sbi_request_t *request, void *data);
     ogs_list_t      session_list;
 
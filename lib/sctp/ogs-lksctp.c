@@ -251,8 +251,10 @@ int ogs_sctp_recvmsg(ogs_sock_t *sock, void *msg, size_t len,
     size = sctp_recvmsg(sock->fd, msg, len, &addr.sa, &addrlen,
                 &sndrcvinfo, &flags);
     if (size < 0) {
-        ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
-                "sctp_recvmsg(%d) failed", size);
+        /* A non-blocking socket has simply been drained */
+        if (ogs_socket_errno != OGS_EAGAIN)
+            ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
+                    "sctp_recvmsg(%d) failed", size);
         return size;
     }
 
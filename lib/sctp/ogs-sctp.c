@@ -74,6 +74,77 @@ int ogs_sctp_senddata(ogs_sock_t *sock,
     return OGS_OK;
 }
 
+/*
+ * Send the messages on a connected socket, each with its own PPID and
+ * stream. With sendmmsg(2), the whole batch costs a single system call.
+ *
+ * Returns the number of messages sent from the head of the array,
+ * or -1 if not even the first one could be sent.
+ */
+int ogs_sctp_sendmsg_batch(ogs_sock_t *sock, ogs_pkbuf_t **pkbuf, int num)
+{
+#if HAVE_SENDMMSG && !HAVE_USRSCTP
+    struct mmsghdr msg[OGS_SCTP_MAX_BATCH];
+    struct iovec iov[OGS_SCTP_MAX_BATCH];
+    union {
+        char buf[CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))];
+        struct cmsghdr align;
+    } control[OGS_SCTP_MAX_BATCH];
+    int i;
+
+    ogs_assert(sock);
+    ogs_assert(pkbuf);
+    ogs_assert(num > 0 && num <= OGS_SCTP_MAX_BATCH);
+
+    memset(msg, 0, sizeof(msg[0]) * num);
+    memset(control, 0, sizeof(control[0]) * num);
+
+    for (i = 0; i < num; i++) {
+        struct cmsghdr *cmsg = NULL;
+        struct sctp_sndrcvinfo *sinfo = NULL;
+
+        ogs_assert(pkbuf[i]);
+
+        iov[i].iov_base = pkbuf[i]->data;
+        iov[i].iov_len = pkbuf[i]->len;
+
+        msg[i].msg_hdr.msg_iov = &iov[i];
+        msg[i].msg_hdr.msg_iovlen = 1;
+        msg[i].msg_hdr.msg_control = control[i].buf;
+        msg[i].msg_hdr.msg_controllen = sizeof(control[i].buf);
+
+        cmsg = CMSG_FIRSTHDR(&msg[i].msg_hdr);
+        cmsg->cmsg_level = IPPROTO_SCTP;
+        cmsg->cmsg_type = SCTP_SNDRCV;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(struct sctp_sndrcvinfo));
+
+        sinfo = (struct sctp_sndrcvinfo *)CMSG_DATA(cmsg);
+        sinfo->sinfo_ppid = htobe32(ogs_sctp_ppid_in_pkbuf(pkbuf[i]));
+        sinfo->sinfo_stream = ogs_sctp_stream_no_in_pkbuf(pkbuf[i]);
+    }
+
+    return sendmmsg(sock->fd, msg, num, 0);
+#else
+    int i, sent;
+
+    ogs_assert(sock);
+    ogs_assert(pkbuf);
+    ogs_assert(num > 0 && num <= OGS_SCTP_MAX_BATCH);
+
+    for (i = 0; i < num; i++) {
+        ogs_assert(pkbuf[i]);
+
+        sent = ogs_sctp_sendmsg(sock, pkbuf[i]->data, pkbuf[i]->len, NULL,
+                ogs_sctp_ppid_in_pkbuf(pkbuf[i]),
+                ogs_sctp_stream_no_in_pkbuf(pkbuf[i]));
+        if (sent < 0)
+            return i ? i : -1;
+    }
+
+    return num;
+#endif
+}
+
 void ogs_sctp_write_to_buffer(ogs_sctp_sock_t *sctp, ogs_pkbuf_t *pkbuf)
 {
     ogs_assert(sctp);
@@ -89,25 +160,54 @@ void ogs_sctp_write_to_buffer(ogs_sctp_sock_t *sctp, ogs_pkbuf_t *pkbuf)
     }
 }
 
+/*
+ * Everything queued for the association since the last wakeup is sent
+ * in batches of OGS_SCTP_MAX_BATCH messages. The queue is FIFO, so the
+ * order within each stream is kept. If the socket buffer fills up,
+ * the rest waits for the next POLLOUT.
+ */
 static void sctp_write_callback(short when, ogs_socket_t fd, void *data)
 {
     ogs_sctp_sock_t *sctp = data;
-    ogs_pkbuf_t *pkbuf = NULL;
+    ogs_pkbuf_t *pkbuf[OGS_SCTP_MAX_BATCH];
+    ogs_pkbuf_t *p = NULL;
+    int i, num, sent;
 
     ogs_assert(sctp);
+    ogs_assert(sctp->sock);
+
+    do {
+        num = 0;
+        for (p = ogs_list_first(&sctp->write_queue);
+                p && num < OGS_SCTP_MAX_BATCH; p = ogs_list_next(p))
+            pkbuf[num++] = p;
+
+        if (num == 0)
+            break;
+
+        sent = ogs_sctp_sendmsg_batch(sctp->sock, pkbuf, num);
+        if (sent < 0) {
+            if (ogs_socket_errno == OGS_EAGAIN)
+                return;
+
+            /* Drop the message at the head as ogs_sctp_senddata() does */
+            ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
+                    "ogs_sctp_sendmsg_batch(len:%d,ssn:%d)",
+                    pkbuf[0]->len, (int)ogs_sctp_stream_no_in_pkbuf(pkbuf[0]));
+            sent = 1;
+        }
+
+        for (i = 0; i < sent; i++) {
+            ogs_list_remove(&sctp->write_queue, pkbuf[i]);
+            ogs_pkbuf_free(pkbuf[i]);
+        }
+    } while (sent == num);
+
     if (ogs_list_empty(&sctp->write_queue) == true) {
         ogs_assert(sctp->poll.write);
         ogs_pollset_remove(sctp->poll.write);
         sctp->poll.write = NULL;
-        return;
     }
-
-    pkbuf = ogs_list_first(&sctp->write_queue);
-    ogs_assert(pkbuf);
-    ogs_list_remove(&sctp->write_queue, pkbuf);
-
-    ogs_assert(sctp->sock);
-    ogs_sctp_senddata(sctp->sock, pkbuf, NULL);
 }
 
 void ogs_sctp_flush_and_destroy(ogs_sctp_sock_t *sctp)
@@ -123,6 +123,9 @@ int ogs_sctp_so_linger(ogs_sock_t *sock, int l_linger);
 
 int ogs_sctp_sendmsg(ogs_sock_t *sock, const void *msg, size_t len,
         ogs_sockaddr_t *to, uint32_t ppid, uint16_t stream_no);
+
+#define OGS_SCTP_MAX_BATCH              OGS_POLL_BUDGET
+int ogs_sctp_sendmsg_batch(ogs_sock_t *sock, ogs_pkbuf_t **pkbuf, int num);
 int ogs_sctp_recvmsg(ogs_sock_t *sock, void *msg, size_t len,
         ogs_sockaddr_t *from, ogs_sctp_info_t *sinfo, int *msg_flags);
 int ogs_sctp_recvdata(ogs_sock_t *sock, void *msg, size_t len,
@@ -54,7 +54,7 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
     amf_gnb_t *gnb = NULL;
     uint16_t max_num_of_ostreams = 0;
 
-    ogs_ngap_message_t ngap_message;
+    ogs_ngap_message_t ngap_message, *decoded = NULL;
     ogs_pkbuf_t *pkbuf = NULL;
     int rc;
 
@@ -815,10 +815,16 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
         ogs_assert(gnb);
         ogs_assert(OGS_FSM_STATE(&gnb->sm));
 
-        rc = ogs_ngap_decode(&ngap_message, pkbuf);
+        /* Already decoded in the NGAP worker thread */
+        decoded = e->ngap.message;
+        if (decoded)
+            rc = OGS_OK;
+        else
+            rc = ogs_ngap_decode(&ngap_message, pkbuf);
+
         if (rc == OGS_OK) {
             e->gnb = gnb;
-            e->ngap.message = &ngap_message;
+            e->ngap.message = decoded ? decoded : &ngap_message;
             ogs_fsm_dispatch(&gnb->sm, e);
         } else {
             ogs_error("Cannot decode NGAP message");
@@ -829,11 +835,29 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
             ogs_assert(r != OGS_ERROR);
         }
 
-        ogs_ngap_free(&ngap_message);
+        if (decoded) {
+            ogs_ngap_free(decoded);
+            ogs_free(decoded);
+        } else {
+            ogs_ngap_free(&ngap_message);
+        }
         ogs_pkbuf_free(pkbuf);
         break;
 
     case AMF_EVENT_NGAP_TIMER:
+        if (e->h.timer_id == AMF_TIMER_NG_PAGING) {
+            gnb = amf_gnb_cycle(e->gnb);
+            if (!gnb) {
+                ogs_error("gNB has already been removed");
+                break;
+            }
+
+            r = ngap_send_deferred_paging(gnb);
+            ogs_expect(r == OGS_OK);
+            ogs_assert(r != OGS_ERROR);
+            break;
+        }
+
         ran_ue = e->ran_ue;
         ogs_assert(ran_ue);
 
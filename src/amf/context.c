@@ -25,6 +25,9 @@ int __amf_log_domain;
 int __gmm_log_domain;
 
 static OGS_POOL(amf_gnb_pool, amf_gnb_t);
+static OGS_POOL(amf_paging_area_pool, amf_paging_area_t);
+static OGS_POOL(amf_paging_gnb_pool, amf_paging_gnb_t);
+static OGS_POOL(amf_paging_deferred_pool, amf_paging_deferred_t);
 static OGS_POOL(amf_ue_pool, amf_ue_t);
 static OGS_POOL(ran_ue_pool, ran_ue_t);
 static OGS_POOL(amf_sess_pool, amf_sess_t);
@@ -59,6 +62,10 @@ void amf_context_init(void)
 
     /* Allocate TWICE the pool to check if maximum number of gNBs is reached */
     ogs_pool_init(&amf_gnb_pool, ogs_app()->max.peer*2);
+    ogs_pool_init(&amf_paging_area_pool,
+            amf_gnb_pool.size * OGS_MAX_NUM_OF_TAI * OGS_MAX_NUM_OF_BPLMN);
+    ogs_pool_init(&amf_paging_gnb_pool, amf_paging_area_pool.size);
+    ogs_pool_init(&amf_paging_deferred_pool, ogs_app()->max.ue);
     ogs_pool_init(&amf_ue_pool, ogs_app()->max.ue);
     ogs_pool_init(&ran_ue_pool, ogs_app()->max.ue);
     ogs_pool_init(&amf_sess_pool, ogs_app()->pool.sess);
@@ -78,6 +85,8 @@ void amf_context_init(void)
     ogs_assert(self.suci_hash);
     self.supi_hash = ogs_hash_make();
     ogs_assert(self.supi_hash);
+    self.paging_area_hash = ogs_hash_make();
+    ogs_assert(self.paging_area_hash);
 
     context_initialized = 1;
 }
@@ -100,11 +109,16 @@ void amf_context_final(void)
     ogs_hash_destroy(self.suci_hash);
     ogs_assert(self.supi_hash);
     ogs_hash_destroy(self.supi_hash);
+    ogs_assert(self.paging_area_hash);
+    ogs_hash_destroy(self.paging_area_hash);
 
     ogs_pool_final(&m_tmsi_pool);
     ogs_pool_final(&amf_sess_pool);
     ogs_pool_final(&amf_ue_pool);
     ogs_pool_final(&ran_ue_pool);
+    ogs_pool_final(&amf_paging_deferred_pool);
+    ogs_pool_final(&amf_paging_gnb_pool);
+    ogs_pool_final(&amf_paging_area_pool);
     ogs_pool_final(&amf_gnb_pool);
 
     context_initialized = 0;
@@ -134,6 +148,18 @@ static int amf_context_validation(void)
         return OGS_ERROR;
     }
 
+    if (self.num_of_ngap_thread < 0) {
+        ogs_error("Invalid amf.ngap_thread[%d] in '%s'",
+                self.num_of_ngap_thread, ogs_app()->file);
+        return OGS_ERROR;
+    }
+
+    if (self.paging_rate < 0) {
+        ogs_error("Invalid amf.paging.rate[%d] in '%s'",
+                self.paging_rate, ogs_app()->file);
+        return OGS_ERROR;
+    }
+
     if (self.num_of_served_guami == 0) {
         ogs_error("No amf.guami in '%s'", ogs_app()->file);
         return OGS_ERROR;
@@ -220,6 +246,22 @@ int amf_context_parse_config(void)
                 if (!strcmp(amf_key, "relative_capacity")) {
                     const char *v = ogs_yaml_iter_value(&amf_iter);
                     if (v) self.relative_capacity = atoi(v);
+                } else if (!strcmp(amf_key, "ngap_thread")) {
+                    const char *v = ogs_yaml_iter_value(&amf_iter);
+                    if (v) self.num_of_ngap_thread = atoi(v);
+                } else if (!strcmp(amf_key, "paging")) {
+                    ogs_yaml_iter_t paging_iter;
+                    ogs_yaml_iter_recurse(&amf_iter, &paging_iter);
+                    while (ogs_yaml_iter_next(&paging_iter)) {
+                        const char *paging_key =
+                            ogs_yaml_iter_key(&paging_iter);
+                        ogs_assert(paging_key);
+                        if (!strcmp(paging_key, "rate")) {
+                            const char *v = ogs_yaml_iter_value(&paging_iter);
+                            if (v) self.paging_rate = atoi(v);
+                        } else
+                            ogs_warn("unknown key `%s`", paging_key);
+                    }
                 } else if (!strcmp(amf_key, "ngap")) {
                     ogs_yaml_iter_t ngap_array, ngap_iter;
                     ogs_yaml_iter_recurse(&amf_iter, &ngap_array);
@@ -1146,6 +1188,7 @@ amf_gnb_t *amf_gnb_add(ogs_sock_t *sock, ogs_sockaddr_t *addr)
 {
     amf_gnb_t *gnb = NULL;
     amf_event_t e;
+    int rv;
 
     ogs_assert(sock);
     ogs_assert(addr);
@@ -1162,6 +1205,10 @@ amf_gnb_t *amf_gnb_add(ogs_sock_t *sock, ogs_sockaddr_t *addr)
     gnb->sctp.type = amf_gnb_sock_type(gnb->sctp.sock);
 
     if (gnb->sctp.type == SOCK_STREAM) {
+        /* Reads are drained and writes are batched until EAGAIN */
+        rv = ogs_nonblocking(sock->fd);
+        ogs_assert(rv == OGS_OK);
+
         gnb->sctp.poll.read = ogs_pollset_add(ogs_app()->pollset,
             OGS_POLLIN, sock->fd, ngap_recv_upcall, sock);
         ogs_assert(gnb->sctp.poll.read);
@@ -1172,6 +1219,11 @@ amf_gnb_t *amf_gnb_add(ogs_sock_t *sock, ogs_sockaddr_t *addr)
 
     ogs_list_init(&gnb->ran_ue_list);
 
+    ogs_list_init(&gnb->paging.deferred_list);
+    gnb->paging.t_deferred = ogs_timer_add(ogs_app()->timer_mgr,
+            amf_timer_ng_paging_expire, gnb);
+    ogs_assert(gnb->paging.t_deferred);
+
     ogs_hash_set(self.gnb_addr_hash,
             gnb->sctp.addr, sizeof(ogs_sockaddr_t), gnb);
 
@@ -1191,6 +1243,7 @@ amf_gnb_t *amf_gnb_add(ogs_sock_t *sock, ogs_sockaddr_t *addr)
 void amf_gnb_remove(amf_gnb_t *gnb)
 {
     amf_event_t e;
+    amf_paging_deferred_t *deferred = NULL, *next_deferred = NULL;
 
     ogs_assert(gnb);
     ogs_assert(gnb->sctp.sock);
@@ -1205,6 +1258,12 @@ void amf_gnb_remove(amf_gnb_t *gnb)
             gnb->sctp.addr, sizeof(ogs_sockaddr_t), NULL);
     ogs_hash_set(self.gnb_id_hash, &gnb->gnb_id, sizeof(gnb->gnb_id), NULL);
 
+    amf_gnb_clear_paging_area(gnb);
+
+    ogs_list_for_each_safe(&gnb->paging.deferred_list, next_deferred, deferred)
+        amf_gnb_paging_deferred_remove(gnb, deferred);
+    ogs_timer_delete(gnb->paging.t_deferred);
+
     ogs_sctp_flush_and_destroy(&gnb->sctp);
 
     ogs_pool_free(&amf_gnb_pool, gnb);
@@ -1247,6 +1306,212 @@ int amf_gnb_set_gnb_id(amf_gnb_t *gnb, uint32_t gnb_id)
     return OGS_OK;
 }
 
+static void paging_area_add_gnb(amf_gnb_t *gnb, ogs_5gs_tai_t *tai)
+{
+    amf_paging_area_t *area = NULL;
+    amf_paging_gnb_t *paging_gnb = NULL;
+
+    ogs_assert(gnb);
+    ogs_assert(tai);
+
+    area = ogs_hash_get(self.paging_area_hash, tai, sizeof(*tai));
+    if (!area) {
+        ogs_pool_alloc(&amf_paging_area_pool, &area);
+        if (!area) {
+            ogs_error("amf_paging_area_pool() failed");
+            return;
+        }
+        memset(area, 0, sizeof *area);
+
+        memcpy(&area->tai, tai, sizeof(area->tai));
+        ogs_list_init(&area->gnb_list);
+
+        ogs_hash_set(self.paging_area_hash,
+                &area->tai, sizeof(area->tai), area);
+    } else {
+        /* The same TAI may be listed twice by a gNB */
+        ogs_list_for_each(&area->gnb_list, paging_gnb)
+            if (paging_gnb->gnb == gnb) return;
+    }
+
+    ogs_assert(gnb->paging.num_of_entry <
+            OGS_MAX_NUM_OF_TAI*OGS_MAX_NUM_OF_BPLMN);
+
+    ogs_pool_alloc(&amf_paging_gnb_pool, &paging_gnb);
+    if (!paging_gnb) {
+        ogs_error("amf_paging_gnb_pool() failed");
+        if (ogs_list_first(&area->gnb_list) == NULL) {
+            ogs_hash_set(self.paging_area_hash,
+                    &area->tai, sizeof(area->tai), NULL);
+            ogs_pool_free(&amf_paging_area_pool, area);
+        }
+        return;
+    }
+    memset(paging_gnb, 0, sizeof *paging_gnb);
+
+    paging_gnb->area = area;
+    paging_gnb->gnb = gnb;
+    ogs_list_add(&area->gnb_list, paging_gnb);
+
+    gnb->paging.entry[gnb->paging.num_of_entry++] = paging_gnb;
+}
+
+/*
+ * Rebuild the TAI index of the gNB from its supported_ta_list.
+ * Called when NG Setup or RAN Configuration Update is accepted.
+ */
+void amf_gnb_update_paging_area(amf_gnb_t *gnb)
+{
+    int i, j;
+
+    ogs_assert(gnb);
+
+    amf_gnb_clear_paging_area(gnb);
+
+    for (i = 0; i < gnb->num_of_supported_ta_list; i++) {
+        for (j = 0; j < gnb->supported_ta_list[i].num_of_bplmn_list; j++) {
+            ogs_5gs_tai_t tai;
+
+            memset(&tai, 0, sizeof(tai));
+            memcpy(&tai.plmn_id,
+                    &gnb->supported_ta_list[i].bplmn_list[j].plmn_id,
+                    OGS_PLMN_ID_LEN);
+            tai.tac.v = gnb->supported_ta_list[i].tac.v;
+
+            paging_area_add_gnb(gnb, &tai);
+        }
+    }
+}
+
+void amf_gnb_clear_paging_area(amf_gnb_t *gnb)
+{
+    int i;
+
+    ogs_assert(gnb);
+
+    for (i = 0; i < gnb->paging.num_of_entry; i++) {
+        amf_paging_gnb_t *paging_gnb = gnb->paging.entry[i];
+        amf_paging_area_t *area = NULL;
+
+        ogs_assert(paging_gnb);
+        area = paging_gnb->area;
+        ogs_assert(area);
+
+        ogs_list_remove(&area->gnb_list, paging_gnb);
+        ogs_pool_free(&amf_paging_gnb_pool, paging_gnb);
+
+        if (ogs_list_first(&area->gnb_list) == NULL) {
+            ogs_hash_set(self.paging_area_hash,
+                    &area->tai, sizeof(area->tai), NULL);
+            ogs_pool_free(&amf_paging_area_pool, area);
+        }
+
+        gnb->paging.entry[i] = NULL;
+    }
+
+    gnb->paging.num_of_entry = 0;
+}
+
+amf_paging_area_t *amf_paging_area_find(ogs_5gs_tai_t *tai)
+{
+    ogs_5gs_tai_t key;
+
+    ogs_assert(tai);
+
+    memset(&key, 0, sizeof(key));
+    memcpy(&key.plmn_id, &tai->plmn_id, OGS_PLMN_ID_LEN);
+    key.tac.v = tai->tac.v;
+
+    return (amf_paging_area_t *)ogs_hash_get(
+            self.paging_area_hash, &key, sizeof(key));
+}
+
+/*
+ * Returns true if the gNB has already received `amf.paging.rate` Paging
+ * messages in the current one-second window. The Paging is then kept
+ * with amf_gnb_paging_defer() and sent when the next window opens.
+ */
+bool amf_gnb_paging_is_paced(amf_gnb_t *gnb)
+{
+    ogs_time_t now;
+
+    ogs_assert(gnb);
+
+    if (!self.paging_rate)
+        return false;
+
+    now = ogs_get_monotonic_time();
+    if (now - gnb->paging.window >= ogs_time_from_sec(1)) {
+        gnb->paging.window = now;
+        gnb->paging.count = 0;
+    }
+
+    if (gnb->paging.count >= self.paging_rate)
+        return true;
+
+    gnb->paging.count++;
+
+    return false;
+}
+
+/*
+ * Keeps the Paging of the UE for the next pacing window of the gNB.
+ * Returns false if it cannot be kept. The UE is then paged again
+ * when T3513 expires.
+ */
+bool amf_gnb_paging_defer(amf_gnb_t *gnb, amf_ue_t *amf_ue)
+{
+    amf_paging_deferred_t *deferred = NULL;
+
+    ogs_assert(gnb);
+    ogs_assert(amf_ue);
+
+    ogs_list_for_each(&gnb->paging.deferred_list, deferred) {
+        if (deferred->amf_ue == amf_ue)
+            return true;
+    }
+
+    ogs_pool_alloc(&amf_paging_deferred_pool, &deferred);
+    if (!deferred) {
+        ogs_error("Paging deferral pool is full [GNB_ID:0x%x]", gnb->gnb_id);
+        return false;
+    }
+    memset(deferred, 0, sizeof *deferred);
+
+    deferred->amf_ue = amf_ue;
+    ogs_list_add(&gnb->paging.deferred_list, deferred);
+
+    if (gnb->paging.t_deferred->running == false)
+        amf_gnb_paging_schedule(gnb);
+
+    return true;
+}
+
+void amf_gnb_paging_deferred_remove(
+        amf_gnb_t *gnb, amf_paging_deferred_t *deferred)
+{
+    ogs_assert(gnb);
+    ogs_assert(deferred);
+
+    ogs_list_remove(&gnb->paging.deferred_list, deferred);
+    ogs_pool_free(&amf_paging_deferred_pool, deferred);
+}
+
+/* Wakes up when the next pacing window of the gNB opens */
+void amf_gnb_paging_schedule(amf_gnb_t *gnb)
+{
+    ogs_time_t duration;
+
+    ogs_assert(gnb);
+
+    duration = gnb->paging.window + ogs_time_from_sec(1) -
+        ogs_get_monotonic_time();
+    if (duration < ogs_time_from_msec(1))
+        duration = ogs_time_from_msec(1);
+
+    ogs_timer_start(gnb->paging.t_deferred, duration);
+}
+
 int amf_gnb_sock_type(ogs_sock_t *sock)
 {
     ogs_socknode_t *snode = NULL;
@@ -110,12 +110,18 @@ typedef struct amf_context_s {
     ogs_hash_t      *guti_ue_hash;          /* hash table (GUTI : AMF_UE) */
     ogs_hash_t      *suci_hash;     /* hash table (SUCI) */
     ogs_hash_t      *supi_hash;     /* hash table (SUPI) */
+    ogs_hash_t      *paging_area_hash;  /* hash table (TAI : Paging Area) */
+
+    /* Max number of Paging per second for each gNB, 0 = no limit */
+    int             paging_rate;
 
     uint16_t        ngap_port;      /* Default NGAP Port */
 
     ogs_list_t      ngap_list;      /* AMF NGAP IPv4 Server List */
     ogs_list_t      ngap_list6;     /* AMF NGAP IPv6 Server List */
 
+    int             num_of_ngap_thread; /* NGAP decode worker threads */
+
     struct {
         struct {
             ogs_time_t value;       /* Timer Value(Seconds) */
@@ -151,6 +157,18 @@ typedef struct amf_gnb_s {
         } bplmn_list[OGS_MAX_NUM_OF_BPLMN];
     } supported_ta_list[OGS_MAX_NUM_OF_TAI];
 
+    struct {
+        /* Entries of the TAI index built from supported_ta_list */
+        int num_of_entry;
+        struct amf_paging_gnb_s *entry[OGS_MAX_NUM_OF_TAI*OGS_MAX_NUM_OF_BPLMN];
+
+        ogs_time_t window;      /* Start of the current pacing window */
+        int count;              /* Paging sent within the window */
+
+        ogs_list_t deferred_list;   /* Paging over the rate */
+        ogs_timer_t *t_deferred;    /* Opens the next pacing window */
+    } paging;
+
     OpenAPI_rat_type_e rat_type;
 
     ogs_pkbuf_t     *ng_reset_ack; /* Reset message */
@@ -159,6 +177,26 @@ typedef struct amf_gnb_s {
 
 } amf_gnb_t;
 
+/* gNBs serving a TAI, so that Paging does not scan every gNB */
+typedef struct amf_paging_area_s {
+    ogs_5gs_tai_t   tai;            /* Key of paging_area_hash */
+    ogs_list_t      gnb_list;       /* List of amf_paging_gnb_t */
+} amf_paging_area_t;
+
+typedef struct amf_paging_gnb_s {
+    ogs_lnode_t     lnode;          /* A node of amf_paging_area_t */
+
+    amf_paging_area_t *area;
+    amf_gnb_t       *gnb;
+} amf_paging_gnb_t;
+
+/* Paging held back by amf.paging.rate until the next pacing window */
+typedef struct amf_paging_deferred_s {
+    ogs_lnode_t     lnode;          /* A node of deferred_list of amf_gnb_t */
+
+    amf_ue_t        *amf_ue;
+} amf_paging_deferred_t;
+
 struct ran_ue_s {
     ogs_lnode_t     lnode;
     uint32_t        index;
@@ -667,6 +705,15 @@ int amf_gnb_set_gnb_id(amf_gnb_t *gnb, uint32_t gnb_id);
 int amf_gnb_sock_type(ogs_sock_t *sock);
 amf_gnb_t *amf_gnb_cycle(amf_gnb_t *gnb);
 
+void amf_gnb_update_paging_area(amf_gnb_t *gnb);
+void amf_gnb_clear_paging_area(amf_gnb_t *gnb);
+amf_paging_area_t *amf_paging_area_find(ogs_5gs_tai_t *tai);
+bool amf_gnb_paging_is_paced(amf_gnb_t *gnb);
+bool amf_gnb_paging_defer(amf_gnb_t *gnb, amf_ue_t *amf_ue);
+void amf_gnb_paging_deferred_remove(
+        amf_gnb_t *gnb, amf_paging_deferred_t *deferred);
+void amf_gnb_paging_schedule(amf_gnb_t *gnb);
+
 ran_ue_t *ran_ue_add(amf_gnb_t *gnb, uint32_t ran_ue_ngap_id);
 void ran_ue_remove(ran_ue_t *ran_ue);
 void ran_ue_switch_to_gnb(ran_ue_t *ran_ue, amf_gnb_t *new_gnb);
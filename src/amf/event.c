@@ -19,6 +19,7 @@
 
 #include "event.h"
 #include "context.h"
+#include "ngap-path.h"
 
 amf_event_t *amf_event_new(int id)
 {
@@ -100,6 +101,19 @@ void amf_sctp_event_push(int id,
     e->ngap.max_num_of_istreams = max_num_of_istreams;
     e->ngap.max_num_of_ostreams = max_num_of_ostreams;
 
+    if (amf_self()->num_of_ngap_thread) {
+        /* The NGAP worker decodes the message and notifies the main loop */
+        rv = ngap_worker_push(e);
+        if (rv != OGS_OK) {
+            ogs_error("ngap_worker_push() failed:%d", (int)rv);
+            ogs_free(e->ngap.addr);
+            if (e->pkbuf)
+                ogs_pkbuf_free(e->pkbuf);
+            ogs_event_free(e);
+        }
+        return;
+    }
+
     rv = ogs_queue_push(ogs_app()->queue, e);
     if (rv != OGS_OK) {
         ogs_error("ogs_queue_push() failed:%d", (int)rv);
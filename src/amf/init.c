@@ -55,6 +55,11 @@ int amf_initialize(void)
     rv = amf_sbi_open();
     if (rv != OGS_OK) return rv;
 
+    if (amf_self()->num_of_ngap_thread) {
+        rv = ngap_worker_init(amf_self()->num_of_ngap_thread);
+        if (rv != OGS_OK) return rv;
+    }
+
     rv = ngap_open();
     if (rv != OGS_OK) return rv;
 
@@ -96,6 +101,7 @@ void amf_terminate(void)
     ogs_thread_destroy(thread);
     ogs_timer_delete(t_termination_holding);
 
+    ngap_worker_final();
     ngap_close();
     amf_sbi_close();
 
@@ -352,6 +352,7 @@ void amf_metrics_init(void)
 {
     ogs_metrics_context_t *ctx = ogs_metrics_self();
     ogs_metrics_context_init();
+    ogs_sbi_metrics_init();
 
     amf_metrics_init_spec(ctx, amf_metrics_spec_global, amf_metrics_spec_def_global,
             _AMF_METR_GLOB_MAX);
@@ -402,5 +403,6 @@ void amf_metrics_final(void)
         ogs_hash_destroy(metrics_hash_by_cause);
     }
 
+    ogs_sbi_metrics_final();
     ogs_metrics_context_final();
 }
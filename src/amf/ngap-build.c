@@ -300,6 +300,7 @@ ogs_pkbuf_t *ngap_build_downlink_nas_transport(
     ran_ue_t *ran_ue, ogs_pkbuf_t *gmmbuf, bool ue_ambr, bool allowed_nssai)
 {
     amf_ue_t *amf_ue = NULL;
+    ogs_pkbuf_t *ngapbuf = NULL;
 
     NGAP_NGAP_PDU_t pdu;
     NGAP_InitiatingMessage_t *initiatingMessage = NULL;
@@ -320,6 +321,29 @@ ogs_pkbuf_t *ngap_build_downlink_nas_transport(
 
     ogs_debug("DownlinkNASTransport");
 
+    /*
+     * TS 38.413
+     * 8.6.2 Downlink NAS Transport
+     * 8.6.2.1. Successful Operation
+     *
+     * The UE Aggregate Maximum Bit Rate IE should be sent to the NG-RAN node
+     * if the AMF has not sent it previously
+     */
+    if (ran_ue->ue_ambr_sent == true || !ue_ambr ||
+        !amf_ue->ue_ambr.downlink || !amf_ue->ue_ambr.uplink)
+        ue_ambr = false;
+
+    if (!ue_ambr && !allowed_nssai) {
+        ngapbuf = ogs_ngap_build_downlink_nas_transport(
+                ran_ue->amf_ue_ngap_id, ran_ue->ran_ue_ngap_id, gmmbuf);
+        if (ngapbuf) {
+            ogs_debug("    RAN_UE_NGAP_ID[%d] AMF_UE_NGAP_ID[%lld]",
+                    ran_ue->ran_ue_ngap_id, (long long)ran_ue->amf_ue_ngap_id);
+            ogs_pkbuf_free(gmmbuf);
+            return ngapbuf;
+        }
+    }
+
     memset(&pdu, 0, sizeof (NGAP_NGAP_PDU_t));
     pdu.present = NGAP_NGAP_PDU_PR_initiatingMessage;
     pdu.choice.initiatingMessage = CALLOC(1, sizeof(NGAP_InitiatingMessage_t));
@@ -372,16 +396,7 @@ ogs_pkbuf_t *ngap_build_downlink_nas_transport(
     memcpy(NAS_PDU->buf, gmmbuf->data, NAS_PDU->size);
     ogs_pkbuf_free(gmmbuf);
 
-    /*
-     * TS 38.413
-     * 8.6.2 Downlink NAS Transport
-     * 8.6.2.1. Successful Operation
-     *
-     * The UE Aggregate Maximum Bit Rate IE should be sent to the NG-RAN node
-     * if the AMF has not sent it previously
-     */
-    if (ran_ue->ue_ambr_sent == false && ue_ambr &&
-        amf_ue->ue_ambr.downlink && amf_ue->ue_ambr.uplink) {
+    if (ue_ambr) {
         ogs_assert(amf_ue);
 
         ie = CALLOC(1, sizeof(NGAP_DownlinkNASTransport_IEs_t));
@@ -366,6 +366,8 @@ void ngap_handle_ng_setup_request(amf_gnb_t *gnb, ogs_ngap_message_t *message)
     amf_gnb_set_gnb_id(gnb, gnb_id);
 
     gnb->state.ng_setup_success = true;
+    amf_gnb_update_paging_area(gnb);
+
     r = ngap_send_ng_setup_response(gnb);
     ogs_expect(r == OGS_OK);
     ogs_assert(r != OGS_ERROR);
@@ -4298,6 +4300,8 @@ void ngap_handle_ran_configuration_update(
             ogs_assert(r != OGS_ERROR);
             return;
         }
+
+        amf_gnb_update_paging_area(gnb);
     }
 
     if (PagingDRX)
@@ -411,8 +411,9 @@ int ngap_send_amf_ue_context_release_command(
 int ngap_send_paging(amf_ue_t *amf_ue)
 {
     ogs_pkbuf_t *ngapbuf = NULL;
-    amf_gnb_t *gnb = NULL;
-    int i, j;
+    amf_paging_area_t *area = NULL;
+    amf_paging_gnb_t *paging_gnb = NULL;
+    int sent = 0, deferred = 0;
     int rv;
 
     ogs_debug("NG-Paging");
@@ -422,42 +423,56 @@ int ngap_send_paging(amf_ue_t *amf_ue)
         return OGS_NOTFOUND;
     }
 
-    ogs_list_for_each(&amf_self()->gnb_list, gnb) {
-        for (i = 0; i < gnb->num_of_supported_ta_list; i++) {
-            for (j = 0; j < gnb->supported_ta_list[i].num_of_bplmn_list; j++) {
-                if (memcmp(&gnb->supported_ta_list[i].bplmn_list[j].plmn_id,
-                            &amf_ue->nr_tai.plmn_id, OGS_PLMN_ID_LEN) == 0 &&
-                    gnb->supported_ta_list[i].tac.v == amf_ue->nr_tai.tac.v) {
-
-                    if (amf_ue->t3513.pkbuf) {
-                        ngapbuf = amf_ue->t3513.pkbuf;
-                    } else {
-                        ngapbuf = ngap_build_paging(amf_ue);
-                        if (!ngapbuf) {
-                            ogs_error("ngap_build_paging() failed");
-                            return OGS_ERROR;
-                        }
-                    }
-
-                    amf_ue->t3513.pkbuf = ogs_pkbuf_copy(ngapbuf);
-                    if (!amf_ue->t3513.pkbuf) {
-                        ogs_error("ogs_pkbuf_copy() failed");
-                        ogs_pkbuf_free(ngapbuf);
-                        return OGS_ERROR;
-                    }
-
-                    amf_metrics_inst_global_inc(AMF_METR_GLOB_CTR_MM_PAGING_5G_REQ);
-
-                    rv = ngap_send_to_gnb(gnb, ngapbuf, NGAP_NON_UE_SIGNALLING);
-                    if (rv != OGS_OK) {
-                        ogs_error("ngap_send_to_gnb() failed");
-                        return rv;
-                    }
-                }
+    /* Only the gNBs serving the UE's TAI */
+    area = amf_paging_area_find(&amf_ue->nr_tai);
+    if (area && ogs_list_first(&area->gnb_list)) {
+        /*
+         * The Paging PDU is built once and kept for T3513.
+         * Each gNB gets a reference to the same cluster.
+         */
+        if (!amf_ue->t3513.pkbuf) {
+            amf_ue->t3513.pkbuf = ngap_build_paging(amf_ue);
+            if (!amf_ue->t3513.pkbuf) {
+                ogs_error("ngap_build_paging() failed");
+                return OGS_ERROR;
             }
         }
+
+        ogs_list_for_each(&area->gnb_list, paging_gnb) {
+            amf_gnb_t *gnb = paging_gnb->gnb;
+            ogs_assert(gnb);
+
+            if (amf_gnb_paging_is_paced(gnb) == true) {
+                ogs_debug("Paging deferred [GNB_ID:0x%x]", gnb->gnb_id);
+                if (amf_gnb_paging_defer(gnb, amf_ue) == true)
+                    deferred++;
+                continue;
+            }
+
+            ngapbuf = ogs_pkbuf_copy(amf_ue->t3513.pkbuf);
+            if (!ngapbuf) {
+                ogs_error("ogs_pkbuf_copy() failed");
+                return OGS_ERROR;
+            }
+
+            amf_metrics_inst_global_inc(AMF_METR_GLOB_CTR_MM_PAGING_5G_REQ);
+
+            rv = ngap_send_to_gnb(gnb, ngapbuf, NGAP_NON_UE_SIGNALLING);
+            if (rv != OGS_OK) {
+                ogs_error("ngap_send_to_gnb() failed");
+                return rv;
+            }
+            sent++;
+        }
     }
 
+    /*
+     * If every gNB deferred the Paging, T3513 is started
+     * when the first deferred Paging is sent.
+     */
+    if (!sent && deferred)
+        return OGS_OK;
+
     /* Start T3513 */
     ogs_timer_start(amf_ue->t3513.timer, 
             amf_timer_cfg(AMF_TIMER_T3513)->duration);
@@ -465,6 +480,55 @@ int ngap_send_paging(amf_ue_t *amf_ue)
     return OGS_OK;
 }
 
+/* Sends the Paging deferred by amf.paging.rate in the new pacing window */
+int ngap_send_deferred_paging(amf_gnb_t *gnb)
+{
+    ogs_pkbuf_t *ngapbuf = NULL;
+    amf_paging_deferred_t *deferred = NULL, *next_deferred = NULL;
+    amf_ue_t *amf_ue = NULL;
+    int rv;
+
+    ogs_assert(gnb);
+
+    ogs_list_for_each_safe(&gnb->paging.deferred_list,
+            next_deferred, deferred) {
+        amf_ue = amf_ue_cycle(deferred->amf_ue);
+
+        /* The UE has been removed, or the Paging is over */
+        if (!amf_ue || !amf_ue->t3513.pkbuf) {
+            amf_gnb_paging_deferred_remove(gnb, deferred);
+            continue;
+        }
+
+        if (amf_gnb_paging_is_paced(gnb) == true) {
+            amf_gnb_paging_schedule(gnb);
+            break;
+        }
+
+        amf_gnb_paging_deferred_remove(gnb, deferred);
+
+        ngapbuf = ogs_pkbuf_copy(amf_ue->t3513.pkbuf);
+        if (!ngapbuf) {
+            ogs_error("ogs_pkbuf_copy() failed");
+            return OGS_ERROR;
+        }
+
+        amf_metrics_inst_global_inc(AMF_METR_GLOB_CTR_MM_PAGING_5G_REQ);
+
+        rv = ngap_send_to_gnb(gnb, ngapbuf, NGAP_NON_UE_SIGNALLING);
+        if (rv != OGS_OK) {
+            ogs_error("ngap_send_to_gnb() failed");
+            return rv;
+        }
+
+        /* The deferral does not use up a T3513 retry */
+        ogs_timer_start(amf_ue->t3513.timer,
+                amf_timer_cfg(AMF_TIMER_T3513)->duration);
+    }
+
+    return OGS_OK;
+}
+
 int ngap_send_downlink_ran_configuration_transfer(
         amf_gnb_t *target_gnb, NGAP_SONConfigurationTransfer_t *transfer)
 {
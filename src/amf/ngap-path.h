@@ -33,6 +33,10 @@ extern "C" {
 int ngap_open(void);
 void ngap_close(void);
 
+int ngap_worker_init(int num_of_thread);
+void ngap_worker_final(void);
+int ngap_worker_push(amf_event_t *e);
+
 ogs_sock_t *ngap_server(ogs_socknode_t *node);
 void ngap_recv_upcall(short when, ogs_socket_t fd, void *data);
 
@@ -60,6 +64,7 @@ int ngap_send_amf_ue_context_release_command(
     uint8_t action, ogs_time_t duration);
 
 int ngap_send_paging(amf_ue_t *amf_ue);
+int ngap_send_deferred_paging(amf_gnb_t *gnb);
 
 int ngap_send_downlink_ran_configuration_transfer(
         amf_gnb_t *target_gnb, NGAP_SONConfigurationTransfer_t *transfer);
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ngap-path.h"
+
+/*
+ * NGAP decode workers
+ *
+ * The APER decoding of the NGAP PDU runs in the worker threads.
+ * The decoded message is handed back to the AMF main loop,
+ * which owns all the gNB/UE contexts and runs every state machine.
+ *
+ * All SCTP events of a gNB are dispatched to the same worker
+ * by the hash of the gNB address. The worker queue is FIFO,
+ * so the events of a gNB are delivered to the main loop in order.
+ */
+
+static struct {
+    int num_of_thread;
+    ogs_thread_t **thread;
+
+    ogs_queue_t **queue;
+} worker;
+
+static void worker_main(void *data);
+
+static void event_free(amf_event_t *e)
+{
+    ogs_assert(e);
+
+    if (e->ngap.message) {
+        ogs_ngap_free(e->ngap.message);
+        ogs_free(e->ngap.message);
+    }
+    if (e->ngap.addr)
+        ogs_free(e->ngap.addr);
+    if (e->pkbuf)
+        ogs_pkbuf_free(e->pkbuf);
+    ogs_event_free(e);
+}
+
+static unsigned int addr_hash(ogs_sockaddr_t *addr)
+{
+    unsigned int hash = 0;
+    int len;
+
+    ogs_assert(addr);
+
+    if (addr->ogs_sa_family == AF_INET) {
+        len = sizeof(addr->sin.sin_addr);
+        hash = ogs_hashfunc_default((const char *)&addr->sin.sin_addr, &len);
+    } else if (addr->ogs_sa_family == AF_INET6) {
+        len = sizeof(addr->sin6.sin6_addr);
+        hash = ogs_hashfunc_default((const char *)&addr->sin6.sin6_addr, &len);
+    }
+
+    return hash ^ be16toh(addr->ogs_sin_port);
+}
+
+int ngap_worker_init(int num_of_thread)
+{
+    int i;
+
+    ogs_assert(num_of_thread > 0);
+    ogs_assert(worker.num_of_thread == 0);
+
+    worker.queue = ogs_calloc(num_of_thread, sizeof(ogs_queue_t *));
+    ogs_assert(worker.queue);
+    worker.thread = ogs_calloc(num_of_thread, sizeof(ogs_thread_t *));
+    ogs_assert(worker.thread);
+
+    for (i = 0; i < num_of_thread; i++) {
+        worker.queue[i] = ogs_queue_create(ogs_app()->pool.event);
+        ogs_assert(worker.queue[i]);
+    }
+
+    for (i = 0; i < num_of_thread; i++) {
+        worker.thread[i] = ogs_thread_create(worker_main, worker.queue[i]);
+        if (!worker.thread[i]) {
+            ogs_error("ogs_thread_create() failed");
+            worker.num_of_thread = i;
+            while (i < num_of_thread)
+                ogs_queue_destroy(worker.queue[i++]);
+            ngap_worker_final();
+            return OGS_ERROR;
+        }
+    }
+
+    worker.num_of_thread = num_of_thread;
+
+    ogs_info("NGAP worker thread [%d]", worker.num_of_thread);
+
+    return OGS_OK;
+}
+
+void ngap_worker_final(void)
+{
+    int i, rv;
+
+    if (!worker.queue)
+        return;
+
+    for (i = 0; i < worker.num_of_thread; i++)
+        ogs_queue_term(worker.queue[i]);
+
+    for (i = 0; i < worker.num_of_thread; i++) {
+        ogs_thread_destroy(worker.thread[i]);
+
+        /* The AMF main loop has already exited. Drop the pending events */
+        for ( ;; ) {
+            amf_event_t *e = NULL;
+
+            rv = ogs_queue_trypop(worker.queue[i], (void**)&e);
+            if (rv != OGS_OK)
+                break;
+
+            event_free(e);
+        }
+
+        ogs_queue_destroy(worker.queue[i]);
+    }
+
+    ogs_free(worker.queue);
+    ogs_free(worker.thread);
+
+    memset(&worker, 0, sizeof(worker));
+}
+
+int ngap_worker_push(amf_event_t *e)
+{
+    ogs_assert(e);
+    ogs_assert(e->ngap.addr);
+    ogs_assert(worker.num_of_thread);
+
+    /*
+     * Never block here. The worker may be waiting for the main loop
+     * to drain its own queue.
+     */
+    return ogs_queue_trypush(worker.queue[
+            addr_hash(e->ngap.addr) % worker.num_of_thread], e);
+}
+
+static void worker_main(void *data)
+{
+    ogs_queue_t *queue = data;
+    int rv;
+
+    ogs_assert(queue);
+
+    for ( ;; ) {
+        amf_event_t *e = NULL;
+
+        rv = ogs_queue_pop(queue, (void**)&e);
+        if (rv == OGS_DONE)
+            break;
+
+        if (rv != OGS_OK)
+            continue;
+
+        ogs_assert(e);
+
+        if (e->h.id == AMF_EVENT_NGAP_MESSAGE) {
+            ogs_ngap_message_t *message = NULL;
+
+            ogs_assert(e->pkbuf);
+
+            message = ogs_calloc(1, sizeof(*message));
+            ogs_assert(message);
+
+            /*
+             * If the decoding fails, the event is passed without the message.
+             * The main loop decodes it again and sends the Error Indication.
+             */
+            if (ogs_ngap_decode(message, e->pkbuf) == OGS_OK) {
+                e->ngap.message = message;
+            } else {
+                /* A partially decoded message must be released as well */
+                ogs_ngap_free(message);
+                ogs_free(message);
+            }
+        }
+
+        rv = ogs_queue_push(ogs_app()->queue, e);
+        if (rv != OGS_OK) {
+            ogs_error("ogs_queue_push() failed:%d", (int)rv);
+            event_free(e);
+        } else {
+            ogs_pollset_notify(ogs_app()->pollset);
+        }
+    }
+}
@@ -32,6 +32,7 @@ typedef enum {
 
     AMF_TIMER_NG_DELAYED_SEND,
     AMF_TIMER_NG_HOLDING,
+    AMF_TIMER_NG_PAGING,
 
     AMF_TIMER_T3513,
     AMF_TIMER_T3522,
@@ -66,6 +67,7 @@ void amf_timer_t3560_expire(void *data);
 void amf_timer_t3570_expire(void *data);
 
 void amf_timer_ng_holding_timer_expire(void *data);
+void amf_timer_ng_paging_expire(void *data);
 
 void amf_timer_mobile_reachable_expire(void *data);
 void amf_timer_implicit_deregistration_expire(void *data);
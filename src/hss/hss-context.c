@@ -349,14 +349,12 @@ int hss_db_auth_info(char *imsi_bcd, ogs_dbi_auth_info_t *auth_info)
     ogs_assert(imsi_bcd);
     ogs_assert(auth_info);
 
-    ogs_thread_mutex_lock(&self.db_lock);
     supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
     ogs_assert(supi);
 
     rv = ogs_dbi_auth_info(supi, auth_info);
 
     ogs_free(supi);
-    ogs_thread_mutex_unlock(&self.db_lock);
 
     return rv;
 }
@@ -368,14 +366,12 @@ int hss_db_update_sqn(char *imsi_bcd, uint8_t *rand, uint64_t sqn)
 
     ogs_assert(imsi_bcd);
 
-    ogs_thread_mutex_lock(&self.db_lock);
     supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
     ogs_assert(supi);
 
     rv = ogs_dbi_update_sqn(supi, sqn);
 
     ogs_free(supi);
-    ogs_thread_mutex_unlock(&self.db_lock);
 
     return rv;
 }
@@ -387,14 +383,12 @@ int hss_db_update_imeisv(char *imsi_bcd, char *imeisv)
 
     ogs_assert(imsi_bcd);
 
-    ogs_thread_mutex_lock(&self.db_lock);
     supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
     ogs_assert(supi);
 
     rv = ogs_dbi_update_imeisv(supi, imeisv);
 
     ogs_free(supi);
-    ogs_thread_mutex_unlock(&self.db_lock);
 
     return rv;
 }
@@ -407,14 +401,12 @@ int hss_db_update_mme(char *imsi_bcd, char *mme_host, char *mme_realm,
 
     ogs_assert(imsi_bcd);
 
-    ogs_thread_mutex_lock(&self.db_lock);
     supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
     ogs_assert(supi);
 
     rv = ogs_dbi_update_mme(supi, mme_host, mme_realm, purge_flag);
 
     ogs_free(supi);
-    ogs_thread_mutex_unlock(&self.db_lock);
 
     return rv;
 }
@@ -426,14 +418,12 @@ int hss_db_increment_sqn(char *imsi_bcd)
 
     ogs_assert(imsi_bcd);
 
-    ogs_thread_mutex_lock(&self.db_lock);
     supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
     ogs_assert(supi);
 
     rv = ogs_dbi_increment_sqn(supi);
 
     ogs_free(supi);
-    ogs_thread_mutex_unlock(&self.db_lock);
 
     return rv;
 }
@@ -447,14 +437,12 @@ int hss_db_subscription_data(
     ogs_assert(imsi_bcd);
     ogs_assert(subscription_data);
 
-    ogs_thread_mutex_lock(&self.db_lock);
     supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
     ogs_assert(supi);
 
     rv = ogs_dbi_subscription_data(supi, subscription_data);
 
     ogs_free(supi);
-    ogs_thread_mutex_unlock(&self.db_lock);
 
     return rv;
 }
@@ -466,12 +454,8 @@ int hss_db_msisdn_data(char *imsi_or_msisdn_bcd, ogs_msisdn_data_t *msisdn_data)
     ogs_assert(imsi_or_msisdn_bcd);
     ogs_assert(msisdn_data);
 
-    ogs_thread_mutex_lock(&self.db_lock);
-
     rv = ogs_dbi_msisdn_data(imsi_or_msisdn_bcd, msisdn_data);
 
-    ogs_thread_mutex_unlock(&self.db_lock);
-
     return rv;
 }
 
@@ -483,14 +467,12 @@ int hss_db_ims_data(char *imsi_bcd, ogs_ims_data_t *ims_data)
     ogs_assert(imsi_bcd);
     ogs_assert(ims_data);
 
-    ogs_thread_mutex_lock(&self.db_lock);
     supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
     ogs_assert(supi);
 
     rv = ogs_dbi_ims_data(supi, ims_data);
 
     ogs_free(supi);
-    ogs_thread_mutex_unlock(&self.db_lock);
 
     return rv;
 }
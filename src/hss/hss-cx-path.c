@@ -990,26 +990,26 @@ int hss_cx_init(void)
 
     /* Specific handler for User-Authorization-Request */
     data.command = ogs_diam_cx_cmd_uar;
-    ret = fd_disp_register(hss_ogs_diam_cx_uar_cb, DISP_HOW_CC, &data, NULL,
-                &hdl_cx_uar);
+    ret = ogs_diam_async_register(hss_ogs_diam_cx_uar_cb,
+                DISP_HOW_CC, &data, NULL, &hdl_cx_uar);
     ogs_assert(ret == 0);
 
     /* Specific handler for Multimedia-Auth-Request */
     data.command = ogs_diam_cx_cmd_mar;
-    ret = fd_disp_register(hss_ogs_diam_cx_mar_cb, DISP_HOW_CC, &data, NULL,
-                &hdl_cx_mar);
+    ret = ogs_diam_async_register(hss_ogs_diam_cx_mar_cb,
+                DISP_HOW_CC, &data, NULL, &hdl_cx_mar);
     ogs_assert(ret == 0);
 
     /* Specific handler for Server-Assignment-Request */
     data.command = ogs_diam_cx_cmd_sar;
-    ret = fd_disp_register(hss_ogs_diam_cx_sar_cb, DISP_HOW_CC, &data, NULL,
-                &hdl_cx_sar);
+    ret = ogs_diam_async_register(hss_ogs_diam_cx_sar_cb,
+                DISP_HOW_CC, &data, NULL, &hdl_cx_sar);
     ogs_assert(ret == 0);
 
     /* Specific handler for Location-Info-Request */
     data.command = ogs_diam_cx_cmd_lir;
-    ret = fd_disp_register(hss_ogs_diam_cx_lir_cb, DISP_HOW_CC, &data, NULL,
-                &hdl_cx_lir);
+    ret = ogs_diam_async_register(hss_ogs_diam_cx_lir_cb,
+                DISP_HOW_CC, &data, NULL, &hdl_cx_lir);
     ogs_assert(ret == 0);
 
     /* Advertise the support for the application in the peer */
@@ -1024,11 +1024,11 @@ void hss_cx_final(void)
     if (hdl_cx_fb)
         (void) fd_disp_unregister(&hdl_cx_fb, NULL);
     if (hdl_cx_uar)
-        (void) fd_disp_unregister(&hdl_cx_uar, NULL);
+        (void) ogs_diam_async_unregister(&hdl_cx_uar);
     if (hdl_cx_mar)
-        (void) fd_disp_unregister(&hdl_cx_mar, NULL);
+        (void) ogs_diam_async_unregister(&hdl_cx_mar);
     if (hdl_cx_sar)
-        (void) fd_disp_unregister(&hdl_cx_sar, NULL);
+        (void) ogs_diam_async_unregister(&hdl_cx_sar);
     if (hdl_cx_lir)
-        (void) fd_disp_unregister(&hdl_cx_lir, NULL);
+        (void) ogs_diam_async_unregister(&hdl_cx_lir);
 }
@@ -30,6 +30,12 @@ int hss_fd_init(void)
                 hss_self()->diam_conf_path, hss_self()->diam_config);
     ogs_assert(rv == 0);
 
+    if (ogs_app()->num_of_diameter_thread) {
+        rv = ogs_diam_async_init(ogs_app()->num_of_diameter_thread,
+                ogs_app()->pool.event);
+        ogs_assert(rv == OGS_OK);
+    }
+
     rv = hss_s6a_init();
     ogs_assert(rv == OGS_OK);
     rv = hss_cx_init();
@@ -49,5 +55,8 @@ void hss_fd_final(void)
     hss_cx_final();
     hss_swx_final();
 
+    /* The handlers are unregistered, so nothing is queued any more */
+    ogs_diam_async_final();
+
     ogs_diam_final();
 }
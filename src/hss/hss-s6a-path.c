@@ -1532,20 +1532,20 @@ int hss_s6a_init(void)
 
     /* Specific handler for Authentication-Information-Request */
     data.command = ogs_diam_s6a_cmd_air;
-    ret = fd_disp_register(hss_ogs_diam_s6a_air_cb, DISP_HOW_CC, &data, NULL,
-                &hdl_s6a_air);
+    ret = ogs_diam_async_register(hss_ogs_diam_s6a_air_cb,
+                DISP_HOW_CC, &data, NULL, &hdl_s6a_air);
     ogs_assert(ret == 0);
 
     /* Specific handler for Location-Update-Request */
     data.command = ogs_diam_s6a_cmd_ulr;
-    ret = fd_disp_register(hss_ogs_diam_s6a_ulr_cb, DISP_HOW_CC, &data, NULL,
-                &hdl_s6a_ulr);
+    ret = ogs_diam_async_register(hss_ogs_diam_s6a_ulr_cb,
+                DISP_HOW_CC, &data, NULL, &hdl_s6a_ulr);
     ogs_assert(ret == 0);
 
     /* Specific handler for Purge-UE-Request */
     data.command = ogs_diam_s6a_cmd_pur;
-    ret = fd_disp_register(hss_ogs_diam_s6a_pur_cb, DISP_HOW_CC, &data, NULL,
-                &hdl_s6a_pur);
+    ret = ogs_diam_async_register(hss_ogs_diam_s6a_pur_cb,
+                DISP_HOW_CC, &data, NULL, &hdl_s6a_pur);
     ogs_assert(ret == 0);
 
     /* Advertise the support for the application in the peer */
@@ -1565,9 +1565,9 @@ void hss_s6a_final(void)
     if (hdl_s6a_fb)
         (void) fd_disp_unregister(&hdl_s6a_fb, NULL);
     if (hdl_s6a_air)
-        (void) fd_disp_unregister(&hdl_s6a_air, NULL);
+        (void) ogs_diam_async_unregister(&hdl_s6a_air);
     if (hdl_s6a_ulr)
-        (void) fd_disp_unregister(&hdl_s6a_ulr, NULL);
+        (void) ogs_diam_async_unregister(&hdl_s6a_ulr);
     if (hdl_s6a_pur)
-        (void) fd_disp_unregister(&hdl_s6a_pur, NULL);
+        (void) ogs_diam_async_unregister(&hdl_s6a_pur);
 }
@@ -923,14 +923,14 @@ int hss_swx_init(void)
 
     /* Specific handler for Multimedia-Auth-Request */
     data.command = ogs_diam_cx_cmd_mar;
-    ret = fd_disp_register(hss_ogs_diam_swx_mar_cb, DISP_HOW_CC, &data, NULL,
-                &hdl_swx_mar);
+    ret = ogs_diam_async_register(hss_ogs_diam_swx_mar_cb,
+                DISP_HOW_CC, &data, NULL, &hdl_swx_mar);
     ogs_assert(ret == 0);
 
     /* Specific handler for Server-Assignment-Request */
     data.command = ogs_diam_cx_cmd_sar;
-    ret = fd_disp_register(hss_ogs_diam_swx_sar_cb, DISP_HOW_CC, &data, NULL,
-                &hdl_swx_sar);
+    ret = ogs_diam_async_register(hss_ogs_diam_swx_sar_cb,
+                DISP_HOW_CC, &data, NULL, &hdl_swx_sar);
     ogs_assert(ret == 0);
 
     /* Advertise the support for the application in the peer */
@@ -945,7 +945,7 @@ void hss_swx_final(void)
     if (hdl_swx_fb)
         (void) fd_disp_unregister(&hdl_swx_fb, NULL);
     if (hdl_swx_mar)
-        (void) fd_disp_unregister(&hdl_swx_mar, NULL);
+        (void) ogs_diam_async_unregister(&hdl_swx_mar);
     if (hdl_swx_sar)
-        (void) fd_disp_unregister(&hdl_swx_sar, NULL);
+        (void) ogs_diam_async_unregister(&hdl_swx_sar);
 }
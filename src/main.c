@@ -102,6 +102,7 @@ int main(int argc, const char *const argv[])
      */
     int rv, i, opt;
     ogs_getopt_t options;
+    ogs_time_t started;
     struct {
         char *config_file;
         char *log_file;
@@ -199,6 +200,8 @@ int main(int argc, const char *const argv[])
 
     argv_out[i] = NULL;
 
+    started = ogs_get_monotonic_time();
+
     ogs_signal_init();
     ogs_setup_signal_thread();
 
@@ -220,6 +223,10 @@ int main(int argc, const char *const argv[])
         return OGS_ERROR;
     }
 
+    ogs_info("Initialized in %lld msec [RSS:%lld KB]",
+            (long long)ogs_time_to_msec(ogs_get_monotonic_time() - started),
+            (long long)(ogs_get_max_rss() / 1024));
+
     atexit(terminate);
     ogs_signal_thread(check_signal);
 
@@ -45,6 +45,9 @@ static OGS_POOL(mme_vlr_pool, mme_vlr_t);
 static OGS_POOL(mme_csmap_pool, mme_csmap_t);
 
 static OGS_POOL(mme_enb_pool, mme_enb_t);
+static OGS_POOL(mme_paging_area_pool, mme_paging_area_t);
+static OGS_POOL(mme_paging_enb_pool, mme_paging_enb_t);
+static OGS_POOL(mme_paging_deferred_pool, mme_paging_deferred_t);
 static OGS_POOL(mme_ue_pool, mme_ue_t);
 static OGS_POOL(mme_s11_teid_pool, ogs_pool_id_t);
 static OGS_POOL(enb_ue_pool, enb_ue_t);
@@ -106,6 +109,10 @@ void mme_context_init(void)
 
     /* Allocate TWICE the pool to check if maximum number of eNBs is reached */
     ogs_pool_init(&mme_enb_pool, ogs_app()->max.peer*2);
+    ogs_pool_init(&mme_paging_area_pool,
+            mme_enb_pool.size * OGS_MAX_NUM_OF_TAI * OGS_MAX_NUM_OF_BPLMN);
+    ogs_pool_init(&mme_paging_enb_pool, mme_paging_area_pool.size);
+    ogs_pool_init(&mme_paging_deferred_pool, ogs_app()->max.ue);
 
     ogs_pool_init(&mme_ue_pool, ogs_app()->max.ue);
     ogs_pool_init(&mme_s11_teid_pool, ogs_app()->max.ue);
@@ -128,6 +135,8 @@ void mme_context_init(void)
     ogs_assert(self.guti_ue_hash);
     self.mme_s11_teid_hash = ogs_hash_make();
     ogs_assert(self.mme_s11_teid_hash);
+    self.paging_area_hash = ogs_hash_make();
+    ogs_assert(self.paging_area_hash);
 
     ogs_list_init(&self.mme_ue_list);
 
@@ -158,6 +167,8 @@ void mme_context_final(void)
     ogs_hash_destroy(self.guti_ue_hash);
     ogs_assert(self.mme_s11_teid_hash);
     ogs_hash_destroy(self.mme_s11_teid_hash);
+    ogs_assert(self.paging_area_hash);
+    ogs_hash_destroy(self.paging_area_hash);
 
     ogs_pool_final(&m_tmsi_pool);
     ogs_pool_final(&mme_bearer_pool);
@@ -167,6 +178,9 @@ void mme_context_final(void)
     ogs_pool_final(&enb_ue_pool);
     ogs_pool_final(&sgw_ue_pool);
 
+    ogs_pool_final(&mme_paging_deferred_pool);
+    ogs_pool_final(&mme_paging_enb_pool);
+    ogs_pool_final(&mme_paging_area_pool);
     ogs_pool_final(&mme_enb_pool);
 
     ogs_pool_final(&mme_sgsn_pool);
@@ -217,6 +231,12 @@ static int mme_context_validation(void)
         return OGS_RETRY;
     }
 
+    if (self.paging_rate < 0) {
+        ogs_error("Invalid mme.paging.rate[%d] in '%s'",
+                self.paging_rate, ogs_app()->file);
+        return OGS_ERROR;
+    }
+
     if (ogs_list_first(&ogs_gtp_self()->gtpc_list) == NULL &&
         ogs_list_first(&ogs_gtp_self()->gtpc_list6) == NULL) {
         ogs_error("No mme.gtpc in '%s'", ogs_app()->file);
@@ -552,6 +572,19 @@ int mme_context_parse_config(void)
                 } else if (!strcmp(mme_key, "relative_capacity")) {
                     const char *v = ogs_yaml_iter_value(&mme_iter);
                     if (v) self.relative_capacity = atoi(v);
+                } else if (!strcmp(mme_key, "paging")) {
+                    ogs_yaml_iter_t paging_iter;
+                    ogs_yaml_iter_recurse(&mme_iter, &paging_iter);
+                    while (ogs_yaml_iter_next(&paging_iter)) {
+                        const char *paging_key =
+                            ogs_yaml_iter_key(&paging_iter);
+                        ogs_assert(paging_key);
+                        if (!strcmp(paging_key, "rate")) {
+                            const char *v = ogs_yaml_iter_value(&paging_iter);
+                            if (v) self.paging_rate = atoi(v);
+                        } else
+                            ogs_warn("unknown key `%s`", paging_key);
+                    }
                 } else if (!strcmp(mme_key, "s1ap")) {
                     ogs_yaml_iter_t s1ap_array, s1ap_iter;
                     ogs_yaml_iter_recurse(&mme_iter, &s1ap_array);
@@ -2519,6 +2552,7 @@ mme_enb_t *mme_enb_add(ogs_sock_t *sock, ogs_sockaddr_t *addr)
 {
     mme_enb_t *enb = NULL;
     mme_event_t e;
+    int rv;
 
     ogs_assert(sock);
     ogs_assert(addr);
@@ -2532,6 +2566,10 @@ mme_enb_t *mme_enb_add(ogs_sock_t *sock, ogs_sockaddr_t *addr)
     enb->sctp.type = mme_enb_sock_type(enb->sctp.sock);
 
     if (enb->sctp.type == SOCK_STREAM) {
+        /* Reads are drained and writes are batched until EAGAIN */
+        rv = ogs_nonblocking(sock->fd);
+        ogs_assert(rv == OGS_OK);
+
         enb->sctp.poll.read = ogs_pollset_add(ogs_app()->pollset,
             OGS_POLLIN, sock->fd, s1ap_recv_upcall, sock);
         ogs_assert(enb->sctp.poll.read);
@@ -2544,6 +2582,11 @@ mme_enb_t *mme_enb_add(ogs_sock_t *sock, ogs_sockaddr_t *addr)
 
     ogs_list_init(&enb->enb_ue_list);
 
+    ogs_list_init(&enb->paging.deferred_list);
+    enb->paging.t_deferred = ogs_timer_add(ogs_app()->timer_mgr,
+            mme_timer_s1_paging_expire, enb);
+    ogs_assert(enb->paging.t_deferred);
+
     ogs_hash_set(self.enb_addr_hash,
             enb->sctp.addr, sizeof(ogs_sockaddr_t), enb);
 
@@ -2563,6 +2606,7 @@ mme_enb_t *mme_enb_add(ogs_sock_t *sock, ogs_sockaddr_t *addr)
 int mme_enb_remove(mme_enb_t *enb)
 {
     mme_event_t e;
+    mme_paging_deferred_t *deferred = NULL, *next_deferred = NULL;
 
     ogs_assert(enb);
     ogs_assert(enb->sctp.sock);
@@ -2577,6 +2621,12 @@ int mme_enb_remove(mme_enb_t *enb)
             enb->sctp.addr, sizeof(ogs_sockaddr_t), NULL);
     ogs_hash_set(self.enb_id_hash, &enb->enb_id, sizeof(enb->enb_id), NULL);
 
+    mme_enb_clear_paging_area(enb);
+
+    ogs_list_for_each_safe(&enb->paging.deferred_list, next_deferred, deferred)
+        mme_enb_paging_deferred_remove(enb, deferred);
+    ogs_timer_delete(enb->paging.t_deferred);
+
     /*
      * CHECK:
      *
@@ -2630,6 +2680,195 @@ int mme_enb_set_enb_id(mme_enb_t *enb, uint32_t enb_id)
     return OGS_OK;
 }
 
+static void paging_area_add_enb(mme_enb_t *enb, ogs_eps_tai_t *tai)
+{
+    mme_paging_area_t *area = NULL;
+    mme_paging_enb_t *paging_enb = NULL;
+
+    ogs_assert(enb);
+    ogs_assert(tai);
+
+    area = ogs_hash_get(self.paging_area_hash, tai, sizeof(*tai));
+    if (!area) {
+        ogs_pool_alloc(&mme_paging_area_pool, &area);
+        if (!area) {
+            ogs_error("mme_paging_area_pool() failed");
+            return;
+        }
+        memset(area, 0, sizeof *area);
+
+        memcpy(&area->tai, tai, sizeof(area->tai));
+        ogs_list_init(&area->enb_list);
+
+        ogs_hash_set(self.paging_area_hash,
+                &area->tai, sizeof(area->tai), area);
+    } else {
+        /* The same TAI may be listed twice by an eNB */
+        ogs_list_for_each(&area->enb_list, paging_enb)
+            if (paging_enb->enb == enb) return;
+    }
+
+    ogs_assert(enb->paging.num_of_entry <
+            OGS_MAX_NUM_OF_TAI*OGS_MAX_NUM_OF_BPLMN);
+
+    ogs_pool_alloc(&mme_paging_enb_pool, &paging_enb);
+    if (!paging_enb) {
+        ogs_error("mme_paging_enb_pool() failed");
+        if (ogs_list_first(&area->enb_list) == NULL) {
+            ogs_hash_set(self.paging_area_hash,
+                    &area->tai, sizeof(area->tai), NULL);
+            ogs_pool_free(&mme_paging_area_pool, area);
+        }
+        return;
+    }
+    memset(paging_enb, 0, sizeof *paging_enb);
+
+    paging_enb->area = area;
+    paging_enb->enb = enb;
+    ogs_list_add(&area->enb_list, paging_enb);
+
+    enb->paging.entry[enb->paging.num_of_entry++] = paging_enb;
+}
+
+/*
+ * Rebuild the TAI index of the eNB from its supported_ta_list.
+ * Called when S1 Setup or eNB Configuration Update is accepted.
+ */
+void mme_enb_update_paging_area(mme_enb_t *enb)
+{
+    int i;
+
+    ogs_assert(enb);
+
+    mme_enb_clear_paging_area(enb);
+
+    for (i = 0; i < enb->num_of_supported_ta_list; i++)
+        paging_area_add_enb(enb, &enb->supported_ta_list[i]);
+}
+
+void mme_enb_clear_paging_area(mme_enb_t *enb)
+{
+    int i;
+
+    ogs_assert(enb);
+
+    for (i = 0; i < enb->paging.num_of_entry; i++) {
+        mme_paging_enb_t *paging_enb = enb->paging.entry[i];
+        mme_paging_area_t *area = NULL;
+
+        ogs_assert(paging_enb);
+        area = paging_enb->area;
+        ogs_assert(area);
+
+        ogs_list_remove(&area->enb_list, paging_enb);
+        ogs_pool_free(&mme_paging_enb_pool, paging_enb);
+
+        if (ogs_list_first(&area->enb_list) == NULL) {
+            ogs_hash_set(self.paging_area_hash,
+                    &area->tai, sizeof(area->tai), NULL);
+            ogs_pool_free(&mme_paging_area_pool, area);
+        }
+
+        enb->paging.entry[i] = NULL;
+    }
+
+    enb->paging.num_of_entry = 0;
+}
+
+mme_paging_area_t *mme_paging_area_find(ogs_eps_tai_t *tai)
+{
+    ogs_assert(tai);
+
+    return (mme_paging_area_t *)ogs_hash_get(
+            self.paging_area_hash, tai, sizeof(*tai));
+}
+
+/*
+ * Returns true if the eNB has already received `mme.paging.rate` Paging
+ * messages in the current one-second window. The Paging is then kept
+ * with mme_enb_paging_defer() and sent when the next window opens.
+ */
+bool mme_enb_paging_is_paced(mme_enb_t *enb)
+{
+    ogs_time_t now;
+
+    ogs_assert(enb);
+
+    if (!self.paging_rate)
+        return false;
+
+    now = ogs_get_monotonic_time();
+    if (now - enb->paging.window >= ogs_time_from_sec(1)) {
+        enb->paging.window = now;
+        enb->paging.count = 0;
+    }
+
+    if (enb->paging.count >= self.paging_rate)
+        return true;
+
+    enb->paging.count++;
+
+    return false;
+}
+
+/*
+ * Keeps the Paging of the UE for the next pacing window of the eNB.
+ * Returns false if it cannot be kept. The UE is then paged again
+ * when T3413 expires.
+ */
+bool mme_enb_paging_defer(mme_enb_t *enb, mme_ue_t *mme_ue)
+{
+    mme_paging_deferred_t *deferred = NULL;
+
+    ogs_assert(enb);
+    ogs_assert(mme_ue);
+
+    ogs_list_for_each(&enb->paging.deferred_list, deferred) {
+        if (deferred->mme_ue == mme_ue)
+            return true;
+    }
+
+    ogs_pool_alloc(&mme_paging_deferred_pool, &deferred);
+    if (!deferred) {
+        ogs_error("Paging deferral pool is full [ENB_ID:0x%x]", enb->enb_id);
+        return false;
+    }
+    memset(deferred, 0, sizeof *deferred);
+
+    deferred->mme_ue = mme_ue;
+    ogs_list_add(&enb->paging.deferred_list, deferred);
+
+    if (enb->paging.t_deferred->running == false)
+        mme_enb_paging_schedule(enb);
+
+    return true;
+}
+
+void mme_enb_paging_deferred_remove(
+        mme_enb_t *enb, mme_paging_deferred_t *deferred)
+{
+    ogs_assert(enb);
+    ogs_assert(deferred);
+
+    ogs_list_remove(&enb->paging.deferred_list, deferred);
+    ogs_pool_free(&mme_paging_deferred_pool, deferred);
+}
+
+/* Wakes up when the next pacing window of the eNB opens */
+void mme_enb_paging_schedule(mme_enb_t *enb)
+{
+    ogs_time_t duration;
+
+    ogs_assert(enb);
+
+    duration = enb->paging.window + ogs_time_from_sec(1) -
+        ogs_get_monotonic_time();
+    if (duration < ogs_time_from_msec(1))
+        duration = ogs_time_from_msec(1);
+
+    ogs_timer_start(enb->paging.t_deferred, duration);
+}
+
 int mme_enb_sock_type(ogs_sock_t *sock)
 {
     ogs_socknode_t *snode = NULL;
@@ -192,6 +192,10 @@ typedef struct mme_context_s {
     ogs_hash_t *enb_id_hash;    /* hash table for ENB-ID */
     ogs_hash_t *imsi_ue_hash;   /* hash table (IMSI : MME_UE) */
     ogs_hash_t *guti_ue_hash;   /* hash table (GUTI : MME_UE) */
+    ogs_hash_t *paging_area_hash;   /* hash table (TAI : Paging Area) */
+
+    /* Max number of Paging per second for each eNB, 0 = no limit */
+    int paging_rate;
 
     ogs_hash_t *mme_s11_teid_hash;  /* hash table (MME-S11-TEID : MME_UE) */
 
@@ -290,12 +294,44 @@ typedef struct mme_enb_s {
     int             num_of_supported_ta_list;
     ogs_eps_tai_t   supported_ta_list[OGS_MAX_NUM_OF_TAI*OGS_MAX_NUM_OF_BPLMN];
 
+    struct {
+        /* Entries of the TAI index built from supported_ta_list */
+        int num_of_entry;
+        struct mme_paging_enb_s *entry[OGS_MAX_NUM_OF_TAI*OGS_MAX_NUM_OF_BPLMN];
+
+        ogs_time_t window;      /* Start of the current pacing window */
+        int count;              /* Paging sent within the window */
+
+        ogs_list_t deferred_list;   /* Paging over the rate */
+        ogs_timer_t *t_deferred;    /* Opens the next pacing window */
+    } paging;
+
     ogs_pkbuf_t     *s1_reset_ack; /* Reset message */
 
     ogs_list_t      enb_ue_list;
 
 } mme_enb_t;
 
+/* eNBs serving a TAI, so that Paging does not scan every eNB */
+typedef struct mme_paging_area_s {
+    ogs_eps_tai_t   tai;            /* Key of paging_area_hash */
+    ogs_list_t      enb_list;       /* List of mme_paging_enb_t */
+} mme_paging_area_t;
+
+typedef struct mme_paging_enb_s {
+    ogs_lnode_t     lnode;          /* A node of mme_paging_area_t */
+
+    mme_paging_area_t *area;
+    mme_enb_t       *enb;
+} mme_paging_enb_t;
+
+/* Paging held back by mme.paging.rate until the next pacing window */
+typedef struct mme_paging_deferred_s {
+    ogs_lnode_t     lnode;          /* A node of deferred_list of mme_enb_t */
+
+    mme_ue_t        *mme_ue;
+} mme_paging_deferred_t;
+
 struct enb_ue_s {
     ogs_lnode_t     lnode;
     uint32_t        index;
@@ -870,6 +906,15 @@ int mme_enb_set_enb_id(mme_enb_t *enb, uint32_t enb_id);
 int mme_enb_sock_type(ogs_sock_t *sock);
 mme_enb_t *mme_enb_cycle(mme_enb_t *enb);
 
+void mme_enb_update_paging_area(mme_enb_t *enb);
+void mme_enb_clear_paging_area(mme_enb_t *enb);
+mme_paging_area_t *mme_paging_area_find(ogs_eps_tai_t *tai);
+bool mme_enb_paging_is_paced(mme_enb_t *enb);
+bool mme_enb_paging_defer(mme_enb_t *enb, mme_ue_t *mme_ue);
+void mme_enb_paging_deferred_remove(
+        mme_enb_t *enb, mme_paging_deferred_t *deferred);
+void mme_enb_paging_schedule(mme_enb_t *enb);
+
 enb_ue_t *enb_ue_add(mme_enb_t *enb, uint32_t enb_ue_s1ap_id);
 void enb_ue_remove(enb_ue_t *enb_ue);
 void enb_ue_switch_to_enb(enb_ue_t *enb_ue, mme_enb_t *new_enb);
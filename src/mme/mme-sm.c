@@ -210,6 +210,19 @@ void mme_state_operational(ogs_fsm_t *s, mme_event_t *e)
         break;
 
     case MME_EVENT_S1AP_TIMER:
+        if (e->timer_id == MME_TIMER_S1_PAGING) {
+            enb = mme_enb_cycle(e->enb);
+            if (!enb) {
+                ogs_error("eNB has already been removed");
+                break;
+            }
+
+            r = s1ap_send_deferred_paging(enb);
+            ogs_expect(r == OGS_OK);
+            ogs_assert(r != OGS_ERROR);
+            break;
+        }
+
         enb_ue = e->enb_ue;
         ogs_assert(enb_ue);
 
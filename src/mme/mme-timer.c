@@ -100,6 +100,8 @@ const char *mme_timer_get_name(mme_timer_e id)
         return "MME_TIMER_SGS_CLI_CONN_TO_SRV";
     case MME_TIMER_S1_HOLDING:
         return "MME_TIMER_S1_HOLDING";
+    case MME_TIMER_S1_PAGING:
+        return "MME_TIMER_S1_PAGING";
     case MME_TIMER_S11_HOLDING:
         return "MME_TIMER_S11_HOLDING";
     default:
@@ -238,6 +240,27 @@ void mme_timer_s1_holding_timer_expire(void *data)
     }
 }
 
+void mme_timer_s1_paging_expire(void *data)
+{
+    int rv;
+    mme_event_t *e = NULL;
+    mme_enb_t *enb = NULL;
+
+    ogs_assert(data);
+    enb = data;
+
+    e = mme_event_new(MME_EVENT_S1AP_TIMER);
+
+    e->timer_id = MME_TIMER_S1_PAGING;
+    e->enb = enb;
+
+    rv = ogs_queue_push(ogs_app()->queue, e);
+    if (rv != OGS_OK) {
+        ogs_error("ogs_queue_push() failed:%d", (int)rv);
+        mme_event_free(e);
+    }
+}
+
 void mme_timer_s11_holding_timer_expire(void *data)
 {
     int rv;
@@ -32,6 +32,7 @@ typedef enum {
 
     MME_TIMER_S1_DELAYED_SEND,
     MME_TIMER_S1_HOLDING,
+    MME_TIMER_S1_PAGING,
 
     MME_TIMER_T3413,
     MME_TIMER_T3422,
@@ -75,6 +76,7 @@ void mme_timer_implicit_detach_expire(void *data);
 
 void mme_timer_sgs_cli_conn_to_srv(void *data);
 void mme_timer_s1_holding_timer_expire(void *data);
+void mme_timer_s1_paging_expire(void *data);
 void mme_timer_s11_holding_timer_expire(void *data);
 
 #ifdef __cplusplus
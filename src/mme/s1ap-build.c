@@ -282,12 +282,23 @@ ogs_pkbuf_t *s1ap_build_downlink_nas_transport(
     S1AP_ENB_UE_S1AP_ID_t *ENB_UE_S1AP_ID = NULL;
     S1AP_NAS_PDU_t *NAS_PDU = NULL;
 
+    ogs_pkbuf_t *s1apbuf = NULL;
+
     ogs_assert(emmbuf);
     enb_ue = enb_ue_cycle(enb_ue);
     ogs_assert(enb_ue);
 
     ogs_debug("DownlinkNASTransport");
 
+    s1apbuf = ogs_s1ap_build_downlink_nas_transport(
+            enb_ue->mme_ue_s1ap_id, enb_ue->enb_ue_s1ap_id, emmbuf);
+    if (s1apbuf) {
+        ogs_debug("    ENB_UE_S1AP_ID[%d] MME_UE_S1AP_ID[%d]",
+                enb_ue->enb_ue_s1ap_id, enb_ue->mme_ue_s1ap_id);
+        ogs_pkbuf_free(emmbuf);
+        return s1apbuf;
+    }
+
     memset(&pdu, 0, sizeof (S1AP_S1AP_PDU_t));
     pdu.present = S1AP_S1AP_PDU_PR_initiatingMessage;
     pdu.choice.initiatingMessage = CALLOC(1, sizeof(S1AP_InitiatingMessage_t));
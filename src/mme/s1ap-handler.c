@@ -241,6 +241,8 @@ void s1ap_handle_s1_setup_request(mme_enb_t *enb, ogs_s1ap_message_t *message)
     }
 
     enb->state.s1_setup_success = true;
+    mme_enb_update_paging_area(enb);
+
     r = s1ap_send_s1_setup_response(enb);
     ogs_expect(r == OGS_OK);
     ogs_assert(r != OGS_ERROR);
@@ -359,6 +361,8 @@ void s1ap_handle_enb_configuration_update(
             ogs_assert(r != OGS_ERROR);
             return;
         }
+
+        mme_enb_update_paging_area(enb);
     }
 
     if (PagingDRX)
@@ -458,8 +458,9 @@ int s1ap_send_ue_context_release_command(
 int s1ap_send_paging(mme_ue_t *mme_ue, S1AP_CNDomain_t cn_domain)
 {
     ogs_pkbuf_t *s1apbuf = NULL;
-    mme_enb_t *enb = NULL;
-    int i;
+    mme_paging_area_t *area = NULL;
+    mme_paging_enb_t *paging_enb = NULL;
+    int sent = 0, deferred = 0;
     int rv;
 
     ogs_debug("S1-Paging");
@@ -470,38 +471,53 @@ int s1ap_send_paging(mme_ue_t *mme_ue, S1AP_CNDomain_t cn_domain)
     }
 
     /* Find enB with matched TAI */
-    ogs_list_for_each(&mme_self()->enb_list, enb) {
-        for (i = 0; i < enb->num_of_supported_ta_list; i++) {
-
-            if (memcmp(&enb->supported_ta_list[i], &mme_ue->tai,
-                        sizeof(ogs_eps_tai_t)) == 0) {
-
-                if (mme_ue->t3413.pkbuf) {
-                    s1apbuf = mme_ue->t3413.pkbuf;
-                } else {
-                    s1apbuf = s1ap_build_paging(mme_ue, cn_domain);
-                    if (!s1apbuf) {
-                        ogs_error("s1ap_build_paging() failed");
-                        return OGS_ERROR;
-                    }
-                }
-
-                mme_ue->t3413.pkbuf = ogs_pkbuf_copy(s1apbuf);
-                if (!mme_ue->t3413.pkbuf) {
-                    ogs_error("ogs_pkbuf_copy() failed");
-                    ogs_pkbuf_free(s1apbuf);
-                    return OGS_ERROR;
-                }
-
-                rv = s1ap_send_to_enb(enb, s1apbuf, S1AP_NON_UE_SIGNALLING);
-                if (rv != OGS_OK) {
-                    ogs_error("s1ap_send_to_enb() failed");
-                    return rv;
-                }
+    area = mme_paging_area_find(&mme_ue->tai);
+    if (area && ogs_list_first(&area->enb_list)) {
+        /*
+         * The Paging PDU is built once and kept for T3413.
+         * Each eNB gets a reference to the same cluster.
+         */
+        if (!mme_ue->t3413.pkbuf) {
+            mme_ue->t3413.pkbuf = s1ap_build_paging(mme_ue, cn_domain);
+            if (!mme_ue->t3413.pkbuf) {
+                ogs_error("s1ap_build_paging() failed");
+                return OGS_ERROR;
             }
         }
+
+        ogs_list_for_each(&area->enb_list, paging_enb) {
+            mme_enb_t *enb = paging_enb->enb;
+            ogs_assert(enb);
+
+            if (mme_enb_paging_is_paced(enb) == true) {
+                ogs_debug("Paging deferred [ENB_ID:0x%x]", enb->enb_id);
+                if (mme_enb_paging_defer(enb, mme_ue) == true)
+                    deferred++;
+                continue;
+            }
+
+            s1apbuf = ogs_pkbuf_copy(mme_ue->t3413.pkbuf);
+            if (!s1apbuf) {
+                ogs_error("ogs_pkbuf_copy() failed");
+                return OGS_ERROR;
+            }
+
+            rv = s1ap_send_to_enb(enb, s1apbuf, S1AP_NON_UE_SIGNALLING);
+            if (rv != OGS_OK) {
+                ogs_error("s1ap_send_to_enb() failed");
+                return rv;
+            }
+            sent++;
+        }
     }
 
+    /*
+     * If every eNB deferred the Paging, T3413 is started
+     * when the first deferred Paging is sent.
+     */
+    if (!sent && deferred)
+        return OGS_OK;
+
     /* Start T3413 */
     ogs_timer_start(mme_ue->t3413.timer,
             mme_timer_cfg(MME_TIMER_T3413)->duration);
@@ -509,6 +525,53 @@ int s1ap_send_paging(mme_ue_t *mme_ue, S1AP_CNDomain_t cn_domain)
     return OGS_OK;
 }
 
+/* Sends the Paging deferred by mme.paging.rate in the new pacing window */
+int s1ap_send_deferred_paging(mme_enb_t *enb)
+{
+    ogs_pkbuf_t *s1apbuf = NULL;
+    mme_paging_deferred_t *deferred = NULL, *next_deferred = NULL;
+    mme_ue_t *mme_ue = NULL;
+    int rv;
+
+    ogs_assert(enb);
+
+    ogs_list_for_each_safe(&enb->paging.deferred_list,
+            next_deferred, deferred) {
+        mme_ue = mme_ue_cycle(deferred->mme_ue);
+
+        /* The UE has been removed, or the Paging is over */
+        if (!mme_ue || !mme_ue->t3413.pkbuf) {
+            mme_enb_paging_deferred_remove(enb, deferred);
+            continue;
+        }
+
+        if (mme_enb_paging_is_paced(enb) == true) {
+            mme_enb_paging_schedule(enb);
+            break;
+        }
+
+        mme_enb_paging_deferred_remove(enb, deferred);
+
+        s1apbuf = ogs_pkbuf_copy(mme_ue->t3413.pkbuf);
+        if (!s1apbuf) {
+            ogs_error("ogs_pkbuf_copy() failed");
+            return OGS_ERROR;
+        }
+
+        rv = s1ap_send_to_enb(enb, s1apbuf, S1AP_NON_UE_SIGNALLING);
+        if (rv != OGS_OK) {
+            ogs_error("s1ap_send_to_enb() failed");
+            return rv;
+        }
+
+        /* The deferral does not use up a T3413 retry */
+        ogs_timer_start(mme_ue->t3413.timer,
+                mme_timer_cfg(MME_TIMER_T3413)->duration);
+    }
+
+    return OGS_OK;
+}
+
 int s1ap_send_mme_configuration_transfer(
         mme_enb_t *target_enb,
         S1AP_SONConfigurationTransfer_t *SONConfigurationTransfer)
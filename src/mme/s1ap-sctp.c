@@ -29,7 +29,7 @@ static void lksctp_accept_handler(short when, ogs_socket_t fd, void *data);
 #endif
 
 void s1ap_accept_handler(ogs_sock_t *sock);
-void s1ap_recv_handler(ogs_sock_t *sock);
+int s1ap_recv_handler(ogs_sock_t *sock);
 
 ogs_sock_t *s1ap_server(ogs_socknode_t *node)
 {
@@ -68,12 +68,19 @@ ogs_sock_t *s1ap_server(ogs_socknode_t *node)
 void s1ap_recv_upcall(short when, ogs_socket_t fd, void *data)
 {
     ogs_sock_t *sock = NULL;
+    int i;
 
     ogs_assert(fd != INVALID_SOCKET);
     sock = data;
     ogs_assert(sock);
 
-    s1ap_recv_handler(sock);
+    /*
+     * The eNB socket is non-blocking. Drain what has arrived, up to
+     * OGS_POLL_BUDGET messages, and leave the rest to the next poll.
+     */
+    for (i = 0; i < OGS_POLL_BUDGET; i++)
+        if (s1ap_recv_handler(sock) != OGS_OK)
+            break;
 }
 
 #if HAVE_USRSCTP
@@ -120,7 +127,7 @@ void s1ap_accept_handler(ogs_sock_t *sock)
     }
 }
 
-void s1ap_recv_handler(ogs_sock_t *sock)
+int s1ap_recv_handler(ogs_sock_t *sock)
 {
     ogs_pkbuf_t *pkbuf;
     int size;
@@ -136,11 +143,15 @@ void s1ap_recv_handler(ogs_sock_t *sock)
     ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN);
     size = ogs_sctp_recvmsg(
             sock, pkbuf->data, pkbuf->len, &from, &sinfo, &flags);
+    if (size < 0 && ogs_socket_errno == OGS_EAGAIN) {
+        ogs_pkbuf_free(pkbuf);
+        return OGS_DONE;
+    }
     if (size < 0 || size >= OGS_MAX_SDU_LEN) {
         ogs_error("ogs_sctp_recvmsg(%d) failed(%d:%s)",
                 size, errno, strerror(errno));
         ogs_pkbuf_free(pkbuf);
-        return;
+        return OGS_ERROR;
     }
 
     if (flags & MSG_NOTIFICATION) {
@@ -238,7 +249,7 @@ void s1ap_recv_handler(ogs_sock_t *sock)
         memcpy(addr, &from, sizeof(ogs_sockaddr_t));
 
         s1ap_event_push(MME_EVENT_S1AP_MESSAGE, sock, addr, pkbuf, 0, 0);
-        return;
+        return OGS_OK;
     } else {
         if (ogs_socket_errno != OGS_EAGAIN) {
             ogs_fatal("ogs_sctp_recvmsg(%d) failed(%d:%s-0x%x)",
@@ -250,5 +261,10 @@ void s1ap_recv_handler(ogs_sock_t *sock)
         }
     }
 
+    /*
+     * Stop draining after a notification. The association may be going
+     * down, and the state machine has to see that event first.
+     */
     ogs_pkbuf_free(pkbuf);
+    return OGS_DONE;
 }
@@ -190,6 +190,7 @@ void pcf_metrics_init(void)
 {
     ogs_metrics_context_t *ctx = ogs_metrics_self();
     ogs_metrics_context_init();
+    ogs_sbi_metrics_init();
 
     pcf_metrics_init_spec(ctx, pcf_metrics_spec_global,
             pcf_metrics_spec_def_global, _PCF_METR_GLOB_MAX);
@@ -220,5 +221,6 @@ void pcf_metrics_final(void)
         ogs_hash_destroy(metrics_hash_by_slice);
     }
 
+    ogs_sbi_metrics_final();
     ogs_metrics_context_final();
 }
@@ -28,6 +28,12 @@ int pcrf_fd_init(void)
                 pcrf_self()->diam_conf_path, pcrf_self()->diam_config);
     ogs_assert(rv == 0);
 
+    if (ogs_app()->num_of_diameter_thread) {
+        rv = ogs_diam_async_init(ogs_app()->num_of_diameter_thread,
+                ogs_app()->pool.event);
+        ogs_assert(rv == OGS_OK);
+    }
+
     rv = pcrf_gx_init();
     ogs_assert(rv == OGS_OK);
     rv = pcrf_rx_init();
@@ -44,5 +50,8 @@ void pcrf_fd_final(void)
     pcrf_gx_final();
     pcrf_rx_final();
 
+    /* The handlers are unregistered, so nothing is queued any more */
+    ogs_diam_async_final();
+
     ogs_diam_final();
 }
@@ -1186,8 +1186,8 @@ int pcrf_gx_init(void)
     ogs_assert(ret == 0);
 
     data.command = ogs_diam_gx_cmd_ccr;
-    ret = fd_disp_register(pcrf_gx_ccr_cb, DISP_HOW_CC, &data, NULL,
-                &hdl_gx_ccr);
+    ret = ogs_diam_async_register(pcrf_gx_ccr_cb,
+                DISP_HOW_CC, &data, NULL, &hdl_gx_ccr);
     ogs_assert(ret == 0);
 
     /* Advertise the support for the application in the peer */
@@ -1207,7 +1207,7 @@ void pcrf_gx_final(void)
     if (hdl_gx_fb)
         (void) fd_disp_unregister(&hdl_gx_fb, NULL);
     if (hdl_gx_ccr)
-        (void) fd_disp_unregister(&hdl_gx_ccr, NULL);
+        (void) ogs_diam_async_unregister(&hdl_gx_ccr);
 
     ogs_pool_final(&sess_state_pool);
     ogs_pool_final(&rx_sess_state_pool);
@@ -777,14 +777,14 @@ int pcrf_rx_init(void)
 
     /* Specific handler for AA-Request */
     data.command = ogs_diam_rx_cmd_aar;
-    ret = fd_disp_register(pcrf_rx_aar_cb, DISP_HOW_CC, &data, NULL,
-                &hdl_rx_aar);
+    ret = ogs_diam_async_register(pcrf_rx_aar_cb,
+                DISP_HOW_CC, &data, NULL, &hdl_rx_aar);
     ogs_assert(ret == 0);
 
     /* Specific handler for STR-Request */
     data.command = ogs_diam_rx_cmd_str;
-    ret = fd_disp_register(pcrf_rx_str_cb, DISP_HOW_CC, &data, NULL,
-                &hdl_rx_str);
+    ret = ogs_diam_async_register(pcrf_rx_str_cb,
+                DISP_HOW_CC, &data, NULL, &hdl_rx_str);
     ogs_assert(ret == 0);
 
     /* Advertise the support for the application in the peer */
@@ -804,9 +804,9 @@ void pcrf_rx_final(void)
     if (hdl_rx_fb)
         (void) fd_disp_unregister(&hdl_rx_fb, NULL);
     if (hdl_rx_aar)
-        (void) fd_disp_unregister(&hdl_rx_aar, NULL);
+        (void) ogs_diam_async_unregister(&hdl_rx_aar);
     if (hdl_rx_str)
-        (void) fd_disp_unregister(&hdl_rx_str, NULL);
+        (void) ogs_diam_async_unregister(&hdl_rx_str);
 
     ogs_pool_final(&sess_state_pool);
     ogs_thread_mutex_destroy(&sess_state_mutex);
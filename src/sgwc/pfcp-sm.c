@@ -326,6 +326,12 @@ void sgwc_pfcp_state_associated(ogs_fsm_t *s, sgwc_event_t *e)
                 &message->pfcp_session_deletion_response);
             break;
 
+        case OGS_PFCP_NODE_REPORT_REQUEST_TYPE:
+            ogs_expect(true ==
+                ogs_pfcp_cp_handle_node_report_request(node, xact,
+                    &message->pfcp_node_report_request));
+            break;
+
         case OGS_PFCP_SESSION_REPORT_REQUEST_TYPE:
             if (!message->h.seid_presence) ogs_error("No SEID");
 
@@ -24,8 +24,9 @@
 
 static ogs_pkbuf_pool_t *packet_pool = NULL;
 
-static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
+static int _gtpv1_u_recv(ogs_socket_t fd, ogs_sock_t *sock)
 {
+    int rv = OGS_OK;
     int len;
     ssize_t size;
     char buf1[OGS_ADDRSTRLEN];
@@ -34,7 +35,6 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
     sgwu_sess_t *sess = NULL;
 
     ogs_pkbuf_t *pkbuf = NULL;
-    ogs_sock_t *sock = NULL;
     ogs_sockaddr_t from;
 
     ogs_gtp2_header_t *gtp_h = NULL;
@@ -42,17 +42,29 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
     ogs_pfcp_user_plane_report_t report;
 
     ogs_assert(fd != INVALID_SOCKET);
-    sock = data;
     ogs_assert(sock);
 
     pkbuf = ogs_pkbuf_alloc(packet_pool, OGS_MAX_PKT_LEN);
     ogs_assert(pkbuf);
-    ogs_pkbuf_put(pkbuf, OGS_MAX_PKT_LEN);
+    /* Room to push a larger outer header when forwarding in place */
+    ogs_pkbuf_reserve(pkbuf, OGS_GTPV1U_5GC_HEADER_LEN);
+    ogs_pkbuf_put(pkbuf, OGS_MAX_PKT_LEN-OGS_GTPV1U_5GC_HEADER_LEN);
 
     size = ogs_recvfrom(fd, pkbuf->data, pkbuf->len, 0, &from);
-    if (size <= 0) {
+    if (size < 0) {
+        if (ogs_socket_errno == OGS_EAGAIN) {
+            rv = OGS_RETRY;
+            goto cleanup;
+        }
+
         ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
                 "ogs_recv() failed");
+        rv = OGS_ERROR;
+        goto cleanup;
+    }
+    if (size == 0) {
+        /* An empty UDP datagram is valid, but carries no GTP-U */
+        ogs_debug("[DROP] Empty GTPU packet");
         goto cleanup;
     }
 
@@ -75,24 +87,11 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
         goto cleanup;
     }
     if (header_desc.type == OGS_GTPU_MSGTYPE_ECHO_REQ) {
-        ogs_pkbuf_t *echo_rsp;
-
-        ogs_debug("[RECV] Echo Request from [%s]", OGS_ADDR(&from, buf1));
-        echo_rsp = ogs_gtp2_handle_echo_req(pkbuf);
-        ogs_expect(echo_rsp);
-        if (echo_rsp) {
-            ssize_t sent;
-
-            /* Echo reply */
-            ogs_debug("[SEND] Echo Response to [%s]", OGS_ADDR(&from, buf1));
-
-            sent = ogs_sendto(fd, echo_rsp->data, echo_rsp->len, 0, &from);
-            if (sent < 0 || sent != echo_rsp->len) {
-                ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
-                        "ogs_sendto() failed");
-            }
-            ogs_pkbuf_free(echo_rsp);
-        }
+        ogs_gtpu_echo_send_rsp(fd, pkbuf, &from);
+        goto cleanup;
+    }
+    if (header_desc.type == OGS_GTPU_MSGTYPE_ECHO_RSP) {
+        ogs_gtpu_echo_handle_rsp(pkbuf, &from);
         goto cleanup;
     }
     if (header_desc.type != OGS_GTPU_MSGTYPE_END_MARKER &&
@@ -113,7 +112,6 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
         ogs_pfcp_object_t *pfcp_object = NULL;
         ogs_pfcp_pdr_t *pdr = NULL;
         ogs_gtp2_header_desc_t sendhdr;
-        ogs_pkbuf_t *sendbuf = NULL;
 
         pfcp_object = ogs_pfcp_object_find_by_teid(header_desc.teid);
         if (!pfcp_object) {
@@ -128,7 +126,7 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
              * for a configurable period after an UPF restart
              * when the UPF receives a G-PDU not matching any PDRs.
              */
-            if (ogs_time_ntp32_now() >
+            if (ogs_time_ntp32_coarse_now() >
                    (ogs_pfcp_self()->local_recovery +
                     ogs_time_sec(
                         ogs_app()->time.message.pfcp.association_interval))) {
@@ -154,14 +152,12 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
 
         ogs_assert(pdr);
 
-        sendbuf = ogs_pkbuf_copy(pkbuf);
-        ogs_assert(sendbuf);
-
         /* Forward packet */
         memset(&sendhdr, 0, sizeof(sendhdr));
         sendhdr.type = header_desc.type;
 
-        ogs_pfcp_send_g_pdu(pdr, &sendhdr, sendbuf);
+        ogs_pfcp_send_g_pdu(pdr, &sendhdr, pkbuf);
+        pkbuf = NULL;
 
     } else if (header_desc.type == OGS_GTPU_MSGTYPE_ERR_IND) {
         ogs_pfcp_far_t *far = NULL;
@@ -205,7 +201,7 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
              * for a configurable period after an UPF restart
              * when the UPF receives a G-PDU not matching any PDRs.
              */
-            if (ogs_time_ntp32_now() >
+            if (ogs_time_ntp32_coarse_now() >
                    (ogs_pfcp_self()->local_recovery +
                     ogs_time_sec(
                         ogs_app()->time.message.pfcp.association_interval))) {
@@ -262,6 +258,7 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
         ogs_assert(pdr);
         ogs_assert(true == ogs_pfcp_up_handle_pdr(
                     pdr, header_desc.type, &header_desc, pkbuf, &report));
+        pkbuf = NULL;
 
         if (report.type.downlink_data_report) {
             ogs_assert(pdr->sess);
@@ -282,7 +279,27 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
     }
 
 cleanup:
-    ogs_pkbuf_free(pkbuf);
+    if (pkbuf)
+        ogs_pkbuf_free(pkbuf);
+    return rv;
+}
+
+/*
+ * The data plane is registered with OGS_POLLET.
+ * Read until EAGAIN, or re-arm the fd if OGS_POLL_BUDGET runs out.
+ * Any other error only drops that packet, since the datagrams queued
+ * behind it would not be signalled again.
+ */
+static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
+{
+    int i;
+
+    for (i = 0; i < OGS_POLL_BUDGET; i++)
+        if (_gtpv1_u_recv(fd, data) == OGS_RETRY)
+            break;
+
+    if (i == OGS_POLL_BUDGET)
+        ogs_pollset_rearm(ogs_app()->pollset, fd);
 }
 
 int sgwu_gtp_init(void)
@@ -324,16 +341,20 @@ int sgwu_gtp_open(void)
             ogs_gtp_self()->gtpu_sock6 = sock;
 
         node->poll = ogs_pollset_add(ogs_app()->pollset,
-                OGS_POLLIN, sock->fd, _gtpv1_u_recv_cb, sock);
+                OGS_POLLIN|OGS_POLLET, sock->fd, _gtpv1_u_recv_cb, sock);
         ogs_assert(node->poll);
     }
 
     OGS_SETUP_GTPU_SERVER;
 
+    ogs_gtpu_echo_init(sgwu_pfcp_send_node_report_request);
+
     return OGS_OK;
 }
 
 void sgwu_gtp_close(void)
 {
+    ogs_gtpu_echo_final();
+
     ogs_socknode_remove_all(&ogs_gtp_self()->gtpu_list);
 }
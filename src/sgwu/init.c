@@ -30,6 +30,9 @@ int sgwu_initialize(void)
 {
     int rv;
 
+    ogs_metrics_context_init();
+    ogs_pfcp_metrics_init();
+
     ogs_gtp_context_init(OGS_MAX_NUM_OF_GTPU_RESOURCE);
     ogs_pfcp_context_init();
 
@@ -46,6 +49,9 @@ int sgwu_initialize(void)
     rv = ogs_pfcp_context_parse_config("sgwu", "sgwc");
     if (rv != OGS_OK) return rv;
 
+    rv = ogs_metrics_context_parse_config("sgwu");
+    if (rv != OGS_OK) return rv;
+
     rv = sgwu_context_parse_config();
     if (rv != OGS_OK) return rv;
 
@@ -59,6 +65,8 @@ int sgwu_initialize(void)
     rv = sgwu_gtp_open();
     if (rv != OGS_OK) return rv;
 
+    ogs_metrics_context_open(ogs_metrics_self());
+
     thread = ogs_thread_create(sgwu_main, NULL);
     if (!thread) return OGS_ERROR;
 
@@ -78,6 +86,8 @@ void sgwu_terminate(void)
     sgwu_pfcp_close();
     sgwu_gtp_close();
 
+    ogs_metrics_context_close(ogs_metrics_self());
+
     sgwu_context_final();
 
     ogs_pfcp_context_final();
@@ -87,6 +97,9 @@ void sgwu_terminate(void)
 
     sgwu_gtp_final();
     sgwu_event_final();
+
+    ogs_pfcp_metrics_final();
+    ogs_metrics_context_final();
 }
 
 static void sgwu_main(void *data)
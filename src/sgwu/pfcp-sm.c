@@ -291,6 +291,11 @@ void sgwu_pfcp_state_associated(ogs_fsm_t *s, sgwu_event_t *e)
             sgwu_sxa_handle_session_deletion_request(
                 sess, xact, &message->pfcp_session_deletion_request);
             break;
+        case OGS_PFCP_NODE_REPORT_RESPONSE_TYPE:
+            ogs_expect(true ==
+                ogs_pfcp_up_handle_node_report_response(node, xact,
+                    &message->pfcp_node_report_response));
+            break;
         case OGS_PFCP_SESSION_REPORT_RESPONSE_TYPE:
             sgwu_sxa_handle_session_report_response(
                 sess, xact, &message->pfcp_session_report_response);
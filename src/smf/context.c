@@ -17,6 +17,8 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <ctype.h>
+
 #include "context.h"
 #include "gtp-path.h"
 #include "pfcp-path.h"
@@ -42,6 +44,8 @@ static int num_of_smf_sess = 0;
 static void stats_add_smf_session(void);
 static void stats_remove_smf_session(smf_sess_t *sess);
 
+static void upf_index_remove_all(void);
+
 int smf_ctf_config_init(smf_ctf_config_t *ctf_config)
 {
     ctf_config->enabled = SMF_CTF_ENABLED_AUTO;
@@ -103,6 +107,13 @@ void smf_context_init(void)
     ogs_assert(self.ipv6_hash);
     self.n1n2message_hash = ogs_hash_make();
     ogs_assert(self.n1n2message_hash);
+    self.upf_dnn_hash = ogs_hash_make();
+    ogs_assert(self.upf_dnn_hash);
+    self.upf_area_hash = ogs_hash_make();
+    ogs_assert(self.upf_area_hash);
+
+    /* Accept PFCP Load Control Information from the UPFs */
+    ogs_pfcp_self()->cp_function_features.load = 1;
 
     context_initialized = 1;
 }
@@ -127,6 +138,12 @@ void smf_context_final(void)
     ogs_assert(self.n1n2message_hash);
     ogs_hash_destroy(self.n1n2message_hash);
 
+    upf_index_remove_all();
+    ogs_assert(self.upf_dnn_hash);
+    ogs_hash_destroy(self.upf_dnn_hash);
+    ogs_assert(self.upf_area_hash);
+    ogs_hash_destroy(self.upf_area_hash);
+
     ogs_pool_final(&smf_ue_pool);
     ogs_pool_final(&smf_bearer_pool);
     ogs_pool_final(&smf_pf_pool);
@@ -167,6 +184,22 @@ static int smf_context_validation(void)
     nf_instance = ogs_sbi_self()->nf_instance;
     ogs_assert(nf_instance);
 
+    if (self.num_of_pfcp_thread < 0) {
+        ogs_error("Invalid smf.pfcp_thread[%d] in '%s'",
+                self.num_of_pfcp_thread, ogs_app()->file);
+        return OGS_ERROR;
+    }
+
+    if (self.ctf_config.report_window < 0) {
+        ogs_error("Invalid smf.ctf.report_window in '%s'", ogs_app()->file);
+        return OGS_ERROR;
+    }
+    if (self.ctf_config.prefetch < 0 || self.ctf_config.prefetch >= 100) {
+        ogs_error("Invalid smf.ctf.prefetch[%d] in '%s'",
+                self.ctf_config.prefetch, ogs_app()->file);
+        return OGS_ERROR;
+    }
+
     if (self.dns[0] == NULL && self.dns6[0] == NULL) {
         ogs_error("No smf.dns in '%s'", ogs_app()->file);
         return OGS_ERROR;
@@ -477,6 +510,19 @@ int smf_context_parse_config(void)
                             else
                                 ogs_warn("unknown 'enabled' value `%s`",
                                         enabled);
+                        } else if (!strcmp(ctf_key, "report_window")) {
+                            const char *v = ogs_yaml_iter_value(&ctf_iter);
+                            if (v)
+                                self.ctf_config.report_window =
+                                    ogs_time_from_msec(atoll(v));
+                        } else if (!strcmp(ctf_key, "prefetch")) {
+                            const char *v = ogs_yaml_iter_value(&ctf_iter);
+                            if (v) self.ctf_config.prefetch = atoi(v);
+                        } else if (!strcmp(ctf_key, "requested_octets")) {
+                            const char *v = ogs_yaml_iter_value(&ctf_iter);
+                            if (v)
+                                self.ctf_config.requested_octets =
+                                    strtoull(v, NULL, 10);
                         } else
                             ogs_warn("unknown key `%s`", ctf_key);
                     }
@@ -527,6 +573,9 @@ int smf_context_parse_config(void)
                             YAML_SCALAR_NODE);
                     self.mtu = atoi(ogs_yaml_iter_value(&smf_iter));
                     ogs_assert(self.mtu);
+                } else if (!strcmp(smf_key, "pfcp_thread")) {
+                    const char *v = ogs_yaml_iter_value(&smf_iter);
+                    if (v) self.num_of_pfcp_thread = atoi(v);
                 } else if (!strcmp(smf_key, "p-cscf")) {
                     ogs_yaml_iter_t p_cscf_iter;
                     ogs_yaml_iter_recurse(&smf_iter, &p_cscf_iter);
@@ -955,6 +1004,9 @@ int smf_context_parse_config(void)
     rv = smf_context_validation();
     if (rv != OGS_OK) return rv;
 
+    rv = smf_upf_index_build();
+    if (rv != OGS_OK) return rv;
+
     return OGS_OK;
 }
 
@@ -1093,67 +1145,247 @@ smf_ue_t *smf_ue_find_by_imsi(uint8_t *imsi, int imsi_len)
     return (smf_ue_t *)ogs_hash_get(self.imsi_hash, imsi, imsi_len);
 }
 
-static bool compare_ue_info(ogs_pfcp_node_t *node, smf_sess_t *sess)
+/*
+ * UPF Selection Index
+ *
+ * Built once from the UPF configuration (dnn/tac/e_cell_id/nr_cell_id).
+ * Each entry holds the UPFs serving the DNN or the area,
+ * so the selection does not walk every UPF and every configured value.
+ */
+typedef struct upf_index_s {
+    union {
+        char *dnn;
+        struct {
+#define UPF_INDEX_TAC           1
+#define UPF_INDEX_E_CELL_ID     2
+#define UPF_INDEX_NR_CELL_ID    3
+            uint64_t type;
+            uint64_t value;
+        } area;
+    } key;
+
+    int num_of_node;
+    ogs_pfcp_node_t **node;
+} upf_index_t;
+
+static struct {
+    int num_of_node;
+    ogs_pfcp_node_t **node;
+} candidate;
+
+static void upf_index_add_node(upf_index_t *index, ogs_pfcp_node_t *node)
 {
     int i;
 
+    ogs_assert(index);
     ogs_assert(node);
-    ogs_assert(sess);
-    ogs_assert(sess->session.name);
 
-    for (i = 0; i < node->num_of_dnn; i++)
-        if (ogs_strcasecmp(node->dnn[i], sess->session.name) == 0) return true;
+    for (i = 0; i < index->num_of_node; i++)
+        if (index->node[i] == node) return;
 
-    for (i = 0; i < node->num_of_e_cell_id; i++)
-        if (sess->gtp_rat_type == OGS_GTP2_RAT_TYPE_EUTRAN &&
-                node->e_cell_id[i] == sess->e_cgi.cell_id) return true;
+    index->node = ogs_realloc(index->node,
+            (index->num_of_node + 1) * sizeof(ogs_pfcp_node_t *));
+    ogs_assert(index->node);
+    index->node[index->num_of_node++] = node;
+}
 
-    for (i = 0; i < node->num_of_nr_cell_id; i++)
-        if (node->nr_cell_id[i] == sess->nr_cgi.cell_id) return true;
+static void upf_index_add_dnn(const char *dnn, ogs_pfcp_node_t *node)
+{
+    upf_index_t *index = NULL;
+    char key[OGS_MAX_DNN_LEN+1];
+    int i;
 
-    for (i = 0; i < node->num_of_tac; i++)
-        if ((sess->gtp_rat_type == OGS_GTP2_RAT_TYPE_EUTRAN &&
-                node->tac[i] == sess->e_tai.tac) ||
-            (node->tac[i] == sess->nr_tai.tac.v)) return true;
+    ogs_assert(dnn);
 
-    return false;
+    for (i = 0; dnn[i] && i < OGS_MAX_DNN_LEN; i++)
+        key[i] = tolower((unsigned char)dnn[i]);
+    key[i] = 0;
+
+    index = ogs_hash_get(self.upf_dnn_hash, key, OGS_HASH_KEY_STRING);
+    if (!index) {
+        index = ogs_calloc(1, sizeof(*index));
+        ogs_assert(index);
+        index->key.dnn = ogs_strdup(key);
+        ogs_assert(index->key.dnn);
+        ogs_hash_set(self.upf_dnn_hash,
+                index->key.dnn, OGS_HASH_KEY_STRING, index);
+    }
+
+    upf_index_add_node(index, node);
 }
 
-static ogs_pfcp_node_t *selected_upf_node(
-        ogs_pfcp_node_t *current, smf_sess_t *sess)
+static upf_index_t *upf_index_find_area(uint64_t type, uint64_t value)
 {
-    ogs_pfcp_node_t *next, *node;
+    struct {
+        uint64_t type;
+        uint64_t value;
+    } key;
 
-    ogs_assert(current);
-    ogs_assert(sess);
+    key.type = type;
+    key.value = value;
 
-    /* continue search from current position */
-    next = ogs_list_next(current);
-    for (node = next; node; node = ogs_list_next(node)) {
-        if (OGS_FSM_CHECK(&node->sm, smf_pfcp_state_associated) &&
-            compare_ue_info(node, sess) == true) return node;
-    }
-    /* cyclic search from top to current position */
-    for (node = ogs_list_first(&ogs_pfcp_self()->pfcp_peer_list);
-            node != next; node = ogs_list_next(node)) {
-        if (OGS_FSM_CHECK(&node->sm, smf_pfcp_state_associated) &&
-            compare_ue_info(node, sess) == true) return node;
-    }
-
-    if (ogs_app()->parameter.no_pfcp_rr_select == 0) {
-        /* continue search from current position */
-        next = ogs_list_next(current);
-        for (node = next; node; node = ogs_list_next(node)) {
-            if (OGS_FSM_CHECK(&node->sm, smf_pfcp_state_associated))
-                return node;
-        }
-        /* cyclic search from top to current position */
-        for (node = ogs_list_first(&ogs_pfcp_self()->pfcp_peer_list);
-                node != next; node = ogs_list_next(node)) {
-            if (OGS_FSM_CHECK(&node->sm, smf_pfcp_state_associated))
-                return node;
+    return ogs_hash_get(self.upf_area_hash, &key, sizeof(key));
+}
+
+static void upf_index_add_area(
+        uint64_t type, uint64_t value, ogs_pfcp_node_t *node)
+{
+    upf_index_t *index = NULL;
+
+    index = upf_index_find_area(type, value);
+    if (!index) {
+        index = ogs_calloc(1, sizeof(*index));
+        ogs_assert(index);
+        index->key.area.type = type;
+        index->key.area.value = value;
+        ogs_hash_set(self.upf_area_hash,
+                &index->key.area, sizeof(index->key.area), index);
+    }
+
+    upf_index_add_node(index, node);
+}
+
+static void upf_index_remove_all(void)
+{
+    ogs_hash_index_t *hi = NULL;
+
+    for (hi = ogs_hash_first(self.upf_dnn_hash); hi; hi = ogs_hash_next(hi)) {
+        upf_index_t *index = ogs_hash_this_val(hi);
+        ogs_assert(index);
+        ogs_hash_set(self.upf_dnn_hash,
+                index->key.dnn, OGS_HASH_KEY_STRING, NULL);
+        ogs_free(index->key.dnn);
+        ogs_free(index->node);
+        ogs_free(index);
+    }
+
+    for (hi = ogs_hash_first(self.upf_area_hash); hi; hi = ogs_hash_next(hi)) {
+        upf_index_t *index = ogs_hash_this_val(hi);
+        ogs_assert(index);
+        ogs_hash_set(self.upf_area_hash,
+                &index->key.area, sizeof(index->key.area), NULL);
+        ogs_free(index->node);
+        ogs_free(index);
+    }
+
+    if (candidate.node)
+        ogs_free(candidate.node);
+    memset(&candidate, 0, sizeof(candidate));
+}
+
+int smf_upf_index_build(void)
+{
+    ogs_pfcp_node_t *node = NULL;
+    int i;
+
+    upf_index_remove_all();
+
+    ogs_list_for_each(&ogs_pfcp_self()->pfcp_peer_list, node) {
+        for (i = 0; i < node->num_of_dnn; i++)
+            upf_index_add_dnn(node->dnn[i], node);
+        for (i = 0; i < node->num_of_tac; i++)
+            upf_index_add_area(UPF_INDEX_TAC, node->tac[i], node);
+        for (i = 0; i < node->num_of_e_cell_id; i++)
+            upf_index_add_area(UPF_INDEX_E_CELL_ID, node->e_cell_id[i], node);
+        for (i = 0; i < node->num_of_nr_cell_id; i++)
+            upf_index_add_area(
+                    UPF_INDEX_NR_CELL_ID, node->nr_cell_id[i], node);
+
+        candidate.num_of_node++;
+    }
+
+    /* Candidates can never exceed the number of UPFs in the index */
+    if (candidate.num_of_node) {
+        candidate.node = ogs_calloc(
+                candidate.num_of_node, sizeof(ogs_pfcp_node_t *));
+        ogs_assert(candidate.node);
+    }
+
+    return OGS_OK;
+}
+
+static void candidate_add(upf_index_t *index, int *num)
+{
+    int i, j;
+
+    if (!index) return;
+
+    for (i = 0; i < index->num_of_node; i++) {
+        for (j = 0; j < *num; j++)
+            if (candidate.node[j] == index->node[i]) break;
+        if (j == *num) {
+            ogs_assert(*num < candidate.num_of_node);
+            candidate.node[(*num)++] = index->node[i];
         }
     }
+}
+
+/*
+ * Smooth weighted round-robin.
+ *
+ * The configured weight is scaled down by the load metric
+ * that the UPF reports with PFCP Load Control Information.
+ * With the same weight and no load, it is a plain round-robin.
+ */
+static void weighted_select(ogs_pfcp_node_t *node,
+        ogs_pfcp_node_t **selected, int *total)
+{
+    int weight;
+
+    ogs_assert(node);
+
+    if (!OGS_FSM_CHECK(&node->sm, smf_pfcp_state_associated))
+        return;
+
+    weight = node->weight * (100 - node->load.metric) + 1;
+
+    node->current_weight += weight;
+    *total += weight;
+
+    if (*selected == NULL ||
+        node->current_weight > (*selected)->current_weight)
+        *selected = node;
+}
+
+static ogs_pfcp_node_t *selected_upf_node(smf_sess_t *sess)
+{
+    ogs_pfcp_node_t *node = NULL, *selected = NULL;
+    char key[OGS_MAX_DNN_LEN+1];
+    int i, num = 0, total = 0;
+
+    ogs_assert(sess);
+    ogs_assert(sess->session.name);
+
+    for (i = 0; sess->session.name[i] && i < OGS_MAX_DNN_LEN; i++)
+        key[i] = tolower((unsigned char)sess->session.name[i]);
+    key[i] = 0;
+
+    candidate_add(ogs_hash_get(
+                self.upf_dnn_hash, key, OGS_HASH_KEY_STRING), &num);
+    if (sess->gtp_rat_type == OGS_GTP2_RAT_TYPE_EUTRAN) {
+        candidate_add(upf_index_find_area(
+                    UPF_INDEX_E_CELL_ID, sess->e_cgi.cell_id), &num);
+        candidate_add(upf_index_find_area(
+                    UPF_INDEX_TAC, sess->e_tai.tac), &num);
+    }
+    candidate_add(upf_index_find_area(
+                UPF_INDEX_NR_CELL_ID, sess->nr_cgi.cell_id), &num);
+    candidate_add(upf_index_find_area(
+                UPF_INDEX_TAC, sess->nr_tai.tac.v), &num);
+
+    for (i = 0; i < num; i++)
+        weighted_select(candidate.node[i], &selected, &total);
+
+    if (!selected && ogs_app()->parameter.no_pfcp_rr_select == 0) {
+        total = 0;
+        ogs_list_for_each(&ogs_pfcp_self()->pfcp_peer_list, node)
+            weighted_select(node, &selected, &total);
+    }
+
+    if (selected) {
+        selected->current_weight -= total;
+        return selected;
+    }
 
     ogs_error("No UPFs are PFCP associated that are suited to RR");
     return ogs_list_first(&ogs_pfcp_self()->pfcp_peer_list);
@@ -1165,17 +1397,8 @@ void smf_sess_select_upf(smf_sess_t *sess)
 
     ogs_assert(sess);
 
-    /*
-     * When used for the first time, if last node is set,
-     * the search is performed from the first UPF in a round-robin manner.
-     */
-    if (ogs_pfcp_self()->pfcp_node == NULL)
-        ogs_pfcp_self()->pfcp_node =
-            ogs_list_last(&ogs_pfcp_self()->pfcp_peer_list);
-
     /* setup GTP session with selected UPF */
-    ogs_pfcp_self()->pfcp_node =
-        selected_upf_node(ogs_pfcp_self()->pfcp_node, sess);
+    ogs_pfcp_self()->pfcp_node = selected_upf_node(sess);
     ogs_assert(ogs_pfcp_self()->pfcp_node);
     OGS_SETUP_PFCP_NODE(sess, ogs_pfcp_self()->pfcp_node);
     ogs_debug("UE using UPF on IP[%s]",
@@ -1672,6 +1895,9 @@ void smf_sess_remove(smf_sess_t *sess)
     e.sess = sess;
     ogs_fsm_fini(&sess->sm, &e);
 
+    if (sess->gy.t_report_window)
+        ogs_timer_delete(sess->gy.t_report_window);
+
     OGS_TLV_CLEAR_DATA(&sess->gtp.ue_pco);
     OGS_TLV_CLEAR_DATA(&sess->gtp.ue_epco);
     OGS_TLV_CLEAR_DATA(&sess->gtp.user_location_information);
@@ -60,6 +60,13 @@ typedef enum {
 
 typedef struct smf_ctf_config_s {
     smf_ctf_enabled_mode_e enabled;
+
+    /* Usage reports within this window are sent in one CCR-Update */
+    ogs_time_t report_window;
+    /* Ask for the next quota when this percentage of it is left */
+    int prefetch;
+    /* CC-Total-Octets in Requested-Service-Unit (0: not sent) */
+    uint64_t requested_octets;
 } smf_ctf_config_t;
 
 int smf_ctf_config_init(smf_ctf_config_t *ctf_config);
@@ -90,9 +97,13 @@ typedef struct smf_context_s {
     ogs_hash_t      *ipv6_hash;     /* hash table (IPv6 Address) */
     ogs_hash_t      *smf_n4_seid_hash; /* hash table (SMF-N4-SEID) */
     ogs_hash_t      *n1n2message_hash; /* hash table (N1N2Message Location) */
+    ogs_hash_t      *upf_dnn_hash;  /* hash table (DNN : UPF Index) */
+    ogs_hash_t      *upf_area_hash; /* hash table (TAC/Cell-ID : UPF Index) */
 
     uint16_t        mtu;            /* MTU to advertise in PCO */
 
+    int             num_of_pfcp_thread; /* PFCP parse worker threads */
+
     struct  {
         const char *integrity_protection_indication;
         const char *confidentiality_protection_indication;
@@ -354,6 +365,12 @@ typedef struct smf_sess_s {
             uint64_t dl_octets;
             ogs_time_t duration;
         } last_report;
+
+        /* Usage waiting for the report window or the pending CCA-Update */
+        bool report_pending;
+        ogs_timer_t *t_report_window;
+        bool update_in_flight;
+        ogs_time_t update_sent;
     } gy;
 
     struct {
@@ -453,6 +470,7 @@ smf_sess_t *smf_sess_add_by_apn(smf_ue_t *smf_ue, char *apn, uint8_t rat_type);
 smf_sess_t *smf_sess_add_by_sbi_message(ogs_sbi_message_t *message);
 smf_sess_t *smf_sess_add_by_psi(smf_ue_t *smf_ue, uint8_t psi);
 
+int smf_upf_index_build(void);
 void smf_sess_select_upf(smf_sess_t *sess);
 uint8_t smf_sess_set_ue_ip(smf_sess_t *sess);
 void smf_sess_set_paging_n1n2message_location(
@@ -51,6 +51,7 @@ typedef enum {
     SMF_EVT_GN_MESSAGE,
     SMF_EVT_GX_MESSAGE,
     SMF_EVT_GY_MESSAGE,
+    SMF_EVT_GY_TIMER,
 
     SMF_EVT_N4_MESSAGE,
     SMF_EVT_N4_TIMER,
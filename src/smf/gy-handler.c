@@ -23,10 +23,37 @@
 #include "pfcp-path.h"
 #include "gy-handler.h"
 #include "binding.h"
+#include "fd-path.h"
+
+/*
+ * A CCR-Update still unanswered after this long no longer holds back
+ * the next usage report.
+ */
+#define GY_UPDATE_IN_FLIGHT_TIMEOUT ogs_time_from_sec(30)
+
+/*
+ * If the OCS sets no threshold, fall back to a local one so that
+ * the next quota is requested before this one runs out.
+ */
+static uint64_t prefetch_threshold(uint64_t quota)
+{
+    int prefetch = smf_self()->ctf_config.prefetch;
+
+    if (!quota || !prefetch)
+        return 0;
+
+    return quota - (quota * prefetch / 100);
+}
 
 static void urr_update_volume(smf_sess_t *sess, ogs_pfcp_urr_t *urr, ogs_diam_gy_message_t *gy_message)
 {
-    if (gy_message->cca.granted.cc_total_octets_present || gy_message->cca.volume_threshold) {
+    uint64_t volume_threshold = gy_message->cca.volume_threshold;
+
+    if (!volume_threshold && gy_message->cca.granted.cc_total_octets_present)
+        volume_threshold = prefetch_threshold(
+                gy_message->cca.granted.cc_total_octets);
+
+    if (gy_message->cca.granted.cc_total_octets_present || volume_threshold) {
         urr->meas_method |= OGS_PFCP_MEASUREMENT_METHOD_VOLUME;
         ogs_assert(sess->pfcp_node);
         if (sess->pfcp_node->up_function_features.mnop)
@@ -48,11 +75,11 @@ static void urr_update_volume(smf_sess_t *sess, ogs_pfcp_urr_t *urr, ogs_diam_gy
     }
 
     /* Volume Threshold */
-    if (gy_message->cca.volume_threshold) {
-        ogs_debug("Adding Volume Threshold total_octets=%" PRIu32, gy_message->cca.volume_threshold);
+    if (volume_threshold) {
+        ogs_debug("Adding Volume Threshold total_octets=%" PRIu64, volume_threshold);
         urr->rep_triggers.volume_threshold = 1;
         urr->vol_threshold.tovol = 1;
-        urr->vol_threshold.total_volume = gy_message->cca.volume_threshold;
+        urr->vol_threshold.total_volume = volume_threshold;
     } else {
         urr->rep_triggers.volume_threshold = 0;
         urr->vol_threshold.tovol = 0;
@@ -62,7 +89,7 @@ static void urr_update_volume(smf_sess_t *sess, ogs_pfcp_urr_t *urr, ogs_diam_gy
 
 static void urr_update_time(smf_sess_t *sess, ogs_pfcp_urr_t *urr, ogs_diam_gy_message_t *gy_message)
 {
-    uint32_t time_quota;
+    uint32_t time_quota, time_threshold;
 
     if (sess->pfcp_node->up_function_features.vtime) {
         if (gy_message->cca.validity_time > 0) {
@@ -86,7 +113,11 @@ static void urr_update_time(smf_sess_t *sess, ogs_pfcp_urr_t *urr, ogs_diam_gy_m
             time_quota = 0;
     }
 
-    if (gy_message->cca.validity_time || time_quota || gy_message->cca.time_threshold) {
+    time_threshold = gy_message->cca.time_threshold;
+    if (!time_threshold)
+        time_threshold = prefetch_threshold(time_quota);
+
+    if (gy_message->cca.validity_time || time_quota || time_threshold) {
         urr->meas_method |= OGS_PFCP_MEASUREMENT_METHOD_DURATION;
         urr->meas_info.istm  = 1;
     } else {
@@ -103,10 +134,10 @@ static void urr_update_time(smf_sess_t *sess, ogs_pfcp_urr_t *urr, ogs_diam_gy_m
         urr->time_quota = 0;
     }
 
-    if (gy_message->cca.time_threshold) {
-        ogs_debug("Adding Time Threshold secs=%" PRIu32, gy_message->cca.time_threshold);
+    if (time_threshold) {
+        ogs_debug("Adding Time Threshold secs=%" PRIu32, time_threshold);
         urr->rep_triggers.time_threshold = 1;
-        urr->time_threshold = gy_message->cca.time_threshold;
+        urr->time_threshold = time_threshold;
     } else {
         urr->rep_triggers.time_threshold = 0;
         urr->time_threshold = 0;
@@ -150,8 +181,7 @@ uint32_t smf_gy_handle_cca_initial_request(
 }
 
 void smf_gy_handle_cca_update_request(
-        smf_sess_t *sess, ogs_diam_gy_message_t *gy_message,
-        ogs_pfcp_xact_t *pfcp_xact)
+        smf_sess_t *sess, ogs_diam_gy_message_t *gy_message)
 {
     ogs_pfcp_urr_t *urr = NULL;
     smf_bearer_t *bearer;
@@ -167,15 +197,19 @@ void smf_gy_handle_cca_update_request(
 
     ogs_assert(sess);
     ogs_assert(gy_message);
-    ogs_assert(pfcp_xact);
 
     ogs_debug("[Gy CCA Update]");
     ogs_debug("    SGW_S5C_TEID[0x%x] PGW_S5C_TEID[0x%x]",
             sess->sgw_s5c_teid, sess->smf_n4_teid);
 
+    sess->gy.update_in_flight = false;
+
     if (gy_message->result_code != ER_DIAMETER_SUCCESS) {
         ogs_warn("Gy CCA Update Diameter failure: res=%u err=%u",
             gy_message->result_code, *gy_message->err);
+        /* Pending usage waits for the next report or the CCR-Termination */
+        if (sess->gy.t_report_window)
+            ogs_timer_stop(sess->gy.t_report_window);
         // TODO: generate new gtp_xact from sess here? */
         //ogs_assert(OGS_OK ==
         //    smf_epc_pfcp_send_session_deletion_request(sess, gtp_xact));
@@ -229,11 +263,15 @@ void smf_gy_handle_cca_update_request(
     if (modify_flags) {
         modify_flags |= OGS_PFCP_MODIFY_URR|OGS_PFCP_MODIFY_UL_ONLY;
         rv = smf_epc_pfcp_send_all_pdr_modification_request(
-                sess, pfcp_xact, NULL, modify_flags,
+                sess, NULL, NULL, modify_flags,
                 OGS_NAS_PROCEDURE_TRANSACTION_IDENTITY_UNASSIGNED,
                 OGS_GTP1_CAUSE_REACTIACTION_REQUESTED);
         ogs_assert(rv == OGS_OK);
     }
+
+    /* Usage reported while waiting for this answer */
+    if (sess->gy.report_pending)
+        smf_gy_handle_usage_report(sess);
 }
 
 uint32_t smf_gy_handle_cca_termination_request(
@@ -256,3 +294,94 @@ void smf_gy_handle_re_auth_request(
 {
     /* TODO: find out what to do here */
 }
+
+static void send_usage_report(smf_sess_t *sess)
+{
+    if (smf_use_gy_iface() != 1) {
+        ogs_error("No Gy Diameter Peer");
+        return;
+    }
+
+    smf_gy_send_ccr(sess, NULL, OGS_DIAM_GY_CC_REQUEST_TYPE_UPDATE_REQUEST);
+}
+
+static void report_window_start(smf_sess_t *sess, ogs_time_t duration)
+{
+    if (!sess->gy.t_report_window) {
+        sess->gy.t_report_window = ogs_timer_add(ogs_app()->timer_mgr,
+                smf_timer_gy_report_window, sess);
+        ogs_assert(sess->gy.t_report_window);
+    }
+    ogs_timer_start(sess->gy.t_report_window, duration);
+}
+
+/*
+ * While a CCR-Update is waiting for its answer, the pending usage is held
+ * back. The report window timer is armed for the rest of
+ * GY_UPDATE_IN_FLIGHT_TIMEOUT, so the usage still goes out if the
+ * CCA-Update never arrives.
+ */
+static bool update_in_flight(smf_sess_t *sess)
+{
+    ogs_time_t elapsed;
+
+    if (!sess->gy.update_in_flight)
+        return false;
+
+    elapsed = ogs_get_monotonic_time() - sess->gy.update_sent;
+    if (elapsed >= GY_UPDATE_IN_FLIGHT_TIMEOUT) {
+        ogs_warn("No CCA-Update received [%s]", sess->smf_ue->imsi_bcd);
+        sess->gy.update_in_flight = false;
+        return false;
+    }
+
+    report_window_start(sess, GY_UPDATE_IN_FLIGHT_TIMEOUT - elapsed);
+    return true;
+}
+
+/*
+ * Called after the usage of a PFCP Session Report has been added to
+ * sess->gy. The usage is sent in a CCR-Update, but
+ * - while a CCR-Update is waiting for its answer, the usage is kept
+ *   and sent after the CCA-Update arrives.
+ * - unless the quota is exhausted, the usage is kept for
+ *   ctf.report_window so that later reports go in the same CCR-Update.
+ * The usage itself is never lost. The next CCR carries everything
+ * measured since the last one.
+ */
+void smf_gy_handle_usage_report(smf_sess_t *sess)
+{
+    ogs_time_t report_window;
+
+    ogs_assert(sess);
+
+    sess->gy.report_pending = true;
+
+    if (update_in_flight(sess))
+        return;
+
+    report_window = smf_self()->ctf_config.report_window;
+    if (report_window &&
+        sess->gy.reporting_reason !=
+            OGS_DIAM_GY_REPORTING_REASON_QUOTA_EXHAUSTED) {
+        if (!sess->gy.t_report_window ||
+            sess->gy.t_report_window->running == false)
+            report_window_start(sess, report_window);
+        return;
+    }
+
+    send_usage_report(sess);
+}
+
+void smf_gy_handle_report_window_expiry(smf_sess_t *sess)
+{
+    ogs_assert(sess);
+
+    if (!sess->gy.report_pending)
+        return;
+
+    if (update_in_flight(sess))
+        return;
+
+    send_usage_report(sess);
+}
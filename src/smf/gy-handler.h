@@ -31,14 +31,16 @@ uint32_t smf_gy_handle_cca_initial_request(
         smf_sess_t *sess, ogs_diam_gy_message_t *gy_message,
         ogs_gtp_xact_t *gtp_xact);
 void smf_gy_handle_cca_update_request(
-        smf_sess_t *sess, ogs_diam_gy_message_t *gy_message,
-        ogs_pfcp_xact_t *pfcp_xact);
+        smf_sess_t *sess, ogs_diam_gy_message_t *gy_message);
 uint32_t smf_gy_handle_cca_termination_request(
         smf_sess_t *sess, ogs_diam_gy_message_t *gy_message,
         ogs_gtp_xact_t *gtp_xact);
 void smf_gy_handle_re_auth_request(
         smf_sess_t *sess, ogs_diam_gy_message_t *gy_message);
 
+void smf_gy_handle_usage_report(smf_sess_t *sess);
+void smf_gy_handle_report_window_expiry(smf_sess_t *sess);
+
 #ifdef __cplusplus
 }
 #endif
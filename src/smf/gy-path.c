@@ -111,6 +111,15 @@ static void fill_multiple_services_credit_control_ccr(smf_sess_t *sess,
         /* CC-Time, RFC4006 8.21 */
         /* CC-Money, RFC4006 8.22. Not used in 3GPP. */
         /* CC-Total-Octets, RFC4006 8.23 */
+        if (smf_self()->ctf_config.requested_octets) {
+            ret = fd_msg_avp_new(ogs_diam_gy_cc_total_octets, 0, &avpch2);
+            ogs_assert(ret == 0);
+            val.u64 = smf_self()->ctf_config.requested_octets;
+            ret = fd_msg_avp_setvalue (avpch2, &val);
+            ogs_assert(ret == 0);
+            ret = fd_msg_avp_add (avpch1, MSG_BRW_LAST_CHILD, avpch2);
+            ogs_assert(ret == 0);
+        }
         /* CC-Input-Octets, RFC4006 8.24 */
         /* CC-Output-Octets, RFC4006 8.25 */
         /* CC-Service-Specific-Units, RFC4006 8.26 */
@@ -571,8 +580,11 @@ void smf_gy_send_ccr(smf_sess_t *sess, void *xact,
     const char *service_context_id = "32251@3gpp.org";
     uint32_t timestamp, req_slot;
 
-    ogs_assert(xact);
     ogs_assert(sess);
+    /* CCR-Update is not bound to the PFCP transaction which reported
+     * the usage, see smf_gy_handle_usage_report() */
+    ogs_assert(xact ||
+            cc_request_type == OGS_DIAM_GY_CC_REQUEST_TYPE_UPDATE_REQUEST);
 
     ogs_assert(sess->ipv4 || sess->ipv6);
     smf_ue = sess->smf_ue;
@@ -580,6 +592,15 @@ void smf_gy_send_ccr(smf_sess_t *sess, void *xact,
 
     ogs_debug("[Gy][Credit-Control-Request]");
 
+    /* Any usage waiting to be reported goes in this request */
+    sess->gy.report_pending = false;
+    if (sess->gy.t_report_window)
+        ogs_timer_stop(sess->gy.t_report_window);
+    if (cc_request_type == OGS_DIAM_GY_CC_REQUEST_TYPE_UPDATE_REQUEST) {
+        sess->gy.update_in_flight = true;
+        sess->gy.update_sent = ogs_get_monotonic_time();
+    }
+
     /* Create the request */
     ret = fd_msg_new(ogs_diam_gy_cmd_ccr, MSGFL_ALLOC_ETEID, &req);
     ogs_assert(ret == 0);
@@ -1103,7 +1124,18 @@ static void smf_gy_cca_cb(void *data, struct msg **msg)
     }
 
 out:
-    if (!error) {
+    /*
+     * A broken CCA-Update is still passed on as a failure,
+     * so that the SMF stops waiting for it.
+     */
+    if (error && gy_message->cc_request_type ==
+            OGS_DIAM_GY_CC_REQUEST_TYPE_UPDATE_REQUEST) {
+        gy_message->result_code = OGS_DIAM_MISSING_AVP;
+        gy_message->err = &gy_message->result_code;
+    }
+
+    if (!error || gy_message->cc_request_type ==
+            OGS_DIAM_GY_CC_REQUEST_TYPE_UPDATE_REQUEST) {
         e = smf_event_new(SMF_EVT_GY_MESSAGE);
         ogs_assert(e);
 
@@ -77,6 +77,11 @@ int smf_initialize(void)
     rv = smf_gtp_open();
     if (rv != 0) return OGS_ERROR;
 
+    if (smf_self()->num_of_pfcp_thread) {
+        rv = smf_pfcp_worker_init(smf_self()->num_of_pfcp_thread);
+        if (rv != OGS_OK) return rv;
+    }
+
     rv = smf_pfcp_open();
     if (rv != 0) return OGS_ERROR;
 
@@ -121,6 +126,8 @@ void smf_terminate(void)
     ogs_thread_destroy(thread);
     ogs_timer_delete(t_termination_holding);
 
+    smf_pfcp_worker_final();
+
     smf_gtp_close();
     smf_pfcp_close();
     smf_sbi_close();
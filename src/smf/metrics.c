@@ -487,6 +487,7 @@ void smf_metrics_init(void)
 {
     ogs_metrics_context_t *ctx = ogs_metrics_self();
     ogs_metrics_context_init();
+    ogs_sbi_metrics_init();
 
     smf_metrics_init_spec(ctx, smf_metrics_spec_global, smf_metrics_spec_def_global,
             _SMF_METR_GLOB_MAX);
@@ -557,5 +558,6 @@ void smf_metrics_final(void)
         ogs_hash_destroy(metrics_hash_by_cause);
     }
 
+    ogs_sbi_metrics_final();
     ogs_metrics_context_final();
 }
@@ -26,6 +26,7 @@
 #include "sbi-path.h"
 #include "ngap-path.h"
 #include "fd-path.h"
+#include "gy-handler.h"
 
 uint8_t gtp_cause_from_pfcp(uint8_t pfcp_cause, uint8_t gtp_version)
 {
@@ -1329,13 +1330,17 @@ void smf_n4_handle_session_report_request(
             sess->gy.duration += use_rep->duration_measurement.u32;
             ogs_pfcp_parse_usage_report_trigger(
                     &rep_trig, &use_rep->usage_report_trigger);
-            sess->gy.reporting_reason =
-                smf_pfcp_urr_usage_report_trigger2diam_gy_reporting_reason(&rep_trig);
+            /* Quota exhaustion is not hidden by a later report
+             * folded into the same CCR-Update */
+            if (sess->gy.report_pending == false ||
+                sess->gy.reporting_reason !=
+                    OGS_DIAM_GY_REPORTING_REASON_QUOTA_EXHAUSTED)
+                sess->gy.reporting_reason =
+                    smf_pfcp_urr_usage_report_trigger2diam_gy_reporting_reason(&rep_trig);
         }
         switch(smf_use_gy_iface()) {
         case 1:
-            smf_gy_send_ccr(sess, pfcp_xact,
-                    OGS_DIAM_GY_CC_REQUEST_TYPE_UPDATE_REQUEST);
+            smf_gy_handle_usage_report(sess);
             break;
         case -1:
             ogs_error("No Gy Diameter Peer");
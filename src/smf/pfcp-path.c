@@ -158,6 +158,17 @@ static void pfcp_recv_cb(short when, ogs_socket_t fd, void *data)
     e->pfcp_node = node;
     e->pkbuf = pkbuf;
 
+    if (smf_self()->num_of_pfcp_thread) {
+        /* The PFCP worker parses the message and notifies the main loop */
+        rv = smf_pfcp_worker_push(e);
+        if (rv != OGS_OK) {
+            ogs_error("smf_pfcp_worker_push() failed:%d", (int)rv);
+            ogs_pkbuf_free(e->pkbuf);
+            ogs_event_free(e);
+        }
+        return;
+    }
+
     rv = ogs_queue_push(ogs_app()->queue, e);
     if (rv != OGS_OK) {
         ogs_error("ogs_queue_push() failed:%d", (int)rv);
@@ -29,6 +29,10 @@ extern "C" {
 int smf_pfcp_open(void);
 void smf_pfcp_close(void);
 
+int smf_pfcp_worker_init(int num_of_thread);
+void smf_pfcp_worker_final(void);
+int smf_pfcp_worker_push(smf_event_t *e);
+
 int smf_pfcp_send_modify_list(
         smf_sess_t *sess,
         ogs_pkbuf_t *(*modify_list)(
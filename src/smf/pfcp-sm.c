@@ -232,6 +232,32 @@ void smf_pfcp_state_associated(ogs_fsm_t *s, smf_event_t *e)
         if (sess)
             e->sess = sess;
 
+        /* PFCP Load Control Information for the UPF selection */
+        switch (message->h.type) {
+        case OGS_PFCP_SESSION_ESTABLISHMENT_RESPONSE_TYPE:
+            ogs_pfcp_cp_handle_load_control_information(node,
+                &message->pfcp_session_establishment_response.
+                    load_control_information);
+            break;
+        case OGS_PFCP_SESSION_MODIFICATION_RESPONSE_TYPE:
+            ogs_pfcp_cp_handle_load_control_information(node,
+                &message->pfcp_session_modification_response.
+                    load_control_information);
+            break;
+        case OGS_PFCP_SESSION_DELETION_RESPONSE_TYPE:
+            ogs_pfcp_cp_handle_load_control_information(node,
+                &message->pfcp_session_deletion_response.
+                    load_control_information);
+            break;
+        case OGS_PFCP_SESSION_REPORT_REQUEST_TYPE:
+            ogs_pfcp_cp_handle_load_control_information(node,
+                &message->pfcp_session_report_request.
+                    load_control_information);
+            break;
+        default:
+            break;
+        }
+
         switch (message->h.type) {
         case OGS_PFCP_HEARTBEAT_REQUEST_TYPE:
             ogs_expect(true ==
@@ -360,6 +386,12 @@ void smf_pfcp_state_associated(ogs_fsm_t *s, smf_event_t *e)
             ogs_fsm_dispatch(&sess->sm, e);
             break;
 
+        case OGS_PFCP_NODE_REPORT_REQUEST_TYPE:
+            ogs_expect(true ==
+                ogs_pfcp_cp_handle_node_report_request(node, xact,
+                    &message->pfcp_node_report_request));
+            break;
+
         case OGS_PFCP_SESSION_REPORT_REQUEST_TYPE:
             if (!message->h.seid_presence) ogs_error("No SEID");
 
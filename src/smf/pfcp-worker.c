@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "context.h"
+#include "pfcp-path.h"
+
+/*
+ * PFCP parse workers
+ *
+ * The N4 message is parsed in the worker threads. The parsed message is
+ * handed back to the SMF main loop, which still owns the PFCP transactions,
+ * the sessions and every state machine.
+ *
+ * All messages from a PFCP peer are dispatched to the same worker,
+ * so they reach the main loop in the order they were received.
+ */
+
+static struct {
+    int num_of_thread;
+    ogs_thread_t **thread;
+
+    ogs_queue_t **queue;
+} worker;
+
+static void worker_main(void *data);
+
+static void event_free(smf_event_t *e)
+{
+    ogs_assert(e);
+
+    if (e->pfcp_message)
+        ogs_pfcp_message_free(e->pfcp_message);
+    if (e->pkbuf)
+        ogs_pkbuf_free(e->pkbuf);
+    ogs_event_free(e);
+}
+
+int smf_pfcp_worker_init(int num_of_thread)
+{
+    int i;
+
+    ogs_assert(num_of_thread > 0);
+    ogs_assert(worker.num_of_thread == 0);
+
+    worker.queue = ogs_calloc(num_of_thread, sizeof(ogs_queue_t *));
+    ogs_assert(worker.queue);
+    worker.thread = ogs_calloc(num_of_thread, sizeof(ogs_thread_t *));
+    ogs_assert(worker.thread);
+
+    for (i = 0; i < num_of_thread; i++) {
+        worker.queue[i] = ogs_queue_create(ogs_app()->pool.event);
+        ogs_assert(worker.queue[i]);
+    }
+
+    for (i = 0; i < num_of_thread; i++) {
+        worker.thread[i] = ogs_thread_create(worker_main, worker.queue[i]);
+        if (!worker.thread[i]) {
+            ogs_error("ogs_thread_create() failed");
+            worker.num_of_thread = i;
+            while (i < num_of_thread)
+                ogs_queue_destroy(worker.queue[i++]);
+            smf_pfcp_worker_final();
+            return OGS_ERROR;
+        }
+    }
+
+    worker.num_of_thread = num_of_thread;
+
+    ogs_info("PFCP worker thread [%d]", worker.num_of_thread);
+
+    return OGS_OK;
+}
+
+void smf_pfcp_worker_final(void)
+{
+    int i, rv;
+
+    if (!worker.queue)
+        return;
+
+    for (i = 0; i < worker.num_of_thread; i++)
+        ogs_queue_term(worker.queue[i]);
+
+    for (i = 0; i < worker.num_of_thread; i++) {
+        ogs_thread_destroy(worker.thread[i]);
+
+        /* The SMF main loop has already exited. Drop the pending events */
+        for ( ;; ) {
+            smf_event_t *e = NULL;
+
+            rv = ogs_queue_trypop(worker.queue[i], (void**)&e);
+            if (rv != OGS_OK)
+                break;
+
+            event_free(e);
+        }
+
+        ogs_queue_destroy(worker.queue[i]);
+    }
+
+    ogs_free(worker.queue);
+    ogs_free(worker.thread);
+
+    memset(&worker, 0, sizeof(worker));
+}
+
+int smf_pfcp_worker_push(smf_event_t *e)
+{
+    ogs_pfcp_node_t *node = NULL;
+    int len = sizeof(node);
+
+    ogs_assert(e);
+    node = e->pfcp_node;
+    ogs_assert(node);
+    ogs_assert(worker.num_of_thread);
+
+    /*
+     * Never block here. The worker may be waiting for the main loop
+     * to drain its own queue.
+     */
+    return ogs_queue_trypush(worker.queue[
+            ogs_hashfunc_default((const char *)&node, &len) %
+                worker.num_of_thread], e);
+}
+
+static void worker_main(void *data)
+{
+    ogs_queue_t *queue = data;
+    int rv;
+
+    ogs_assert(queue);
+
+    for ( ;; ) {
+        smf_event_t *e = NULL;
+
+        rv = ogs_queue_pop(queue, (void**)&e);
+        if (rv == OGS_DONE)
+            break;
+
+        if (rv != OGS_OK)
+            continue;
+
+        ogs_assert(e);
+        ogs_assert(e->pkbuf);
+
+        e->pfcp_message = ogs_pfcp_parse_msg(e->pkbuf);
+        if (!e->pfcp_message) {
+            ogs_error("ogs_pfcp_parse_msg() failed");
+            event_free(e);
+            continue;
+        }
+
+        rv = ogs_queue_push(ogs_app()->queue, e);
+        if (rv != OGS_OK) {
+            ogs_error("ogs_queue_push() failed:%d", (int)rv);
+            event_free(e);
+        } else {
+            ogs_pollset_notify(ogs_app()->pollset);
+        }
+    }
+}
@@ -333,9 +333,7 @@ void smf_state_operational(ogs_fsm_t *s, smf_event_t *e)
                 ogs_fsm_dispatch(&sess->sm, e);
                 break;
             case OGS_DIAM_GY_CC_REQUEST_TYPE_UPDATE_REQUEST:
-                ogs_assert(e->pfcp_xact);
-                smf_gy_handle_cca_update_request(
-                        sess, gy_message, e->pfcp_xact);
+                smf_gy_handle_cca_update_request(sess, gy_message);
             break;
             case OGS_DIAM_GY_CC_REQUEST_TYPE_TERMINATION_REQUEST:
                 ogs_fsm_dispatch(&sess->sm, e);
@@ -357,6 +355,27 @@ void smf_state_operational(ogs_fsm_t *s, smf_event_t *e)
         ogs_free(gy_message);
         break;
 
+    case SMF_EVT_GY_TIMER:
+        ogs_assert(e);
+        sess = e->sess;
+        ogs_assert(sess);
+        sess = smf_sess_cycle(sess);
+        if (!sess) {
+            ogs_error("Session has already been removed");
+            break;
+        }
+
+        switch (e->h.timer_id) {
+        case SMF_TIMER_GY_REPORT_WINDOW:
+            smf_gy_handle_report_window_expiry(sess);
+            break;
+        default:
+            ogs_error("Unknown timer[%s:%d]",
+                    smf_timer_get_name(e->h.timer_id), e->h.timer_id);
+            break;
+        }
+        break;
+
     case SMF_EVT_S6B_MESSAGE:
         ogs_assert(e);
         s6b_message = e->s6b_message;
@@ -390,8 +409,13 @@ void smf_state_operational(ogs_fsm_t *s, smf_event_t *e)
          * Because ogs_pfcp_message_t is over 80kb in size,
          * it can cause stack overflow.
          * To avoid this, the pfcp_message structure uses heap memory.
+         *
+         * If PFCP worker threads are configured,
+         * the message has already been parsed in the worker.
          */
-        if ((pfcp_message = ogs_pfcp_parse_msg(recvbuf)) == NULL) {
+        pfcp_message = e->pfcp_message;
+        if (!pfcp_message &&
+            (pfcp_message = ogs_pfcp_parse_msg(recvbuf)) == NULL) {
             ogs_error("ogs_pfcp_parse_msg() failed");
             ogs_pkbuf_free(recvbuf);
             break;
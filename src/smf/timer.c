@@ -42,6 +42,8 @@ const char *smf_timer_get_name(int timer_id)
         return "SMF_TIMER_PFCP_NO_HEARTBEAT";
     case SMF_TIMER_PFCP_NO_ESTABLISHMENT_RESPONSE:
         return "SMF_TIMER_PFCP_NO_ESTABLISHMENT_RESPONSE";
+    case SMF_TIMER_GY_REPORT_WINDOW:
+        return "SMF_TIMER_GY_REPORT_WINDOW";
     default: 
        break;
     }
@@ -64,6 +66,12 @@ static void timer_send_event(int timer_id, void *data)
         e->h.timer_id = timer_id;
         e->pfcp_node = data;
         break;
+    case SMF_TIMER_GY_REPORT_WINDOW:
+        e = smf_event_new(SMF_EVT_GY_TIMER);
+        ogs_assert(e);
+        e->h.timer_id = timer_id;
+        e->sess = data;
+        break;
     default:
         ogs_fatal("Unknown timer id[%d]", timer_id);
         ogs_assert_if_reached();
@@ -87,3 +95,8 @@ void smf_timer_pfcp_no_heartbeat(void *data)
 {
     timer_send_event(SMF_TIMER_PFCP_NO_HEARTBEAT, data);
 }
+
+void smf_timer_gy_report_window(void *data)
+{
+    timer_send_event(SMF_TIMER_GY_REPORT_WINDOW, data);
+}
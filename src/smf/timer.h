@@ -33,6 +33,7 @@ typedef enum {
     SMF_TIMER_PFCP_ASSOCIATION,
     SMF_TIMER_PFCP_NO_HEARTBEAT,
     SMF_TIMER_PFCP_NO_ESTABLISHMENT_RESPONSE,
+    SMF_TIMER_GY_REPORT_WINDOW,
 
     MAX_NUM_OF_SMF_TIMER,
 
@@ -42,6 +43,7 @@ const char *smf_timer_get_name(int timer_id);
 
 void smf_timer_pfcp_association(void *data);
 void smf_timer_pfcp_no_heartbeat(void *data);
+void smf_timer_gy_report_window(void *data);
 
 #ifdef __cplusplus
 }
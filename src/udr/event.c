@@ -50,6 +50,13 @@ const char *udr_event_get_name(udr_event_t *e)
     case OGS_EVENT_SBI_TIMER:
         return OGS_EVENT_NAME_SBI_TIMER;
 
+    case OGS_EVENT_DBI_POLL_TIMER:
+        return "OGS_EVENT_DBI_POLL_TIMER";
+    case OGS_EVENT_DBI_MESSAGE:
+        return "OGS_EVENT_DBI_MESSAGE";
+    case OGS_EVENT_DBI_ASYNC:
+        return "OGS_EVENT_DBI_ASYNC";
+
     default:
         break;
     }
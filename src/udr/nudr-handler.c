@@ -20,14 +20,30 @@
 #include "sbi-path.h"
 #include "nudr-handler.h"
 
-bool udr_nudr_dr_handle_subscription_authentication(
-        ogs_sbi_stream_t *stream, ogs_sbi_message_t *recvmsg)
+typedef struct authentication_subscription_s {
+    ogs_sbi_stream_t *stream;
+    char *supi;
+
+    ogs_dbi_auth_info_t auth_info;
+} authentication_subscription_t;
+
+/* Called in the DBI worker thread */
+static int authentication_subscription_lookup(void *data)
 {
-    int rv;
+    authentication_subscription_t *subscription = data;
+
+    ogs_assert(subscription);
+
+    return ogs_dbi_auth_info(subscription->supi, &subscription->auth_info);
+}
+
+static void authentication_subscription_send(int status, void *data)
+{
+    authentication_subscription_t *subscription = data;
+    ogs_dbi_auth_info_t *auth_info = NULL;
 
     ogs_sbi_message_t sendmsg;
     ogs_sbi_response_t *response = NULL;
-    ogs_dbi_auth_info_t auth_info;
 
     char k_string[OGS_KEYSTRLEN(OGS_KEY_LEN)];
     char opc_string[OGS_KEYSTRLEN(OGS_KEY_LEN)];
@@ -35,10 +51,84 @@ bool udr_nudr_dr_handle_subscription_authentication(
     char sqn_string[OGS_KEYSTRLEN(OGS_SQN_LEN)];
 
     char sqn[OGS_SQN_LEN];
-    char *supi = NULL;
 
     OpenAPI_authentication_subscription_t AuthenticationSubscription;
     OpenAPI_sequence_number_t SequenceNumber;
+
+    ogs_assert(subscription);
+    ogs_assert(subscription->stream);
+    ogs_assert(subscription->supi);
+
+    auth_info = &subscription->auth_info;
+
+    /* Dropped at shutdown. The stream is gone with the server */
+    if (status == OGS_DONE)
+        goto out;
+
+    if (status != OGS_OK) {
+        ogs_warn("[%s] Cannot find SUPI in DB", subscription->supi);
+        ogs_assert(true ==
+            ogs_sbi_server_send_error(subscription->stream,
+                OGS_SBI_HTTP_STATUS_NOT_FOUND,
+                NULL, "Cannot find SUPI Type", subscription->supi));
+        goto out;
+    }
+
+    memset(&AuthenticationSubscription, 0,
+            sizeof(AuthenticationSubscription));
+
+    AuthenticationSubscription.authentication_method =
+        OpenAPI_auth_method_5G_AKA;
+
+    ogs_hex_to_ascii(auth_info->k, sizeof(auth_info->k),
+            k_string, sizeof(k_string));
+    AuthenticationSubscription.enc_permanent_key = k_string;
+
+    ogs_hex_to_ascii(auth_info->amf, sizeof(auth_info->amf),
+            amf_string, sizeof(amf_string));
+    AuthenticationSubscription.authentication_management_field =
+            amf_string;
+
+    if (!auth_info->use_opc)
+        milenage_opc(auth_info->k, auth_info->op, auth_info->opc);
+
+    ogs_hex_to_ascii(auth_info->opc, sizeof(auth_info->opc),
+            opc_string, sizeof(opc_string));
+    AuthenticationSubscription.enc_opc_key = opc_string;
+
+    ogs_uint64_to_buffer(auth_info->sqn, OGS_SQN_LEN, sqn);
+    ogs_hex_to_ascii(sqn, sizeof(sqn), sqn_string, sizeof(sqn_string));
+
+    memset(&SequenceNumber, 0, sizeof(SequenceNumber));
+    SequenceNumber.sqn = sqn_string;
+    AuthenticationSubscription.sequence_number = &SequenceNumber;
+
+    memset(&sendmsg, 0, sizeof(sendmsg));
+
+    ogs_assert(AuthenticationSubscription.authentication_method);
+    sendmsg.AuthenticationSubscription = &AuthenticationSubscription;
+
+    response = ogs_sbi_build_response(&sendmsg, OGS_SBI_HTTP_STATUS_OK);
+    ogs_assert(response);
+    ogs_assert(true ==
+            ogs_sbi_server_send_response(subscription->stream, response));
+
+out:
+    ogs_free(subscription->supi);
+    ogs_free(subscription);
+}
+
+bool udr_nudr_dr_handle_subscription_authentication(
+        ogs_sbi_stream_t *stream, ogs_sbi_message_t *recvmsg)
+{
+    int rv;
+
+    ogs_sbi_message_t sendmsg;
+    ogs_sbi_response_t *response = NULL;
+    ogs_dbi_auth_info_t auth_info;
+
+    char *supi = NULL;
+
     OpenAPI_list_t *PatchItemList = NULL;
     OpenAPI_lnode_t *node = NULL;
 
@@ -63,6 +153,38 @@ bool udr_nudr_dr_handle_subscription_authentication(
         return false;
     }
 
+    /*
+     * GET is issued on every UE authentication,
+     * so the DB lookup does not block the main loop.
+     */
+    if (recvmsg->h.resource.component[3] &&
+        strcmp(recvmsg->h.resource.component[3],
+            OGS_SBI_RESOURCE_NAME_AUTHENTICATION_SUBSCRIPTION) == 0 &&
+        strcmp(recvmsg->h.method, OGS_SBI_HTTP_METHOD_GET) == 0) {
+        authentication_subscription_t *subscription = NULL;
+
+        subscription = ogs_calloc(1, sizeof(*subscription));
+        ogs_assert(subscription);
+        subscription->stream = stream;
+        subscription->supi = ogs_strdup(supi);
+        ogs_assert(subscription->supi);
+
+        rv = ogs_dbi_async_call(authentication_subscription_lookup,
+                authentication_subscription_send, subscription);
+        if (rv != OGS_OK) {
+            ogs_error("[%s] ogs_dbi_async_call() failed", supi);
+            ogs_free(subscription->supi);
+            ogs_free(subscription);
+            ogs_assert(true ==
+                ogs_sbi_server_send_error(stream,
+                    OGS_SBI_HTTP_STATUS_SERVICE_UNAVAILABLE,
+                    recvmsg, "DB is busy", supi));
+            return false;
+        }
+
+        return true;
+    }
+
     rv = ogs_dbi_auth_info(supi, &auth_info);
     if (rv != OGS_OK) {
         ogs_warn("[%s] Cannot find SUPI in DB", supi);
@@ -75,49 +197,6 @@ bool udr_nudr_dr_handle_subscription_authentication(
     SWITCH(recvmsg->h.resource.component[3])
     CASE(OGS_SBI_RESOURCE_NAME_AUTHENTICATION_SUBSCRIPTION)
         SWITCH(recvmsg->h.method)
-        CASE(OGS_SBI_HTTP_METHOD_GET)
-            memset(&AuthenticationSubscription, 0,
-                    sizeof(AuthenticationSubscription));
-
-            AuthenticationSubscription.authentication_method =
-                OpenAPI_auth_method_5G_AKA;
-
-            ogs_hex_to_ascii(auth_info.k, sizeof(auth_info.k),
-                    k_string, sizeof(k_string));
-            AuthenticationSubscription.enc_permanent_key = k_string;
-
-            ogs_hex_to_ascii(auth_info.amf, sizeof(auth_info.amf),
-                    amf_string, sizeof(amf_string));
-            AuthenticationSubscription.authentication_management_field =
-                    amf_string;
-
-            if (!auth_info.use_opc)
-                milenage_opc(auth_info.k, auth_info.op, auth_info.opc);
-
-            ogs_hex_to_ascii(auth_info.opc, sizeof(auth_info.opc),
-                    opc_string, sizeof(opc_string));
-            AuthenticationSubscription.enc_opc_key = opc_string;
-
-            ogs_uint64_to_buffer(auth_info.sqn, OGS_SQN_LEN, sqn);
-            ogs_hex_to_ascii(sqn, sizeof(sqn), sqn_string, sizeof(sqn_string));
-
-            memset(&SequenceNumber, 0, sizeof(SequenceNumber));
-            SequenceNumber.sqn = sqn_string;
-            AuthenticationSubscription.sequence_number = &SequenceNumber;
-
-            memset(&sendmsg, 0, sizeof(sendmsg));
-
-            ogs_assert(AuthenticationSubscription.authentication_method);
-            sendmsg.AuthenticationSubscription =
-                &AuthenticationSubscription;
-
-            response = ogs_sbi_build_response(
-                    &sendmsg, OGS_SBI_HTTP_STATUS_OK);
-            ogs_assert(response);
-            ogs_assert(true == ogs_sbi_server_send_response(stream, response));
-
-            return true;
-
         CASE(OGS_SBI_HTTP_METHOD_PATCH)
             char *sqn_string = NULL;
             uint8_t sqn_ms[OGS_SQN_LEN];
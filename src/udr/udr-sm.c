@@ -20,12 +20,28 @@
 #include "sbi-path.h"
 #include "nudr-handler.h"
 
+#define DB_POLLING_TIME ogs_time_from_msec(100)
+
+static ogs_timer_t *t_db_polling = NULL;
+
 void udr_state_initial(ogs_fsm_t *s, udr_event_t *e)
 {
     udr_sm_debug(e);
 
     ogs_assert(s);
 
+#if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 9
+    /* The change stream keeps the subscriber cache(db_cache) coherent */
+    if (ogs_app()->use_mongodb_change_stream) {
+        ogs_dbi_collection_watch_init();
+
+        t_db_polling = ogs_timer_add(ogs_app()->timer_mgr,
+                ogs_timer_dbi_poll_change_stream, 0);
+        ogs_assert(t_db_polling);
+        ogs_timer_start(t_db_polling, DB_POLLING_TIME);
+    }
+#endif
+
     OGS_FSM_TRAN(s, &udr_state_operational);
 }
 
@@ -33,6 +49,9 @@ void udr_state_final(ogs_fsm_t *s, udr_event_t *e)
 {
     udr_sm_debug(e);
 
+    if (t_db_polling)
+        ogs_timer_delete(t_db_polling);
+
     ogs_assert(s);
 }
 
@@ -57,6 +76,28 @@ void udr_state_operational(ogs_fsm_t *s, udr_event_t *e)
         break;
 
     case OGS_FSM_EXIT_SIG:
+        if (t_db_polling) {
+            ogs_timer_stop(t_db_polling);
+        }
+        break;
+
+    case OGS_EVENT_DBI_POLL_TIMER:
+        switch(e->h.timer_id) {
+        case OGS_TIMER_DBI_POLL_CHANGE_STREAM:
+            ogs_dbi_poll_change_stream();
+            ogs_timer_start(t_db_polling, DB_POLLING_TIME);
+            break;
+
+        default:
+            ogs_error("Unknown timer[%s:%d]",
+                    ogs_timer_get_name(e->h.timer_id), e->h.timer_id);
+        }
+        break;
+
+    case OGS_EVENT_DBI_MESSAGE:
+        /* Only the subscriber cache is interested in the change stream */
+        ogs_assert(e->h.dbi.document);
+        bson_destroy(e->h.dbi.document);
         break;
 
     case OGS_EVENT_SBI_SERVER:
@@ -187,6 +228,11 @@ void udr_state_operational(ogs_fsm_t *s, udr_event_t *e)
         ogs_sbi_message_free(&message);
         break;
 
+    case OGS_EVENT_DBI_ASYNC:
+        ogs_assert(e->h.dbi.async);
+        ogs_dbi_async_complete(e->h.dbi.async);
+        break;
+
     case OGS_EVENT_SBI_CLIENT:
         ogs_assert(e);
 
@@ -27,6 +27,12 @@ int __upf_log_domain;
 static OGS_POOL(upf_sess_pool, upf_sess_t);
 static OGS_POOL(upf_n4_seid_pool, ogs_pool_id_t);
 
+/* Sessions with packets accounted since the last flush */
+static OGS_LIST(urr_acc_list);
+
+/* ogs_pfcp_session_report_request_t carries up to 8 Usage Reports */
+#define MAX_NUM_OF_USAGE_REPORT_IN_REQUEST 8
+
 static int context_initialized = 0;
 
 static void upf_sess_urr_acc_remove_all(upf_sess_t *sess);
@@ -668,40 +674,125 @@ uint8_t upf_sess_set_ue_ipv6_framed_routes(upf_sess_t *sess,
     return cause_value;
 }
 
+static uint64_t urr_acc_next_volume_report(
+        upf_sess_urr_acc_t *urr_acc, const ogs_pfcp_urr_t *urr)
+{
+    uint64_t reported, next = UINT64_MAX;
+
+    reported = urr_acc->last_report.octets[UPF_URR_ACC_UL] +
+                urr_acc->last_report.octets[UPF_URR_ACC_DL];
+
+    if (urr->rep_triggers.volume_quota && urr->vol_quota.tovol)
+        next = ogs_min(next, reported + urr->vol_quota.total_volume);
+    if (urr->rep_triggers.volume_threshold && urr->vol_threshold.tovol)
+        next = ogs_min(next, reported + urr->vol_threshold.total_volume);
+
+    return next;
+}
+
+static upf_sess_urr_acc_t *urr_acc_get(
+        upf_sess_t *sess, const ogs_pfcp_urr_t *urr)
+{
+    upf_sess_urr_acc_t **urr_acc = NULL;
+
+    ogs_assert(sess);
+    ogs_assert(urr);
+    ogs_assert(urr->id_node);
+
+    /* The URR-ID is chosen by the SMF, but the ID pool node is local */
+    urr_acc = &sess->urr_acc[*urr->id_node - 1];
+    if (!*urr_acc) {
+        *urr_acc = ogs_calloc(1, sizeof(**urr_acc));
+        ogs_assert(*urr_acc);
+        (*urr_acc)->next_volume_report =
+            urr_acc_next_volume_report(*urr_acc, urr);
+    }
+
+    return *urr_acc;
+}
+
+/*
+ * Called for every packet. Only the counters are updated here.
+ * The packet times and the usage report are left to
+ * upf_sess_urr_acc_flush() at the end of the receive batch.
+ */
 void upf_sess_urr_acc_add(upf_sess_t *sess, ogs_pfcp_urr_t *urr, size_t size, bool is_uplink)
 {
-    upf_sess_urr_acc_t *urr_acc = &sess->urr_acc[urr->id];
-    uint64_t vol;
+    upf_sess_urr_acc_t *urr_acc = urr_acc_get(sess, urr);
+    int dir = is_uplink ? UPF_URR_ACC_UL : UPF_URR_ACC_DL;
 
-    /* Increment total & ul octets + pkts */
-    urr_acc->total_octets += size;
-    urr_acc->total_pkts++;
-    if (is_uplink) {
-        urr_acc->ul_octets += size;
-        urr_acc->ul_pkts++;
-    } else {
-        urr_acc->dl_octets += size;
-        urr_acc->dl_pkts++;
+    urr_acc->octets[dir] += size;
+    urr_acc->pkts[dir]++;
+    urr_acc->touched = true;
+
+    /* Volume threshold/quota is reached */
+    if (urr_acc->octets[UPF_URR_ACC_UL] + urr_acc->octets[UPF_URR_ACC_DL] >=
+            urr_acc->next_volume_report)
+        urr_acc->report_pending = true;
+
+    if (sess->urr_acc_queued == false) {
+        ogs_list_add(&urr_acc_list, &sess->urr_acc_node);
+        sess->urr_acc_queued = true;
     }
+}
 
-    urr_acc->time_of_last_packet = ogs_time_now();
-    if (urr_acc->time_of_first_packet == 0)
-        urr_acc->time_of_first_packet = urr_acc->time_of_last_packet;
+void upf_sess_urr_acc_flush(void)
+{
+    upf_sess_t *sess = NULL, *next_sess = NULL;
+    ogs_time_t now;
+
+    if (ogs_list_first(&urr_acc_list) == NULL)
+        return;
+
+    now = ogs_time_coarse_now();
 
-    /* generate report if volume threshold/quota is reached */
-    vol = urr_acc->total_octets - urr_acc->last_report.total_octets;
-    if ((urr->rep_triggers.volume_quota && urr->vol_quota.tovol && vol >= urr->vol_quota.total_volume) ||
-        (urr->rep_triggers.volume_threshold && urr->vol_threshold.tovol && vol >= urr->vol_threshold.total_volume)) {
+    ogs_list_for_each_entry_safe(
+            &urr_acc_list, next_sess, sess, urr_acc_node) {
         ogs_pfcp_user_plane_report_t report;
+        ogs_pfcp_urr_t *urr = NULL;
+        upf_sess_urr_acc_t *urr_acc = NULL;
+        unsigned int num_of_reports = 0;
+
+        ogs_list_remove(&urr_acc_list, &sess->urr_acc_node);
+        sess->urr_acc_queued = false;
+
         memset(&report, 0, sizeof(report));
-        upf_sess_urr_acc_fill_usage_report(sess, urr, &report, 0);
-        report.num_of_usage_report = 1;
-        upf_sess_urr_acc_snapshot(sess, urr);
+        ogs_list_for_each(&sess->pfcp.urr_list, urr) {
+            urr_acc = sess->urr_acc[*urr->id_node - 1];
+            if (!urr_acc || urr_acc->touched == false)
+                continue;
+
+            urr_acc->touched = false;
+            urr_acc->time_of_last_packet = now;
+            if (urr_acc->time_of_first_packet == 0)
+                urr_acc->time_of_first_packet = now;
+
+            if (urr_acc->report_pending == false)
+                continue;
+
+            /* All URRs due in this batch go in one Session Report */
+            urr_acc->report_pending = false;
+            upf_sess_urr_acc_fill_usage_report(
+                    sess, urr, &report, num_of_reports);
+            num_of_reports++;
+            upf_sess_urr_acc_snapshot(sess, urr);
+            /* Start new report period/iteration: */
+            upf_sess_urr_acc_timers_setup(sess, urr);
+
+            if (num_of_reports == MAX_NUM_OF_USAGE_REPORT_IN_REQUEST) {
+                report.num_of_usage_report = num_of_reports;
+                ogs_assert(OGS_OK ==
+                    upf_pfcp_send_session_report_request(sess, &report));
+                memset(&report, 0, sizeof(report));
+                num_of_reports = 0;
+            }
+        }
 
-        ogs_assert(OGS_OK ==
-            upf_pfcp_send_session_report_request(sess, &report));
-        /* Start new report period/iteration: */
-        upf_sess_urr_acc_timers_setup(sess, urr);
+        if (num_of_reports) {
+            report.num_of_usage_report = num_of_reports;
+            ogs_assert(OGS_OK ==
+                upf_pfcp_send_session_report_request(sess, &report));
+        }
     }
 }
 
@@ -710,11 +801,11 @@ void upf_sess_urr_acc_add(upf_sess_t *sess, ogs_pfcp_urr_t *urr, size_t size, bo
 void upf_sess_urr_acc_fill_usage_report(upf_sess_t *sess, const ogs_pfcp_urr_t *urr,
                                   ogs_pfcp_user_plane_report_t *report, unsigned int idx)
 {
-    upf_sess_urr_acc_t *urr_acc = &sess->urr_acc[urr->id];
+    upf_sess_urr_acc_t *urr_acc = urr_acc_get(sess, urr);
     ogs_time_t last_report_timestamp;
     ogs_time_t now;
 
-    now = ogs_time_now(); /* we need UTC for start_time and end_time */
+    now = ogs_time_coarse_now(); /* we need UTC for start_time and end_time */
 
     if (urr_acc->last_report.timestamp)
         last_report_timestamp = urr_acc->last_report.timestamp;
@@ -733,13 +824,21 @@ void upf_sess_urr_acc_fill_usage_report(upf_sess_t *sess, const ogs_pfcp_urr_t *
         .dlvol = 1,
         .ulvol = 1,
         .tovol = 1,
-        .total_volume = urr_acc->total_octets - urr_acc->last_report.total_octets,
-        .uplink_volume = urr_acc->ul_octets - urr_acc->last_report.ul_octets,
-        .downlink_volume = urr_acc->dl_octets - urr_acc->last_report.dl_octets,
-        .total_n_packets = urr_acc->total_pkts - urr_acc->last_report.total_pkts,
-        .uplink_n_packets = urr_acc->ul_pkts - urr_acc->last_report.ul_pkts,
-        .downlink_n_packets = urr_acc->dl_pkts - urr_acc->last_report.dl_pkts,
+        .uplink_volume = urr_acc->octets[UPF_URR_ACC_UL] -
+            urr_acc->last_report.octets[UPF_URR_ACC_UL],
+        .downlink_volume = urr_acc->octets[UPF_URR_ACC_DL] -
+            urr_acc->last_report.octets[UPF_URR_ACC_DL],
+        .uplink_n_packets = urr_acc->pkts[UPF_URR_ACC_UL] -
+            urr_acc->last_report.pkts[UPF_URR_ACC_UL],
+        .downlink_n_packets = urr_acc->pkts[UPF_URR_ACC_DL] -
+            urr_acc->last_report.pkts[UPF_URR_ACC_DL],
     };
+    report->usage_report[idx].vol_measurement.total_volume =
+        report->usage_report[idx].vol_measurement.uplink_volume +
+        report->usage_report[idx].vol_measurement.downlink_volume;
+    report->usage_report[idx].vol_measurement.total_n_packets =
+        report->usage_report[idx].vol_measurement.uplink_n_packets +
+        report->usage_report[idx].vol_measurement.downlink_n_packets;
     if (now >= last_report_timestamp)
         report->usage_report[idx].dur_measurement = ((now - last_report_timestamp) + (OGS_USEC_PER_SEC/2)) / OGS_USEC_PER_SEC; /* FIXME: should use MONOTONIC here */
     /* else memset sets it to 0 */
@@ -768,14 +867,19 @@ void upf_sess_urr_acc_fill_usage_report(upf_sess_t *sess, const ogs_pfcp_urr_t *
 
 void upf_sess_urr_acc_snapshot(upf_sess_t *sess, ogs_pfcp_urr_t *urr)
 {
-    upf_sess_urr_acc_t *urr_acc = &sess->urr_acc[urr->id];
-    urr_acc->last_report.total_octets = urr_acc->total_octets;
-    urr_acc->last_report.dl_octets = urr_acc->dl_octets;
-    urr_acc->last_report.ul_octets = urr_acc->ul_octets;
-    urr_acc->last_report.total_pkts = urr_acc->total_pkts;
-    urr_acc->last_report.dl_pkts = urr_acc->dl_pkts;
-    urr_acc->last_report.ul_pkts = urr_acc->ul_pkts;
-    urr_acc->last_report.timestamp = ogs_time_now();
+    upf_sess_urr_acc_t *urr_acc = urr_acc_get(sess, urr);
+    memcpy(urr_acc->last_report.octets, urr_acc->octets,
+            sizeof(urr_acc->octets));
+    memcpy(urr_acc->last_report.pkts, urr_acc->pkts, sizeof(urr_acc->pkts));
+    urr_acc->last_report.timestamp = ogs_time_coarse_now();
+    urr_acc->next_volume_report = urr_acc_next_volume_report(urr_acc, urr);
+}
+
+/* Called when the Volume Quota/Threshold of the URR has changed */
+void upf_sess_urr_acc_volume_setup(upf_sess_t *sess, ogs_pfcp_urr_t *urr)
+{
+    upf_sess_urr_acc_t *urr_acc = urr_acc_get(sess, urr);
+    urr_acc->next_volume_report = urr_acc_next_volume_report(urr_acc, urr);
 }
 
 static void upf_sess_urr_acc_timers_cb(void *data)
@@ -804,7 +908,7 @@ static void upf_sess_urr_acc_timers_cb(void *data)
 
 static void upf_sess_urr_acc_validity_time_setup(upf_sess_t *sess, ogs_pfcp_urr_t *urr)
 {
-    upf_sess_urr_acc_t *urr_acc = &sess->urr_acc[urr->id];
+    upf_sess_urr_acc_t *urr_acc = urr_acc_get(sess, urr);
 
     ogs_debug("Installing URR Quota Validity Time timer");
     urr_acc->reporting_enabled = true;
@@ -816,7 +920,7 @@ static void upf_sess_urr_acc_validity_time_setup(upf_sess_t *sess, ogs_pfcp_urr_
 }
 static void upf_sess_urr_acc_time_quota_setup(upf_sess_t *sess, ogs_pfcp_urr_t *urr)
 {
-    upf_sess_urr_acc_t *urr_acc = &sess->urr_acc[urr->id];
+    upf_sess_urr_acc_t *urr_acc = urr_acc_get(sess, urr);
 
     ogs_debug("Installing URR Time Quota timer");
     urr_acc->reporting_enabled = true;
@@ -827,7 +931,7 @@ static void upf_sess_urr_acc_time_quota_setup(upf_sess_t *sess, ogs_pfcp_urr_t *
 }
 static void upf_sess_urr_acc_time_threshold_setup(upf_sess_t *sess, ogs_pfcp_urr_t *urr)
 {
-    upf_sess_urr_acc_t *urr_acc = &sess->urr_acc[urr->id];
+    upf_sess_urr_acc_t *urr_acc = urr_acc_get(sess, urr);
 
     ogs_debug("Installing URR Time Threshold timer");
     urr_acc->reporting_enabled = true;
@@ -840,8 +944,8 @@ static void upf_sess_urr_acc_time_threshold_setup(upf_sess_t *sess, ogs_pfcp_urr
 
 void upf_sess_urr_acc_timers_setup(upf_sess_t *sess, ogs_pfcp_urr_t *urr)
 {
-    upf_sess_urr_acc_t *urr_acc = &sess->urr_acc[urr->id];
-    urr_acc->time_start = ogs_time_ntp32_now();
+    upf_sess_urr_acc_t *urr_acc = urr_acc_get(sess, urr);
+    urr_acc->time_start = ogs_time_ntp32_coarse_now();
     if (urr->rep_triggers.quota_validity_time && urr->quota_validity_time > 0)
         upf_sess_urr_acc_validity_time_setup(sess, urr);
     if (urr->rep_triggers.time_quota && urr->time_quota > 0)
@@ -850,17 +954,48 @@ void upf_sess_urr_acc_timers_setup(upf_sess_t *sess, ogs_pfcp_urr_t *urr)
         upf_sess_urr_acc_time_threshold_setup(sess, urr);
 }
 
+static void urr_acc_free(upf_sess_urr_acc_t *urr_acc)
+{
+    ogs_assert(urr_acc);
+
+    if (urr_acc->t_validity_time)
+        ogs_timer_delete(urr_acc->t_validity_time);
+    if (urr_acc->t_time_quota)
+        ogs_timer_delete(urr_acc->t_time_quota);
+    if (urr_acc->t_time_threshold)
+        ogs_timer_delete(urr_acc->t_time_threshold);
+
+    ogs_free(urr_acc);
+}
+
+void upf_sess_urr_acc_remove(upf_sess_t *sess, ogs_pfcp_urr_t *urr)
+{
+    upf_sess_urr_acc_t **urr_acc = NULL;
+
+    ogs_assert(sess);
+    ogs_assert(urr);
+    ogs_assert(urr->id_node);
+
+    urr_acc = &sess->urr_acc[*urr->id_node - 1];
+    if (*urr_acc) {
+        urr_acc_free(*urr_acc);
+        *urr_acc = NULL;
+    }
+}
+
 static void upf_sess_urr_acc_remove_all(upf_sess_t *sess)
 {
     unsigned int i;
+
+    if (sess->urr_acc_queued) {
+        ogs_list_remove(&urr_acc_list, &sess->urr_acc_node);
+        sess->urr_acc_queued = false;
+    }
+
     for (i = 0; i < OGS_ARRAY_SIZE(sess->urr_acc); i++) {
-        if (sess->urr_acc[i].t_time_threshold) {
-            ogs_timer_delete(sess->urr_acc[i].t_validity_time);
-            sess->urr_acc[i].t_validity_time = NULL;
-            ogs_timer_delete(sess->urr_acc[i].t_time_quota);
-            sess->urr_acc[i].t_time_quota = NULL;
-            ogs_timer_delete(sess->urr_acc[i].t_time_threshold);
-            sess->urr_acc[i].t_time_threshold = NULL;
+        if (sess->urr_acc[i]) {
+            urr_acc_free(sess->urr_acc[i]);
+            sess->urr_acc[i] = NULL;
         }
     }
 }
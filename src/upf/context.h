@@ -70,6 +70,8 @@ struct upf_route_trie_node {
 };
 
 /* Accounting: */
+#define UPF_URR_ACC_UL 0
+#define UPF_URR_ACC_DL 1
 typedef struct upf_sess_urr_acc_s {
     bool reporting_enabled;
     ogs_timer_t *t_validity_time; /* Quota Validity Time expiration handler */
@@ -77,22 +79,19 @@ typedef struct upf_sess_urr_acc_s {
     ogs_timer_t *t_time_threshold; /* Time Threshold expiration handler */
     uint32_t time_start; /* When t_time_* started */
     ogs_pfcp_urr_ur_seqn_t report_seqn; /* Next seqn to use when reporting */
-    uint64_t total_octets;
-    uint64_t ul_octets;
-    uint64_t dl_octets;
-    uint64_t total_pkts;
-    uint64_t ul_pkts;
-    uint64_t dl_pkts;
+    /* Updated per packet, indexed by UPF_URR_ACC_UL/DL */
+    uint64_t octets[2];
+    uint64_t pkts[2];
+    /* Volume Quota/Threshold as total octets, UINT64_MAX if none */
+    uint64_t next_volume_report;
+    bool touched; /* Packets since upf_sess_urr_acc_flush() */
+    bool report_pending; /* Volume report to send in the next flush */
     ogs_time_t time_of_first_packet;
     ogs_time_t time_of_last_packet;
     /* Snapshot of measurement when last report was sent: */
     struct {
-        uint64_t total_octets;
-        uint64_t ul_octets;
-        uint64_t dl_octets;
-        uint64_t total_pkts;
-        uint64_t ul_pkts;
-        uint64_t dl_pkts;
+        uint64_t octets[2];
+        uint64_t pkts[2];
         ogs_time_t timestamp;
     } last_report;
 } upf_sess_urr_acc_t;
@@ -121,7 +120,10 @@ typedef struct upf_sess_s {
     ogs_pfcp_node_t *pfcp_node;
 
     /* Accounting: */
-    upf_sess_urr_acc_t urr_acc[OGS_MAX_NUM_OF_URR]; /* FIXME: This probably needs to be mved to a hashtable or alike */
+    /* Allocated on first use, indexed by the URR's local ID pool node */
+    upf_sess_urr_acc_t *urr_acc[OGS_MAX_NUM_OF_URR];
+    ogs_lnode_t     urr_acc_node;       /* Touched since the last flush */
+    bool            urr_acc_queued;
     char            *apn_dnn;            /* APN/DNN Item */
 } upf_sess_t;
 
@@ -154,6 +156,9 @@ void upf_sess_urr_acc_fill_usage_report(upf_sess_t *sess, const ogs_pfcp_urr_t *
                                         ogs_pfcp_user_plane_report_t *report, unsigned int idx);
 void upf_sess_urr_acc_snapshot(upf_sess_t *sess, ogs_pfcp_urr_t *urr);
 void upf_sess_urr_acc_timers_setup(upf_sess_t *sess, ogs_pfcp_urr_t *urr);
+void upf_sess_urr_acc_volume_setup(upf_sess_t *sess, ogs_pfcp_urr_t *urr);
+void upf_sess_urr_acc_remove(upf_sess_t *sess, ogs_pfcp_urr_t *urr);
+void upf_sess_urr_acc_flush(void);
 
 #ifdef __cplusplus
 }
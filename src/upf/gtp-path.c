@@ -99,8 +99,7 @@ static uint16_t _get_eth_type(uint8_t *data, uint len) {
     return 0;
 }
 
-static void _gtpv1_tun_recv_common_cb(
-        short when, ogs_socket_t fd, bool has_eth, void *data)
+static int _gtpv1_tun_recv(ogs_socket_t fd, bool has_eth)
 {
     ogs_pkbuf_t *recvbuf = NULL;
 
@@ -113,8 +112,11 @@ static void _gtpv1_tun_recv_common_cb(
 
     recvbuf = ogs_tun_read(fd, packet_pool);
     if (!recvbuf) {
+        if (ogs_socket_errno == OGS_EAGAIN)
+            return OGS_RETRY;
+
         ogs_warn("ogs_tun_read() failed");
-        return;
+        return OGS_ERROR;
     }
 
     if (has_eth) {
@@ -205,6 +207,7 @@ static void _gtpv1_tun_recv_common_cb(
     if (!pdr) {
         if (ogs_app()->parameter.multicast) {
             upf_gtp_handle_multicast(recvbuf);
+            recvbuf = NULL;
         }
         goto cleanup;
     }
@@ -215,6 +218,7 @@ static void _gtpv1_tun_recv_common_cb(
 
     ogs_assert(true == ogs_pfcp_up_handle_pdr(
                 pdr, OGS_GTPU_MSGTYPE_GPDU, NULL, recvbuf, &report));
+    recvbuf = NULL;
 
     /*
      * Issue #2210, Discussion #2208, #2209
@@ -243,7 +247,30 @@ static void _gtpv1_tun_recv_common_cb(
     }
 
 cleanup:
-    ogs_pkbuf_free(recvbuf);
+    if (recvbuf)
+        ogs_pkbuf_free(recvbuf);
+    return OGS_OK;
+}
+
+/*
+ * The data plane is registered with OGS_POLLET.
+ * Read until EAGAIN, or re-arm the fd if OGS_POLL_BUDGET runs out.
+ * Any other error only drops that packet, since the datagrams queued
+ * behind it would not be signalled again.
+ */
+static void _gtpv1_tun_recv_common_cb(
+        short when, ogs_socket_t fd, bool has_eth, void *data)
+{
+    int i;
+
+    for (i = 0; i < OGS_POLL_BUDGET; i++)
+        if (_gtpv1_tun_recv(fd, has_eth) == OGS_RETRY)
+            break;
+
+    upf_sess_urr_acc_flush();
+
+    if (i == OGS_POLL_BUDGET)
+        ogs_pollset_rearm(ogs_app()->pollset, fd);
 }
 
 static void _gtpv1_tun_recv_cb(short when, ogs_socket_t fd, void *data)
@@ -256,8 +283,9 @@ static void _gtpv1_tun_recv_eth_cb(short when, ogs_socket_t fd, void *data)
     _gtpv1_tun_recv_common_cb(when, fd, true, data);
 }
 
-static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
+static int _gtpv1_u_recv(ogs_socket_t fd, ogs_sock_t *sock)
 {
+    int rv = OGS_OK;
     int len;
     ssize_t size;
     char buf1[OGS_ADDRSTRLEN];
@@ -266,7 +294,6 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
     upf_sess_t *sess = NULL;
 
     ogs_pkbuf_t *pkbuf = NULL;
-    ogs_sock_t *sock = NULL;
     ogs_sockaddr_t from;
 
     ogs_gtp2_header_t *gtp_h = NULL;
@@ -274,7 +301,6 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
     ogs_pfcp_user_plane_report_t report;
 
     ogs_assert(fd != INVALID_SOCKET);
-    sock = data;
     ogs_assert(sock);
 
     pkbuf = ogs_pkbuf_alloc(packet_pool, OGS_MAX_PKT_LEN);
@@ -283,9 +309,20 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
     ogs_pkbuf_put(pkbuf, OGS_MAX_PKT_LEN-OGS_TUN_MAX_HEADROOM);
 
     size = ogs_recvfrom(fd, pkbuf->data, pkbuf->len, 0, &from);
-    if (size <= 0) {
+    if (size < 0) {
+        if (ogs_socket_errno == OGS_EAGAIN) {
+            rv = OGS_RETRY;
+            goto cleanup;
+        }
+
         ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
                 "ogs_recv() failed");
+        rv = OGS_ERROR;
+        goto cleanup;
+    }
+    if (size == 0) {
+        /* An empty UDP datagram is valid, but carries no GTP-U */
+        ogs_debug("[DROP] Empty GTPU packet");
         goto cleanup;
     }
 
@@ -308,24 +345,11 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
         goto cleanup;
     }
     if (header_desc.type == OGS_GTPU_MSGTYPE_ECHO_REQ) {
-        ogs_pkbuf_t *echo_rsp;
-
-        ogs_debug("[RECV] Echo Request from [%s]", OGS_ADDR(&from, buf1));
-        echo_rsp = ogs_gtp2_handle_echo_req(pkbuf);
-        ogs_expect(echo_rsp);
-        if (echo_rsp) {
-            ssize_t sent;
-
-            /* Echo reply */
-            ogs_debug("[SEND] Echo Response to [%s]", OGS_ADDR(&from, buf1));
-
-            sent = ogs_sendto(fd, echo_rsp->data, echo_rsp->len, 0, &from);
-            if (sent < 0 || sent != echo_rsp->len) {
-                ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
-                        "ogs_sendto() failed");
-            }
-            ogs_pkbuf_free(echo_rsp);
-        }
+        ogs_gtpu_echo_send_rsp(fd, pkbuf, &from);
+        goto cleanup;
+    }
+    if (header_desc.type == OGS_GTPU_MSGTYPE_ECHO_RSP) {
+        ogs_gtpu_echo_handle_rsp(pkbuf, &from);
         goto cleanup;
     }
     if (header_desc.type != OGS_GTPU_MSGTYPE_END_MARKER &&
@@ -407,7 +431,7 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
              * for a configurable period after an UPF restart
              * when the UPF receives a G-PDU not matching any PDRs.
              */
-            if (ogs_time_ntp32_now() >
+            if (ogs_time_ntp32_coarse_now() >
                    (ogs_pfcp_self()->local_recovery +
                     ogs_time_sec(
                         ogs_app()->time.message.pfcp.association_interval))) {
@@ -467,7 +491,7 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
                  * for a configurable period after an UPF restart
                  * when the UPF receives a G-PDU not matching any PDRs.
                  */
-                if (ogs_time_ntp32_now() >
+                if (ogs_time_ntp32_coarse_now() >
                        (ogs_pfcp_self()->local_recovery +
                         ogs_time_sec(ogs_app()->time.message.pfcp.
                             association_interval))) {
@@ -657,6 +681,7 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
         } else if (far->dst_if == OGS_PFCP_INTERFACE_ACCESS) {
             ogs_assert(true == ogs_pfcp_up_handle_pdr(
                         pdr, header_desc.type, &header_desc, pkbuf, &report));
+            pkbuf = NULL;
 
             if (report.type.downlink_data_report) {
                 ogs_error("Indirect Data Fowarding Buffered");
@@ -684,6 +709,7 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
 
             ogs_assert(true == ogs_pfcp_up_handle_pdr(
                         pdr, header_desc.type, &header_desc, pkbuf, &report));
+            pkbuf = NULL;
 
             ogs_assert(report.type.downlink_data_report == 0);
 
@@ -697,7 +723,23 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
     }
 
 cleanup:
-    ogs_pkbuf_free(pkbuf);
+    if (pkbuf)
+        ogs_pkbuf_free(pkbuf);
+    return rv;
+}
+
+static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
+{
+    int i;
+
+    for (i = 0; i < OGS_POLL_BUDGET; i++)
+        if (_gtpv1_u_recv(fd, data) == OGS_RETRY)
+            break;
+
+    upf_sess_urr_acc_flush();
+
+    if (i == OGS_POLL_BUDGET)
+        ogs_pollset_rearm(ogs_app()->pollset, fd);
 }
 
 int upf_gtp_init(void)
@@ -768,7 +810,7 @@ int upf_gtp_open(void)
             ogs_gtp_self()->gtpu_sock6 = sock;
 
         node->poll = ogs_pollset_add(ogs_app()->pollset,
-                OGS_POLLIN, sock->fd, _gtpv1_u_recv_cb, sock);
+                OGS_POLLIN|OGS_POLLET, sock->fd, _gtpv1_u_recv_cb, sock);
         ogs_assert(node->poll);
     }
 
@@ -797,11 +839,12 @@ int upf_gtp_open(void)
         if (dev->is_tap) {
             _get_dev_mac_addr(dev->ifname, dev->mac_addr);
             dev->poll = ogs_pollset_add(ogs_app()->pollset,
-                    OGS_POLLIN, dev->fd, _gtpv1_tun_recv_eth_cb, NULL);
+                    OGS_POLLIN|OGS_POLLET, dev->fd,
+                    _gtpv1_tun_recv_eth_cb, NULL);
             ogs_assert(dev->poll);
         } else {
             dev->poll = ogs_pollset_add(ogs_app()->pollset,
-                    OGS_POLLIN, dev->fd, _gtpv1_tun_recv_cb, NULL);
+                    OGS_POLLIN|OGS_POLLET, dev->fd, _gtpv1_tun_recv_cb, NULL);
             ogs_assert(dev->poll);
         }
 
@@ -828,6 +871,8 @@ int upf_gtp_open(void)
         }
     }
 
+    ogs_gtpu_echo_init(upf_pfcp_send_node_report_request);
+
     return OGS_OK;
 }
 
@@ -835,6 +880,8 @@ void upf_gtp_close(void)
 {
     ogs_pfcp_dev_t *dev = NULL;
 
+    ogs_gtpu_echo_final();
+
     ogs_socknode_remove_all(&ogs_gtp_self()->gtpu_list);
 
     ogs_list_for_each(&ogs_pfcp_self()->dev_list, dev) {
@@ -876,13 +923,15 @@ static void upf_gtp_handle_multicast(ogs_pkbuf_t *recvbuf)
                                 ogs_pfcp_up_handle_pdr(
                                     pdr, OGS_GTPU_MSGTYPE_GPDU,
                                     NULL, recvbuf, &report));
-                            break;
+                            return;
                         }
                     }
 
-                    return;
+                    break;
                 }
             }
         }
     }
+
+    ogs_pkbuf_free(recvbuf);
 }
@@ -320,6 +320,7 @@ void upf_metrics_init(void)
 {
     ogs_metrics_context_t *ctx = ogs_metrics_self();
     ogs_metrics_context_init();
+    ogs_pfcp_metrics_init();
 
     upf_metrics_init_spec(ctx, upf_metrics_spec_global, upf_metrics_spec_def_global,
             _UPF_METR_GLOB_MAX);
@@ -386,5 +387,6 @@ void upf_metrics_final(void)
         ogs_hash_destroy(metrics_hash_by_dnn);
     }
 
+    ogs_pfcp_metrics_final();
     ogs_metrics_context_final();
 }
@@ -36,6 +36,8 @@ static void upf_n4_handle_create_urr(upf_sess_t *sess, ogs_pfcp_tlv_create_urr_t
         if (!urr)
             return;
 
+        upf_sess_urr_acc_volume_setup(sess, urr);
+
         /* TODO: enable counters somewhere else if ISTM not set, upon first pkt received */
         if (urr->meas_info.istm) {
             upf_sess_urr_acc_timers_setup(sess, urr);
@@ -43,6 +45,28 @@ static void upf_n4_handle_create_urr(upf_sess_t *sess, ogs_pfcp_tlv_create_urr_t
     }
 }
 
+static void upf_n4_handle_remove_urr(upf_sess_t *sess, ogs_pfcp_tlv_remove_urr_t *remove_urr_arr,
+                              uint8_t *cause_value, uint8_t *offending_ie_value)
+{
+    int i;
+    ogs_pfcp_urr_t *urr;
+
+    *cause_value = OGS_PFCP_CAUSE_REQUEST_ACCEPTED;
+
+    for (i = 0; i < OGS_MAX_NUM_OF_URR; i++) {
+        /* Release the accounting before the URR goes away */
+        if (remove_urr_arr[i].presence && remove_urr_arr[i].urr_id.presence) {
+            urr = ogs_pfcp_urr_find(&sess->pfcp, remove_urr_arr[i].urr_id.u32);
+            if (urr)
+                upf_sess_urr_acc_remove(sess, urr);
+        }
+
+        if (ogs_pfcp_handle_remove_urr(&sess->pfcp, &remove_urr_arr[i],
+                    cause_value, offending_ie_value) == false)
+            return;
+    }
+}
+
 void upf_n4_handle_session_establishment_request(
         upf_sess_t *sess, ogs_pfcp_xact_t *xact,
         ogs_pfcp_session_establishment_request_t *req)
@@ -321,18 +345,18 @@ void upf_n4_handle_session_modification_request(
         goto cleanup;
 
     for (i = 0; i < OGS_MAX_NUM_OF_URR; i++) {
-        if (ogs_pfcp_handle_update_urr(&sess->pfcp, &req->update_urr[i],
-                    &cause_value, &offending_ie_value) == NULL)
+        ogs_pfcp_urr_t *urr = ogs_pfcp_handle_update_urr(
+                &sess->pfcp, &req->update_urr[i],
+                &cause_value, &offending_ie_value);
+        if (!urr)
             break;
+        upf_sess_urr_acc_volume_setup(sess, urr);
     }
     if (cause_value != OGS_PFCP_CAUSE_REQUEST_ACCEPTED)
         goto cleanup;
 
-    for (i = 0; i < OGS_MAX_NUM_OF_URR; i++) {
-        if (ogs_pfcp_handle_remove_urr(&sess->pfcp, &req->remove_urr[i],
-                &cause_value, &offending_ie_value) == false)
-            break;
-    }
+    upf_n4_handle_remove_urr(sess, &req->remove_urr[0],
+            &cause_value, &offending_ie_value);
     if (cause_value != OGS_PFCP_CAUSE_REQUEST_ACCEPTED)
         goto cleanup;
 
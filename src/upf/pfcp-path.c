@@ -326,3 +326,25 @@ int upf_pfcp_send_session_report_request(
 
     return rv;
 }
+
+void upf_pfcp_send_node_report_request(ogs_gtp_node_t *gnode, bool failed)
+{
+    ogs_pfcp_node_t *node = NULL;
+    ogs_pfcp_node_report_type_t report_type;
+
+    ogs_assert(gnode);
+
+    report_type.value = 0;
+    if (failed)
+        report_type.user_plane_path_failure_report = 1;
+    else
+        report_type.user_plane_path_recovery_report = 1;
+
+    ogs_list_for_each(&ogs_pfcp_self()->pfcp_peer_list, node) {
+        if (!OGS_FSM_CHECK(&node->sm, upf_pfcp_state_associated))
+            continue;
+
+        ogs_expect(OGS_OK == ogs_pfcp_up_send_node_report_request(
+                    node, report_type, &gnode->ip));
+    }
+}
@@ -41,6 +41,8 @@ int upf_pfcp_send_session_deletion_response(ogs_pfcp_xact_t *xact,
 int upf_pfcp_send_session_report_request(
         upf_sess_t *sess, ogs_pfcp_user_plane_report_t *report);
 
+void upf_pfcp_send_node_report_request(ogs_gtp_node_t *gnode, bool failed);
+
 #ifdef __cplusplus
 }
 #endif
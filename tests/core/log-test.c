@@ -103,11 +103,165 @@ static void test_basic(abts_case *tc, void *data)
 #endif
 }
 
+#if !defined(_WIN32)
+#define TEST_ASYNC_FILE "/tmp/ogs-log-async-test.log"
+#define TEST_ASYNC_COUNT 100
+
+static int async_domain_id;
+
+static void async_func(void *data)
+{
+    int i;
+
+    for (i = 0; i < TEST_ASYNC_COUNT; i++)
+        ogs_log_printf(OGS_LOG_INFO, async_domain_id, 0, __FILE__, __LINE__,
+                OGS_FUNC, 1, "async %ld %d\n", (long)data, i);
+}
+
+static void test_async(abts_case *tc, void *data)
+{
+    int rv, i;
+    long id;
+    int next[2] = { 0, 0 };
+    char line[OGS_HUGE_LEN];
+    ogs_thread_t *thread[2];
+    ogs_log_t *log = NULL;
+    FILE *in = NULL;
+    FILE *null = NULL;
+    int saved_stderr;
+
+    ogs_log_install_domain(&async_domain_id, "async", OGS_LOG_INFO);
+
+    /* Keep the test output clean */
+    fflush(stderr);
+    saved_stderr = dup(STDERR_FILENO);
+    null = fopen("/dev/null", "w");
+    ABTS_TRUE(tc, saved_stderr >= 0 && null != NULL);
+    dup2(fileno(null), STDERR_FILENO);
+    fclose(null);
+
+    unlink(TEST_ASYNC_FILE);
+    log = ogs_log_add_file(TEST_ASYNC_FILE);
+    ABTS_PTR_NOTNULL(tc, log);
+
+    rv = ogs_log_async_start();
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+
+    for (id = 0; id < 2; id++) {
+        thread[id] = ogs_thread_create(async_func, (void *)id);
+        ABTS_PTR_NOTNULL(tc, thread[id]);
+    }
+    for (id = 0; id < 2; id++)
+        ogs_thread_destroy(thread[id]);
+
+    ogs_log_async_stop();
+    ogs_log_remove(log);
+
+    dup2(saved_stderr, STDERR_FILENO);
+    close(saved_stderr);
+
+    in = fopen(TEST_ASYNC_FILE, "r");
+    ABTS_PTR_NOTNULL(tc, in);
+
+    while (fgets(line, sizeof(line), in)) {
+        if (sscanf(line, "async %ld %d", &id, &i) != 2)
+            continue;
+        ABTS_TRUE(tc, id == 0 || id == 1);
+        ABTS_INT_EQUAL(tc, next[id], i);
+        next[id] = i + 1;
+    }
+    ABTS_INT_EQUAL(tc, TEST_ASYNC_COUNT, next[0]);
+    ABTS_INT_EQUAL(tc, TEST_ASYNC_COUNT, next[1]);
+
+    fclose(in);
+    unlink(TEST_ASYNC_FILE);
+}
+
+static bool async_stop_done;
+
+static void async_stop_func(void *data)
+{
+    int i = 0;
+
+    while (!__atomic_load_n(&async_stop_done, __ATOMIC_ACQUIRE))
+        ogs_log_printf(OGS_LOG_INFO, async_domain_id, 0, __FILE__, __LINE__,
+                OGS_FUNC, 1, "stop %ld %d\n", (long)data, i++);
+}
+
+/* Other threads keep logging while the asynchronous logging stops */
+static void test_async_stop(abts_case *tc, void *data)
+{
+    int rv, i;
+    long id;
+    int next[2] = { 0, 0 };
+    char line[OGS_HUGE_LEN];
+    ogs_thread_t *thread[2];
+    ogs_log_t *log = NULL;
+    FILE *in = NULL;
+    FILE *null = NULL;
+    int saved_stderr;
+
+    fflush(stderr);
+    saved_stderr = dup(STDERR_FILENO);
+    null = fopen("/dev/null", "w");
+    ABTS_TRUE(tc, saved_stderr >= 0 && null != NULL);
+    dup2(fileno(null), STDERR_FILENO);
+    fclose(null);
+
+    unlink(TEST_ASYNC_FILE);
+    log = ogs_log_add_file(TEST_ASYNC_FILE);
+    ABTS_PTR_NOTNULL(tc, log);
+
+    rv = ogs_log_async_start();
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+
+    async_stop_done = false;
+    for (id = 0; id < 2; id++) {
+        thread[id] = ogs_thread_create(async_stop_func, (void *)id);
+        ABTS_PTR_NOTNULL(tc, thread[id]);
+    }
+
+    ogs_msleep(10);
+    ogs_log_async_stop();
+    ogs_msleep(10);
+
+    __atomic_store_n(&async_stop_done, true, __ATOMIC_RELEASE);
+    for (id = 0; id < 2; id++)
+        ogs_thread_destroy(thread[id]);
+
+    ogs_log_remove(log);
+
+    dup2(saved_stderr, STDERR_FILENO);
+    close(saved_stderr);
+
+    in = fopen(TEST_ASYNC_FILE, "r");
+    ABTS_PTR_NOTNULL(tc, in);
+
+    /* Messages may be dropped when a ring is full, but never reordered */
+    while (fgets(line, sizeof(line), in)) {
+        if (sscanf(line, "stop %ld %d", &id, &i) != 2)
+            continue;
+        ABTS_TRUE(tc, id == 0 || id == 1);
+        ABTS_TRUE(tc, i >= next[id]);
+        next[id] = i + 1;
+    }
+    ABTS_TRUE(tc, next[0] > 0);
+    ABTS_TRUE(tc, next[1] > 0);
+
+    fclose(in);
+    unlink(TEST_ASYNC_FILE);
+}
+#endif
+
 abts_suite *test_log(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
 
     abts_run_test(suite, test_basic, NULL);
+#if !defined(_WIN32)
+    abts_run_test(suite, test_async, NULL);
+    abts_run_test(suite, test_async_stop, NULL);
+#endif
 
     return suite;
 }
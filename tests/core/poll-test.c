@@ -657,6 +657,70 @@ static void test8_func(abts_case *tc, void *data)
     ogs_pollset_destroy(pollset);
 }
 
+static int test9_count = 0;
+
+static void test9_handler(short when, ogs_socket_t fd, void *data)
+{
+    ogs_pollset_t *pollset = data;
+    char buf[1];
+    int i;
+
+    /* Budget of 2 datagrams per wakeup */
+    for (i = 0; i < 2; i++) {
+        if (ogs_recv(fd, buf, sizeof(buf), 0) < 0)
+            return;
+        test9_count++;
+    }
+
+    ogs_pollset_rearm(pollset, fd);
+}
+
+static void test9_func(abts_case *tc, void *data)
+{
+    int rv, i;
+    ssize_t size;
+    ogs_socket_t fd[2];
+    ogs_poll_t *poll = NULL;
+    ogs_pollset_t *pollset = ogs_pollset_create(512);
+    ABTS_PTR_NOTNULL(tc, pollset);
+
+    ogs_pollset_set_busy_poll(pollset, ogs_time_from_msec(1));
+
+    rv = ogs_socketpair(AF_SOCKPAIR, SOCK_DGRAM, 0, fd);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+
+    poll = ogs_pollset_add(pollset, OGS_POLLIN|OGS_POLLET,
+            fd[1], test9_handler, pollset);
+    ABTS_PTR_NOTNULL(tc, poll);
+
+    for (i = 0; i < 5; i++) {
+        size = ogs_send(fd[0], "x", 1, 0);
+        ABTS_INT_EQUAL(tc, 1, size);
+    }
+
+    rv = ogs_pollset_poll(pollset, ogs_time_from_msec(100));
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    ABTS_INT_EQUAL(tc, 2, test9_count);
+
+    rv = ogs_pollset_poll(pollset, ogs_time_from_msec(100));
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    ABTS_INT_EQUAL(tc, 4, test9_count);
+
+    rv = ogs_pollset_poll(pollset, ogs_time_from_msec(100));
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    ABTS_INT_EQUAL(tc, 5, test9_count);
+
+    rv = ogs_pollset_poll(pollset, ogs_time_from_msec(100));
+    ABTS_INT_EQUAL(tc, OGS_TIMEUP, rv);
+
+    ogs_pollset_remove(poll);
+
+    ogs_closesocket(fd[0]);
+    ogs_closesocket(fd[1]);
+
+    ogs_pollset_destroy(pollset);
+}
+
 abts_suite *test_poll(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
@@ -672,6 +736,7 @@ abts_suite *test_poll(abts_suite *suite)
     abts_run_test(suite, test6_func, NULL);
     abts_run_test(suite, test7_func, NULL);
     abts_run_test(suite, test8_func, NULL);
+    abts_run_test(suite, test9_func, NULL);
 
     return suite;
 }
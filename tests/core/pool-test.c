@@ -228,6 +228,45 @@ static void test3_func(abts_case *tc, void *data)
     ogs_pool_final(&testpool);
 }
 
+static void test4_func(abts_case *tc, void *data)
+{
+    testnode_t *node[5] = {NULL, };
+    testnode_t *reused = NULL;
+
+    ogs_pool_init(&testpool, 4);
+    ABTS_INT_EQUAL(tc, 0, ogs_pool_used(&testpool));
+
+    ogs_pool_alloc(&testpool, &node[0]);
+    ABTS_PTR_NOTNULL(tc, node[0]);
+    ogs_pool_alloc(&testpool, &node[1]);
+    ABTS_PTR_NOTNULL(tc, node[1]);
+    ABTS_INT_EQUAL(tc, 2, ogs_pool_used(&testpool));
+
+    /* The released node is not reused until all nodes are committed */
+    ogs_pool_free(&testpool, node[0]);
+    ogs_pool_alloc(&testpool, &node[2]);
+    ABTS_INT_EQUAL(tc, 3, ogs_pool_index(&testpool, node[2]));
+    ogs_pool_alloc(&testpool, &node[3]);
+    ABTS_INT_EQUAL(tc, 4, ogs_pool_index(&testpool, node[3]));
+    ABTS_INT_EQUAL(tc, 4, ogs_pool_used(&testpool));
+
+    ogs_pool_alloc(&testpool, &reused);
+    ABTS_PTR_EQUAL(tc, node[0], reused);
+    ABTS_PTR_EQUAL(tc, reused, ogs_pool_cycle(&testpool, reused));
+
+    ogs_pool_alloc(&testpool, &node[4]);
+    ABTS_PTR_EQUAL(tc, NULL, node[4]);
+    ABTS_INT_EQUAL(tc, 0, ogs_pool_avail(&testpool));
+
+    ogs_pool_free(&testpool, node[1]);
+    ogs_pool_free(&testpool, node[2]);
+    ogs_pool_free(&testpool, node[3]);
+    ogs_pool_free(&testpool, reused);
+    ABTS_PTR_EQUAL(tc, NULL, ogs_pool_cycle(&testpool, reused));
+
+    ogs_pool_final(&testpool);
+}
+
 abts_suite *test_pool(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
@@ -235,6 +274,7 @@ abts_suite *test_pool(abts_suite *suite)
     abts_run_test(suite, test1_func, NULL);
     abts_run_test(suite, test2_func, NULL);
     abts_run_test(suite, test3_func, NULL);
+    abts_run_test(suite, test4_func, NULL);
 
     return suite;
 }
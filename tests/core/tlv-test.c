@@ -852,6 +852,133 @@ static void test6_func(abts_case *tc, void *data)
     ogs_pkbuf_free(req);
 }
 
+#define TLV_SEQUENCE_NUMBER_TYPE 30
+typedef ogs_tlv_uint16_t tlv_sequence_number_t;
+#define TLV_CHARGING_ID_TYPE 31
+typedef ogs_tlv_uint32_t tlv_charging_id_t;
+#define TLV_BEARER_FLAGS_TYPE 32
+typedef ogs_tlv_uint24_t tlv_bearer_flags_t;
+
+typedef struct _tlv_update_req {
+    tlv_sequence_number_t sequence_number;
+    tlv_charging_id_t charging_id;
+    tlv_bearer_flags_t bearer_flags;
+    tlv_server_info_t server_info;
+} tlv_update_req;
+
+ogs_tlv_desc_t tlv_desc_sequence_number =
+{
+    OGS_TLV_UINT16,
+    "Sequence Number",
+    TLV_SEQUENCE_NUMBER_TYPE,
+    2,
+    0,
+    sizeof(tlv_sequence_number_t),
+    { NULL }
+};
+
+ogs_tlv_desc_t tlv_desc_charging_id =
+{
+    OGS_TLV_UINT32,
+    "Charging ID",
+    TLV_CHARGING_ID_TYPE,
+    4,
+    0,
+    sizeof(tlv_charging_id_t),
+    { NULL }
+};
+
+ogs_tlv_desc_t tlv_desc_bearer_flags =
+{
+    OGS_TLV_UINT24,
+    "Bearer Flags",
+    TLV_BEARER_FLAGS_TYPE,
+    3,
+    0,
+    sizeof(tlv_bearer_flags_t),
+    { NULL }
+};
+
+ogs_tlv_desc_t tlv_desc_update_req = {
+    OGS_TLV_MESSAGE, "Update Req", 0, 0, 0, 0, {
+    &tlv_desc_sequence_number,
+    &tlv_desc_charging_id,
+    &tlv_desc_bearer_flags,
+    &tlv_desc_server_info,
+    NULL,
+}};
+
+static void test7_func(abts_case *tc, void *data)
+{
+    tlv_update_req reqv;
+    tlv_update_req reqv2;
+
+    ogs_pkbuf_t *req = NULL;
+    char testbuf[1024];
+    int rv;
+
+    memset(&reqv, 0, sizeof(tlv_update_req));
+
+    reqv.sequence_number.presence = 1;
+    reqv.sequence_number.u16 = 0x1234;
+    reqv.charging_id.presence = 1;
+    reqv.charging_id.u32 = 0x11223344;
+    reqv.bearer_flags.presence = 1;
+    reqv.bearer_flags.u24 = 0xabcdef;
+    reqv.server_info.presence = 1;
+    reqv.server_info.server_name[0].presence = 1;
+    reqv.server_info.server_name[0].data = (uint8_t*)"\x11\x22\x33";
+    reqv.server_info.server_name[0].len = 3;
+    reqv.server_info.server_name[1].presence = 1;
+    reqv.server_info.server_name[1].data = (uint8_t*)"\x44\x55";
+    reqv.server_info.server_name[1].len = 2;
+
+    /* Building and parsing do not take any node from the TLV pool */
+    req = ogs_tlv_build_msg(&tlv_desc_update_req, &reqv, OGS_TLV_MODE_T2_L2);
+    ABTS_PTR_NOTNULL(tc, req);
+    ABTS_INT_EQUAL(tc, ogs_tlv_pool_avail(), ogs_core()->tlv.pool);
+
+#define TEST_TLV_BUILD_MSG2 \
+    "001e0002 1234001f 00041122 33440020" \
+    "0003abcd ef001a00 0d001900 03112233" \
+    "00190002 4455"
+    ABTS_INT_EQUAL(tc, 38, req->len);
+    ABTS_TRUE(tc, memcmp(req->data,
+        ogs_hex_from_string(TEST_TLV_BUILD_MSG2, testbuf, sizeof(testbuf)),
+        req->len) == 0);
+
+    /* The message structure is left in host byte order */
+    ABTS_INT_EQUAL(tc, 0x1234, reqv.sequence_number.u16);
+    ABTS_INT_EQUAL(tc, 0x11223344, reqv.charging_id.u32);
+    ABTS_INT_EQUAL(tc, 0xabcdef, reqv.bearer_flags.u24);
+
+    memset(&reqv2, 0, sizeof(tlv_update_req));
+    rv = ogs_tlv_parse_msg(&reqv2, &tlv_desc_update_req, req,
+            OGS_TLV_MODE_T2_L2);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    ABTS_INT_EQUAL(tc, ogs_tlv_pool_avail(), ogs_core()->tlv.pool);
+
+    ABTS_INT_EQUAL(tc, 1, reqv2.sequence_number.presence);
+    ABTS_INT_EQUAL(tc, 0x1234, reqv2.sequence_number.u16);
+    ABTS_INT_EQUAL(tc, 1, reqv2.charging_id.presence);
+    ABTS_INT_EQUAL(tc, 0x11223344, reqv2.charging_id.u32);
+    ABTS_INT_EQUAL(tc, 1, reqv2.bearer_flags.presence);
+    ABTS_INT_EQUAL(tc, 0xabcdef, reqv2.bearer_flags.u24);
+    ABTS_INT_EQUAL(tc, 1, reqv2.server_info.presence);
+    ABTS_INT_EQUAL(tc, 3, reqv2.server_info.server_name[0].len);
+    ABTS_INT_EQUAL(tc, 2, reqv2.server_info.server_name[1].len);
+    ABTS_INT_EQUAL(tc, 0, reqv2.server_info.server_name[2].presence);
+
+    /* A truncated IE is rejected */
+    ogs_pkbuf_trim(req, req->len - 1);
+    memset(&reqv2, 0, sizeof(tlv_update_req));
+    rv = ogs_tlv_parse_msg(&reqv2, &tlv_desc_update_req, req,
+            OGS_TLV_MODE_T2_L2);
+    ABTS_INT_EQUAL(tc, OGS_ERROR, rv);
+
+    ogs_pkbuf_free(req);
+}
+
 abts_suite *test_tlv(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
@@ -875,6 +1002,7 @@ abts_suite *test_tlv(abts_suite *suite)
     abts_run_test(suite, test5_func, (void*)OGS_TLV_MODE_T1_L2_I1);
 
     abts_run_test(suite, test6_func, NULL);
+    abts_run_test(suite, test7_func, NULL);
 
     return suite;
 }
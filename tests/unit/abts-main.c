@@ -17,7 +17,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include "ogs-core.h"
+#include "ogs-app.h"
 #include "core/abts.h"
 
 extern int __ogs_s1ap_domain;
@@ -36,6 +36,7 @@ abts_suite *test_ngap_message(abts_suite *suite);
 abts_suite *test_sbi_message(abts_suite *suite);
 abts_suite *test_security(abts_suite *suite);
 abts_suite *test_crash(abts_suite *suite);
+abts_suite *test_ue_pool(abts_suite *suite);
 
 const struct testlist {
     abts_suite *(*func)(abts_suite *suite);
@@ -47,6 +48,7 @@ const struct testlist {
     {test_sbi_message},
     {test_security},
     {test_crash},
+    {test_ue_pool},
     {NULL},
 };
 
@@ -54,6 +56,8 @@ static void terminate(void)
 {
     ogs_sbi_message_final();
 
+    ogs_app_context_final();
+
     ogs_pkbuf_default_destroy();
 
     ogs_core_terminate();
@@ -98,6 +102,8 @@ int main(int argc, const char *const argv[])
     ogs_pkbuf_default_init(&config);
     ogs_pkbuf_default_create(&config);
 
+    ogs_app_context_init();
+
     ogs_sbi_message_init(32, 32);
 
     ogs_log_install_domain(&__ogs_s1ap_domain, "s1ap", OGS_LOG_ERROR);
@@ -184,6 +184,127 @@ static void ngap_message_test4(abts_case *tc, void *data)
     ogs_pkbuf_free(pkbuf);
 }
 
+static ogs_pkbuf_t *ngap_downlink_nas_transport_encode(
+        uint64_t amf_ue_ngap_id, uint32_t ran_ue_ngap_id,
+        ogs_pkbuf_t *naspdu)
+{
+    NGAP_NGAP_PDU_t pdu;
+    NGAP_InitiatingMessage_t *initiatingMessage = NULL;
+    NGAP_DownlinkNASTransport_t *DownlinkNASTransport = NULL;
+
+    NGAP_DownlinkNASTransport_IEs_t *ie = NULL;
+    NGAP_NAS_PDU_t *NAS_PDU = NULL;
+
+    memset(&pdu, 0, sizeof (NGAP_NGAP_PDU_t));
+    pdu.present = NGAP_NGAP_PDU_PR_initiatingMessage;
+    pdu.choice.initiatingMessage = CALLOC(1, sizeof(NGAP_InitiatingMessage_t));
+
+    initiatingMessage = pdu.choice.initiatingMessage;
+    initiatingMessage->procedureCode =
+        NGAP_ProcedureCode_id_DownlinkNASTransport;
+    initiatingMessage->criticality = NGAP_Criticality_ignore;
+    initiatingMessage->value.present =
+        NGAP_InitiatingMessage__value_PR_DownlinkNASTransport;
+
+    DownlinkNASTransport =
+        &initiatingMessage->value.choice.DownlinkNASTransport;
+
+    ie = CALLOC(1, sizeof(NGAP_DownlinkNASTransport_IEs_t));
+    ASN_SEQUENCE_ADD(&DownlinkNASTransport->protocolIEs, ie);
+
+    ie->id = NGAP_ProtocolIE_ID_id_AMF_UE_NGAP_ID;
+    ie->criticality = NGAP_Criticality_reject;
+    ie->value.present = NGAP_DownlinkNASTransport_IEs__value_PR_AMF_UE_NGAP_ID;
+
+    asn_uint642INTEGER(&ie->value.choice.AMF_UE_NGAP_ID, amf_ue_ngap_id);
+
+    ie = CALLOC(1, sizeof(NGAP_DownlinkNASTransport_IEs_t));
+    ASN_SEQUENCE_ADD(&DownlinkNASTransport->protocolIEs, ie);
+
+    ie->id = NGAP_ProtocolIE_ID_id_RAN_UE_NGAP_ID;
+    ie->criticality = NGAP_Criticality_reject;
+    ie->value.present = NGAP_DownlinkNASTransport_IEs__value_PR_RAN_UE_NGAP_ID;
+
+    ie->value.choice.RAN_UE_NGAP_ID = ran_ue_ngap_id;
+
+    ie = CALLOC(1, sizeof(NGAP_DownlinkNASTransport_IEs_t));
+    ASN_SEQUENCE_ADD(&DownlinkNASTransport->protocolIEs, ie);
+
+    ie->id = NGAP_ProtocolIE_ID_id_NAS_PDU;
+    ie->criticality = NGAP_Criticality_reject;
+    ie->value.present = NGAP_DownlinkNASTransport_IEs__value_PR_NAS_PDU;
+
+    NAS_PDU = &ie->value.choice.NAS_PDU;
+
+    NAS_PDU->size = naspdu->len;
+    NAS_PDU->buf = CALLOC(NAS_PDU->size, sizeof(uint8_t));
+    memcpy(NAS_PDU->buf, naspdu->data, NAS_PDU->size);
+
+    return ogs_ngap_encode(&pdu);
+}
+
+static void ngap_message_test5(abts_case *tc, void *data)
+{
+    /* DownlinkNASTransport */
+    struct {
+        uint64_t amf_ue_ngap_id;
+        uint32_t ran_ue_ngap_id;
+        int nas_len;
+    } tests[] = {
+        { 0, 0, 1 },
+        { 1, 1, 42 },
+        { 0x1234, 0xab, 120 },
+        { 0x123456, 0x12345, 200 },
+        { 0xffffffffffULL, 0xffffffff, 1000 },
+        { 0x8000000000ULL, 0x1000000, 16000 },
+    };
+    ogs_pkbuf_t *naspdu = NULL;
+    int i, j;
+
+    for (i = 0; i < OGS_ARRAY_SIZE(tests); i++) {
+        ogs_pkbuf_t *expected = NULL, *pkbuf = NULL;
+
+        ogs_ngap_message_t message, *struct_ptr = NULL;
+        asn_dec_rval_t dec_ret = {0};
+
+        naspdu = ogs_pkbuf_alloc(NULL, tests[i].nas_len);
+        ogs_assert(naspdu);
+        ogs_pkbuf_put(naspdu, tests[i].nas_len);
+        for (j = 0; j < tests[i].nas_len; j++)
+            naspdu->data[j] = j;
+
+        expected = ngap_downlink_nas_transport_encode(
+                tests[i].amf_ue_ngap_id, tests[i].ran_ue_ngap_id, naspdu);
+        ABTS_PTR_NOTNULL(tc, expected);
+
+        pkbuf = ogs_ngap_build_downlink_nas_transport(
+                tests[i].amf_ue_ngap_id, tests[i].ran_ue_ngap_id, naspdu);
+        ABTS_PTR_NOTNULL(tc, pkbuf);
+
+        ABTS_INT_EQUAL(tc, expected->len, pkbuf->len);
+        ABTS_TRUE(tc, memcmp(expected->data, pkbuf->data, pkbuf->len) == 0);
+
+        struct_ptr = &message;
+        memset(struct_ptr, 0, sizeof(ogs_ngap_message_t));
+        dec_ret = aper_decode(NULL, &asn_DEF_NGAP_NGAP_PDU,
+                (void **)&struct_ptr, pkbuf->data, pkbuf->len, 0, 0);
+        ABTS_INT_EQUAL(tc, 0, dec_ret.code);
+
+        ogs_ngap_free(&message);
+        ogs_pkbuf_free(pkbuf);
+        ogs_pkbuf_free(expected);
+        ogs_pkbuf_free(naspdu);
+    }
+
+    /* Fragmented NAS-PDU is left to the generic encoder */
+    naspdu = ogs_pkbuf_alloc(NULL, 16384);
+    ogs_assert(naspdu);
+    ogs_pkbuf_put(naspdu, 16384);
+    ABTS_PTR_EQUAL(tc, NULL,
+            ogs_ngap_build_downlink_nas_transport(1, 1, naspdu));
+    ogs_pkbuf_free(naspdu);
+}
+
 abts_suite *test_ngap_message(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
@@ -194,6 +315,7 @@ abts_suite *test_ngap_message(abts_suite *suite)
     abts_run_test(suite, ngap_message_test2, NULL);
     abts_run_test(suite, ngap_message_test3, NULL);
     abts_run_test(suite, ngap_message_test4, NULL);
+    abts_run_test(suite, ngap_message_test5, NULL);
 
     return suite;
 }
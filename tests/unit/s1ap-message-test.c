@@ -1330,6 +1330,127 @@ static void s1ap_message_test10(abts_case *tc, void *data)
     ogs_pkbuf_free(s1apbuf);
 }
 
+static ogs_pkbuf_t *s1ap_downlink_nas_transport_encode(
+        uint32_t mme_ue_s1ap_id, uint32_t enb_ue_s1ap_id,
+        ogs_pkbuf_t *naspdu)
+{
+    S1AP_S1AP_PDU_t pdu;
+    S1AP_InitiatingMessage_t *initiatingMessage = NULL;
+    S1AP_DownlinkNASTransport_t *DownlinkNASTransport = NULL;
+
+    S1AP_DownlinkNASTransport_IEs_t *ie = NULL;
+    S1AP_NAS_PDU_t *NAS_PDU = NULL;
+
+    memset(&pdu, 0, sizeof (S1AP_S1AP_PDU_t));
+    pdu.present = S1AP_S1AP_PDU_PR_initiatingMessage;
+    pdu.choice.initiatingMessage = CALLOC(1, sizeof(S1AP_InitiatingMessage_t));
+
+    initiatingMessage = pdu.choice.initiatingMessage;
+    initiatingMessage->procedureCode =
+        S1AP_ProcedureCode_id_downlinkNASTransport;
+    initiatingMessage->criticality = S1AP_Criticality_ignore;
+    initiatingMessage->value.present =
+        S1AP_InitiatingMessage__value_PR_DownlinkNASTransport;
+
+    DownlinkNASTransport =
+        &initiatingMessage->value.choice.DownlinkNASTransport;
+
+    ie = CALLOC(1, sizeof(S1AP_DownlinkNASTransport_IEs_t));
+    ASN_SEQUENCE_ADD(&DownlinkNASTransport->protocolIEs, ie);
+
+    ie->id = S1AP_ProtocolIE_ID_id_MME_UE_S1AP_ID;
+    ie->criticality = S1AP_Criticality_reject;
+    ie->value.present = S1AP_DownlinkNASTransport_IEs__value_PR_MME_UE_S1AP_ID;
+
+    ie->value.choice.MME_UE_S1AP_ID = mme_ue_s1ap_id;
+
+    ie = CALLOC(1, sizeof(S1AP_DownlinkNASTransport_IEs_t));
+    ASN_SEQUENCE_ADD(&DownlinkNASTransport->protocolIEs, ie);
+
+    ie->id = S1AP_ProtocolIE_ID_id_eNB_UE_S1AP_ID;
+    ie->criticality = S1AP_Criticality_reject;
+    ie->value.present = S1AP_DownlinkNASTransport_IEs__value_PR_ENB_UE_S1AP_ID;
+
+    ie->value.choice.ENB_UE_S1AP_ID = enb_ue_s1ap_id;
+
+    ie = CALLOC(1, sizeof(S1AP_DownlinkNASTransport_IEs_t));
+    ASN_SEQUENCE_ADD(&DownlinkNASTransport->protocolIEs, ie);
+
+    ie->id = S1AP_ProtocolIE_ID_id_NAS_PDU;
+    ie->criticality = S1AP_Criticality_reject;
+    ie->value.present = S1AP_DownlinkNASTransport_IEs__value_PR_NAS_PDU;
+
+    NAS_PDU = &ie->value.choice.NAS_PDU;
+
+    NAS_PDU->size = naspdu->len;
+    NAS_PDU->buf = CALLOC(NAS_PDU->size, sizeof(uint8_t));
+    memcpy(NAS_PDU->buf, naspdu->data, NAS_PDU->size);
+
+    return ogs_s1ap_encode(&pdu);
+}
+
+static void s1ap_message_test11(abts_case *tc, void *data)
+{
+    /* DownlinkNASTransport */
+    struct {
+        uint32_t mme_ue_s1ap_id;
+        uint32_t enb_ue_s1ap_id;
+        int nas_len;
+    } tests[] = {
+        { 0, 0, 1 },
+        { 1, 1, 42 },
+        { 0xab, 0x1234, 120 },
+        { 0x12345, 0x123456, 200 },
+        { 0xffffffff, 0xffffff, 1000 },
+        { 0x1000000, 0x800000, 16000 },
+    };
+    ogs_pkbuf_t *naspdu = NULL;
+    int i, j;
+
+    for (i = 0; i < OGS_ARRAY_SIZE(tests); i++) {
+        ogs_pkbuf_t *expected = NULL, *pkbuf = NULL;
+
+        ogs_s1ap_message_t message, *struct_ptr = NULL;
+        asn_dec_rval_t dec_ret = {0};
+
+        naspdu = ogs_pkbuf_alloc(NULL, tests[i].nas_len);
+        ogs_assert(naspdu);
+        ogs_pkbuf_put(naspdu, tests[i].nas_len);
+        for (j = 0; j < tests[i].nas_len; j++)
+            naspdu->data[j] = j;
+
+        expected = s1ap_downlink_nas_transport_encode(
+                tests[i].mme_ue_s1ap_id, tests[i].enb_ue_s1ap_id, naspdu);
+        ABTS_PTR_NOTNULL(tc, expected);
+
+        pkbuf = ogs_s1ap_build_downlink_nas_transport(
+                tests[i].mme_ue_s1ap_id, tests[i].enb_ue_s1ap_id, naspdu);
+        ABTS_PTR_NOTNULL(tc, pkbuf);
+
+        ABTS_INT_EQUAL(tc, expected->len, pkbuf->len);
+        ABTS_TRUE(tc, memcmp(expected->data, pkbuf->data, pkbuf->len) == 0);
+
+        struct_ptr = &message;
+        memset(struct_ptr, 0, sizeof(ogs_s1ap_message_t));
+        dec_ret = aper_decode(NULL, &asn_DEF_S1AP_S1AP_PDU,
+                (void **)&struct_ptr, pkbuf->data, pkbuf->len, 0, 0);
+        ABTS_INT_EQUAL(tc, 0, dec_ret.code);
+
+        ogs_s1ap_free(&message);
+        ogs_pkbuf_free(pkbuf);
+        ogs_pkbuf_free(expected);
+        ogs_pkbuf_free(naspdu);
+    }
+
+    /* Fragmented NAS-PDU is left to the generic encoder */
+    naspdu = ogs_pkbuf_alloc(NULL, 16384);
+    ogs_assert(naspdu);
+    ogs_pkbuf_put(naspdu, 16384);
+    ABTS_PTR_EQUAL(tc, NULL,
+            ogs_s1ap_build_downlink_nas_transport(1, 1, naspdu));
+    ogs_pkbuf_free(naspdu);
+}
+
 abts_suite *test_s1ap_message(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
@@ -1346,6 +1467,7 @@ abts_suite *test_s1ap_message(abts_suite *suite)
     abts_run_test(suite, s1ap_message_test8, NULL);
     abts_run_test(suite, s1ap_message_test9, NULL);
     abts_run_test(suite, s1ap_message_test10, NULL);
+    abts_run_test(suite, s1ap_message_test11, NULL);
 
     return suite;
 }
@@ -0,0 +1,370 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-pfcp.h"
+#include "core/abts.h"
+
+/*
+ * 10.45.0.0/24 has 255 slots(10.45.0.0 ~ 10.45.0.254) in 4 words.
+ * The network(.0) and TUN(.1) addresses are reserved,
+ * and the last word has only 63 slots.
+ */
+#define IPV4_POOL_SIZE 255
+#define IPV4_POOL_AVAIL (IPV4_POOL_SIZE - 2)
+
+static uint32_t ipv4_addr(const char *ipstr)
+{
+    ogs_ipsubnet_t ipsub;
+
+    ogs_assert(ogs_ipsubnet(&ipsub, ipstr, NULL) == OGS_OK);
+    return ipsub.sub[0];
+}
+
+static ogs_pfcp_ue_ip_t *ue_ip_alloc(
+        int family, uint8_t *cause_value, const char *ipstr)
+{
+    uint8_t addr[16];
+
+    memset(addr, 0, sizeof addr);
+    if (ipstr) {
+        ogs_ipsubnet_t ipsub;
+
+        ogs_assert(ogs_ipsubnet(&ipsub, ipstr, NULL) == OGS_OK);
+        memcpy(addr, ipsub.sub, sizeof addr);
+    }
+
+    return ogs_pfcp_ue_ip_alloc(cause_value, family, NULL, addr);
+}
+
+static void ue_pool_test1(abts_case *tc, void *data)
+{
+    int i;
+    uint8_t cause_value = 0;
+    uint32_t size = 0;
+    ogs_pfcp_subnet_t *subnet = NULL;
+    ogs_pfcp_ue_ip_t *ue_ip[IPV4_POOL_AVAIL], *extra = NULL;
+
+    ogs_pfcp_context_init();
+
+    subnet = ogs_pfcp_subnet_add("10.45.0.1", "24", NULL, "ogstun");
+    ABTS_PTR_NOTNULL(tc, subnet);
+    ABTS_INT_EQUAL(tc, OGS_OK, ogs_pfcp_ue_pool_generate());
+
+    ABTS_INT_EQUAL(tc, IPV4_POOL_SIZE, subnet->pool.size);
+    ABTS_INT_EQUAL(tc, IPV4_POOL_AVAIL, subnet->pool.avail);
+    ABTS_INT_EQUAL(tc, 0, ogs_pfcp_ue_pool_occupancy(subnet, &size));
+    ABTS_INT_EQUAL(tc, IPV4_POOL_AVAIL, size);
+
+    /* Exhaust the subnet : 10.45.0.2 ~ 10.45.0.254 */
+    for (i = 0; i < IPV4_POOL_AVAIL; i++) {
+        ue_ip[i] = ue_ip_alloc(AF_INET, &cause_value, NULL);
+        ABTS_PTR_NOTNULL(tc, ue_ip[i]);
+        ABTS_INT_EQUAL(tc, i + 2, ue_ip[i]->slot);
+        ABTS_TRUE(tc, ue_ip[i]->static_ip == false);
+        ABTS_TRUE(tc, ue_ip[i]->addr[0] ==
+                htobe32(be32toh(ipv4_addr("10.45.0.0")) + i + 2));
+    }
+
+    /* The last slot is in the last word of the bitmap */
+    ABTS_INT_EQUAL(tc, IPV4_POOL_SIZE - 1, ue_ip[IPV4_POOL_AVAIL-1]->slot);
+    ABTS_TRUE(tc, ue_ip[IPV4_POOL_AVAIL-1]->addr[0] ==
+            ipv4_addr("10.45.0.254"));
+    ABTS_TRUE(tc, subnet->pool.bits[3] == UINT64_MAX);
+    ABTS_TRUE(tc, subnet->pool.full[0] == UINT64_MAX);
+
+    ABTS_INT_EQUAL(tc, 0, subnet->pool.avail);
+    ABTS_INT_EQUAL(tc, IPV4_POOL_AVAIL,
+            ogs_pfcp_ue_pool_occupancy(subnet, NULL));
+
+    extra = ue_ip_alloc(AF_INET, &cause_value, NULL);
+    ABTS_PTR_EQUAL(tc, NULL, extra);
+    ABTS_INT_EQUAL(tc, OGS_PFCP_CAUSE_NO_RESOURCES_AVAILABLE, cause_value);
+
+    for (i = 0; i < IPV4_POOL_AVAIL; i++)
+        ogs_pfcp_ue_ip_free(ue_ip[i]);
+
+    ABTS_INT_EQUAL(tc, IPV4_POOL_AVAIL, subnet->pool.avail);
+    ABTS_INT_EQUAL(tc, 0, ogs_pfcp_ue_pool_occupancy(subnet, NULL));
+    ABTS_TRUE(tc, subnet->pool.bits[3] != UINT64_MAX);
+    ABTS_TRUE(tc, subnet->pool.full[0] != UINT64_MAX);
+
+    ogs_pfcp_context_final();
+}
+
+static void ue_pool_test2(abts_case *tc, void *data)
+{
+    int i;
+    uint8_t cause_value = 0;
+    ogs_pfcp_subnet_t *subnet = NULL;
+    ogs_pfcp_ue_ip_t *ue_ip[IPV4_POOL_AVAIL], *extra = NULL;
+
+    ogs_pfcp_context_init();
+
+    subnet = ogs_pfcp_subnet_add("10.45.0.1", "24", NULL, "ogstun");
+    ABTS_PTR_NOTNULL(tc, subnet);
+    ABTS_INT_EQUAL(tc, OGS_OK, ogs_pfcp_ue_pool_generate());
+
+    for (i = 0; i < IPV4_POOL_AVAIL; i++) {
+        ue_ip[i] = ue_ip_alloc(AF_INET, &cause_value, NULL);
+        ABTS_PTR_NOTNULL(tc, ue_ip[i]);
+    }
+
+    /* A freed address in the middle of the full pool is reused */
+    ogs_pfcp_ue_ip_free(ue_ip[98]);
+    ue_ip[98] = ue_ip_alloc(AF_INET, &cause_value, NULL);
+    ABTS_PTR_NOTNULL(tc, ue_ip[98]);
+    ABTS_INT_EQUAL(tc, 100, ue_ip[98]->slot);
+    ABTS_TRUE(tc, ue_ip[98]->addr[0] == ipv4_addr("10.45.0.100"));
+
+    /* Next-fit : the slot after the cursor comes before the wrap-around */
+    ogs_pfcp_ue_ip_free(ue_ip[3]);
+    ogs_pfcp_ue_ip_free(ue_ip[198]);
+
+    ue_ip[198] = ue_ip_alloc(AF_INET, &cause_value, NULL);
+    ABTS_PTR_NOTNULL(tc, ue_ip[198]);
+    ABTS_INT_EQUAL(tc, 200, ue_ip[198]->slot);
+    ABTS_TRUE(tc, ue_ip[198]->addr[0] == ipv4_addr("10.45.0.200"));
+
+    ue_ip[3] = ue_ip_alloc(AF_INET, &cause_value, NULL);
+    ABTS_PTR_NOTNULL(tc, ue_ip[3]);
+    ABTS_INT_EQUAL(tc, 5, ue_ip[3]->slot);
+    ABTS_TRUE(tc, ue_ip[3]->addr[0] == ipv4_addr("10.45.0.5"));
+
+    extra = ue_ip_alloc(AF_INET, &cause_value, NULL);
+    ABTS_PTR_EQUAL(tc, NULL, extra);
+
+    /* The last slot of the last word can be freed and reused */
+    ogs_pfcp_ue_ip_free(ue_ip[IPV4_POOL_AVAIL-1]);
+    ABTS_TRUE(tc, subnet->pool.bits[3] != UINT64_MAX);
+    ABTS_TRUE(tc, subnet->pool.full[0] != UINT64_MAX);
+
+    ue_ip[IPV4_POOL_AVAIL-1] = ue_ip_alloc(AF_INET, &cause_value, NULL);
+    ABTS_PTR_NOTNULL(tc, ue_ip[IPV4_POOL_AVAIL-1]);
+    ABTS_INT_EQUAL(tc, IPV4_POOL_SIZE - 1, ue_ip[IPV4_POOL_AVAIL-1]->slot);
+    ABTS_TRUE(tc, ue_ip[IPV4_POOL_AVAIL-1]->addr[0] ==
+            ipv4_addr("10.45.0.254"));
+    ABTS_TRUE(tc, subnet->pool.bits[3] == UINT64_MAX);
+    ABTS_TRUE(tc, subnet->pool.full[0] == UINT64_MAX);
+
+    for (i = 0; i < IPV4_POOL_AVAIL; i++)
+        ogs_pfcp_ue_ip_free(ue_ip[i]);
+
+    ABTS_INT_EQUAL(tc, 0, ogs_pfcp_ue_pool_occupancy(subnet, NULL));
+
+    ogs_pfcp_context_final();
+}
+
+/*
+ * Two ranges are two blocks of slots.
+ * 10.46.0.10 ~ 10.46.0.19   : slot 0 ~ 9
+ * 10.46.1.100 ~ 10.46.1.199 : slot 10 ~ 109
+ */
+#define RANGE_POOL_SIZE 110
+
+static uint32_t range_slot_to_addr(uint32_t slot)
+{
+    if (slot < 10)
+        return htobe32(be32toh(ipv4_addr("10.46.0.10")) + slot);
+    return htobe32(be32toh(ipv4_addr("10.46.1.100")) + slot - 10);
+}
+
+static void ue_pool_test3(abts_case *tc, void *data)
+{
+    int i;
+    uint8_t cause_value = 0;
+    ogs_pfcp_subnet_t *subnet = NULL;
+    ogs_pfcp_ue_ip_t *ue_ip[RANGE_POOL_SIZE];
+    ogs_pfcp_ue_ip_t *outside[2];
+
+    struct {
+        const char *ipstr;
+        uint32_t slot;
+    } roundtrip[] = {
+        { "10.46.0.10", 0 },
+        { "10.46.0.19", 9 },
+        { "10.46.1.100", 10 },
+        { "10.46.1.199", RANGE_POOL_SIZE - 1 },
+    };
+
+    ogs_pfcp_context_init();
+
+    subnet = ogs_pfcp_subnet_add("10.46.0.1", "16", NULL, "ogstun");
+    ABTS_PTR_NOTNULL(tc, subnet);
+    subnet->range[0].low = "10.46.0.10";
+    subnet->range[0].high = "10.46.0.19";
+    subnet->range[1].low = "10.46.1.100";
+    subnet->range[1].high = "10.46.1.199";
+    subnet->num_of_range = 2;
+    ABTS_INT_EQUAL(tc, OGS_OK, ogs_pfcp_ue_pool_generate());
+
+    /* The network and TUN addresses are outside of the ranges */
+    ABTS_INT_EQUAL(tc, 2, subnet->pool.num_of_block);
+    ABTS_INT_EQUAL(tc, RANGE_POOL_SIZE, subnet->pool.size);
+    ABTS_INT_EQUAL(tc, RANGE_POOL_SIZE, subnet->pool.avail);
+
+    /* Address -> Slot : the static IP is reserved in the bitmap */
+    for (i = 0; i < OGS_ARRAY_SIZE(roundtrip); i++) {
+        ue_ip[i] = ue_ip_alloc(AF_INET, &cause_value, roundtrip[i].ipstr);
+        ABTS_PTR_NOTNULL(tc, ue_ip[i]);
+        ABTS_TRUE(tc, ue_ip[i]->static_ip == true);
+        ABTS_INT_EQUAL(tc, roundtrip[i].slot, ue_ip[i]->slot);
+        ABTS_TRUE(tc, ue_ip[i]->addr[0] ==
+                range_slot_to_addr(roundtrip[i].slot));
+    }
+    ABTS_INT_EQUAL(tc, RANGE_POOL_SIZE - OGS_ARRAY_SIZE(roundtrip),
+            subnet->pool.avail);
+
+    /* The static IP outside of the ranges does not use any slot */
+    outside[0] = ue_ip_alloc(AF_INET, &cause_value, "10.46.0.20");
+    ABTS_PTR_NOTNULL(tc, outside[0]);
+    ABTS_INT_EQUAL(tc, OGS_PFCP_UE_IP_NO_SLOT, outside[0]->slot);
+    outside[1] = ue_ip_alloc(AF_INET, &cause_value, "10.46.1.99");
+    ABTS_PTR_NOTNULL(tc, outside[1]);
+    ABTS_INT_EQUAL(tc, OGS_PFCP_UE_IP_NO_SLOT, outside[1]->slot);
+    ABTS_INT_EQUAL(tc, RANGE_POOL_SIZE - OGS_ARRAY_SIZE(roundtrip),
+            subnet->pool.avail);
+
+    /* Slot -> Address : the dynamic IP skips the reserved slots */
+    for (; i < RANGE_POOL_SIZE; i++) {
+        ue_ip[i] = ue_ip_alloc(AF_INET, &cause_value, NULL);
+        ABTS_PTR_NOTNULL(tc, ue_ip[i]);
+        ABTS_TRUE(tc, ue_ip[i]->slot != 0);
+        ABTS_TRUE(tc, ue_ip[i]->slot != 9);
+        ABTS_TRUE(tc, ue_ip[i]->slot != 10);
+        ABTS_TRUE(tc, ue_ip[i]->slot != RANGE_POOL_SIZE - 1);
+        ABTS_TRUE(tc, ue_ip[i]->addr[0] ==
+                range_slot_to_addr(ue_ip[i]->slot));
+    }
+    ABTS_INT_EQUAL(tc, 0, subnet->pool.avail);
+
+    for (i = 0; i < RANGE_POOL_SIZE; i++)
+        ogs_pfcp_ue_ip_free(ue_ip[i]);
+    ogs_pfcp_ue_ip_free(outside[0]);
+    ogs_pfcp_ue_ip_free(outside[1]);
+
+    ABTS_INT_EQUAL(tc, RANGE_POOL_SIZE, subnet->pool.avail);
+
+    ogs_pfcp_context_final();
+}
+
+static void ipv6_slot_to_addr(
+        ogs_pfcp_subnet_t *subnet, uint32_t slot, uint32_t *addr)
+{
+    memset(addr, 0, sizeof(uint32_t) * 4);
+    addr[0] = subnet->sub.sub[0];
+    addr[1] = htobe32(be32toh(subnet->sub.sub[1]) + slot);
+    addr[3] = htobe32(slot + 1);
+}
+
+static void ue_pool_test4(abts_case *tc, void *data)
+{
+    int i;
+    uint8_t cause_value = 0;
+    uint32_t size, addr[4];
+    ogs_pfcp_subnet_t *subnet = NULL;
+    ogs_pfcp_ue_ip_t **ue_ip = NULL, *extra = NULL;
+
+    ogs_pfcp_context_init();
+
+    /* /48 is larger than the session pool, so it is the pool size */
+    subnet = ogs_pfcp_subnet_add("2001:db8:cafe::1", "48", NULL, "ogstun");
+    ABTS_PTR_NOTNULL(tc, subnet);
+    ABTS_INT_EQUAL(tc, OGS_OK, ogs_pfcp_ue_pool_generate());
+
+    size = subnet->pool.size;
+    ABTS_INT_EQUAL(tc, ogs_app()->pool.sess, size);
+
+    /* The network and TUN addresses are in the same slot */
+    ABTS_INT_EQUAL(tc, 1, subnet->pool.reserved);
+    ABTS_INT_EQUAL(tc, size - 1, subnet->pool.avail);
+
+    ue_ip = ogs_calloc(size, sizeof(*ue_ip));
+    ogs_assert(ue_ip);
+
+    /* Slot -> Address */
+    for (i = 1; i < size; i++) {
+        ue_ip[i] = ue_ip_alloc(AF_INET6, &cause_value, NULL);
+        ABTS_PTR_NOTNULL(tc, ue_ip[i]);
+        ABTS_INT_EQUAL(tc, i, ue_ip[i]->slot);
+        ipv6_slot_to_addr(subnet, i, addr);
+        ABTS_TRUE(tc, memcmp(ue_ip[i]->addr, addr, sizeof addr) == 0);
+    }
+
+    /* The last slot is in the last word of the bitmap */
+    ABTS_TRUE(tc, subnet->pool.bits[(size - 1) / 64] == UINT64_MAX);
+    ABTS_INT_EQUAL(tc, 0, subnet->pool.avail);
+
+    extra = ue_ip_alloc(AF_INET6, &cause_value, NULL);
+    ABTS_PTR_EQUAL(tc, NULL, extra);
+    ABTS_INT_EQUAL(tc, OGS_PFCP_CAUSE_NO_RESOURCES_AVAILABLE, cause_value);
+
+    /* Address -> Slot : the first, a middle and the last slot */
+    ogs_pfcp_ue_ip_free(ue_ip[1]);
+    ogs_pfcp_ue_ip_free(ue_ip[size / 2]);
+    ogs_pfcp_ue_ip_free(ue_ip[size - 1]);
+
+    ABTS_INT_EQUAL(tc, 3, subnet->pool.avail);
+
+    ue_ip[1] = ue_ip_alloc(AF_INET6, &cause_value, "2001:db8:cafe:1::2");
+    ABTS_PTR_NOTNULL(tc, ue_ip[1]);
+    ABTS_TRUE(tc, ue_ip[1]->static_ip == true);
+    ABTS_INT_EQUAL(tc, 1, ue_ip[1]->slot);
+
+    ipv6_slot_to_addr(subnet, size / 2, addr);
+    ue_ip[size / 2] = ogs_pfcp_ue_ip_alloc(
+            &cause_value, AF_INET6, NULL, (uint8_t *)addr);
+    ABTS_PTR_NOTNULL(tc, ue_ip[size / 2]);
+    ABTS_INT_EQUAL(tc, size / 2, ue_ip[size / 2]->slot);
+
+    ipv6_slot_to_addr(subnet, size - 1, addr);
+    ue_ip[size - 1] = ogs_pfcp_ue_ip_alloc(
+            &cause_value, AF_INET6, NULL, (uint8_t *)addr);
+    ABTS_PTR_NOTNULL(tc, ue_ip[size - 1]);
+    ABTS_INT_EQUAL(tc, size - 1, ue_ip[size - 1]->slot);
+    ABTS_TRUE(tc, subnet->pool.bits[(size - 1) / 64] == UINT64_MAX);
+
+    ABTS_INT_EQUAL(tc, 0, subnet->pool.avail);
+
+    for (i = 1; i < size; i++)
+        ogs_pfcp_ue_ip_free(ue_ip[i]);
+    ogs_free(ue_ip);
+
+    /* The static IP in another prefix does not use any slot */
+    extra = ue_ip_alloc(AF_INET6, &cause_value, "2001:db8:beef:1::2");
+    ABTS_PTR_NOTNULL(tc, extra);
+    ABTS_INT_EQUAL(tc, OGS_PFCP_UE_IP_NO_SLOT, extra->slot);
+    ogs_pfcp_ue_ip_free(extra);
+
+    ABTS_INT_EQUAL(tc, size - 1, subnet->pool.avail);
+    ABTS_INT_EQUAL(tc, 0, ogs_pfcp_ue_pool_occupancy(subnet, NULL));
+
+    ogs_pfcp_context_final();
+}
+
+abts_suite *test_ue_pool(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, ue_pool_test1, NULL);
+    abts_run_test(suite, ue_pool_test2, NULL);
+    abts_run_test(suite, ue_pool_test3, NULL);
+    abts_run_test(suite, ue_pool_test4, NULL);
+
+    return suite;
+}